@@ -68,6 +68,16 @@ class Contractor
     void WriteCoreNodeMarker(std::vector<bool> &&is_core_node) const;
     void WriteNodeLevels(std::vector<float> &&node_levels) const;
     void ReadNodeLevels(std::vector<float> &contraction_order) const;
+    void
+    CustomizeGraph(const util::DeallocatingVector<extractor::EdgeBasedEdge> &edge_based_edge_list,
+                   const std::vector<NodeID> &node_permutation,
+                   util::DeallocatingVector<QueryEdge> &contracted_edge_list) const;
+    std::vector<NodeID> ReadNodePermutation(const std::size_t number_of_nodes) const;
+    void RenumberNodes(const NodeID number_of_nodes,
+                       const std::vector<NodeID> &previous_permutation,
+                       util::DeallocatingVector<QueryEdge> &contracted_edge_list,
+                       std::vector<bool> &is_core_node) const;
+    void RenumberRTreeLeaves(const std::vector<NodeID> &leaf_node_mapping) const;
     std::size_t
     WriteContractedGraph(unsigned number_of_edge_based_nodes,
                          const util::DeallocatingVector<QueryEdge> &contracted_edge_list);
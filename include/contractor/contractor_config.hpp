@@ -39,7 +39,9 @@ namespace contractor
 
 struct ContractorConfig
 {
-    ContractorConfig() : requested_num_threads(0) {}
+    ContractorConfig() : update_weights_only(false), renumber_nodes(false), requested_num_threads(0)
+    {
+    }
 
     // Infer the output names from the path of the .osrm file
     void UseDefaultOutputNames()
@@ -53,6 +55,7 @@ struct ContractorConfig
         node_based_graph_path = osrm_input_path.string() + ".nodes";
         geometry_path = osrm_input_path.string() + ".geometry";
         rtree_leaf_path = osrm_input_path.string() + ".fileIndex";
+        node_permutation_path = osrm_input_path.string() + ".node_permutation";
         datasource_names_path = osrm_input_path.string() + ".datasource_names";
         datasource_indexes_path = osrm_input_path.string() + ".datasource_indexes";
     }
@@ -70,7 +73,12 @@ struct ContractorConfig
     std::string node_based_graph_path;
     std::string geometry_path;
     std::string rtree_leaf_path;
+    std::string node_permutation_path;
     bool use_cached_priority;
+    // Keep the shortcuts of an existing .hsgr and only recompute their weights
+    bool update_weights_only;
+    // Renumber the nodes of the hierarchy for cache locality of the queries
+    bool renumber_nodes;
 
     unsigned requested_num_threads;
     double log_edge_updates_factor;
@@ -0,0 +1,313 @@
+#ifndef OSRM_CONTRACTOR_GRAPH_CUSTOMIZER_HPP
+#define OSRM_CONTRACTOR_GRAPH_CUSTOMIZER_HPP
+
+#include "contractor/query_edge.hpp"
+#include "util/deallocating_vector.hpp"
+#include "util/exception.hpp"
+#include "util/integer_range.hpp"
+#include "util/simple_logger.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace osrm
+{
+namespace contractor
+{
+
+/**
+ * Recomputes the weights of an existing contraction hierarchy for new edge weights, without
+ * contracting the graph again.
+ *
+ * The shortcuts of the hierarchy are kept: original edges get the smallest weight of the
+ * parallel edge-based edges and every shortcut gets the weight of the two edges it bridges at
+ * its middle node. Edges of the hierarchy always point from a node to one contracted later, so
+ * the shortcuts are updated bottom-up in layers of that order, each layer in parallel.
+ *
+ * Witness searches are not repeated. A shortcut the contraction left out because of a witness
+ * path stays missing if the new weights make that path slower, queries then still find a valid
+ * route that can be slightly slower than the optimal one. A full contraction fixes this.
+ */
+class GraphCustomizer
+{
+  public:
+    // Takes the edges as stored in a .hsgr, each node has the edges to the nodes contracted
+    // after it.
+    GraphCustomizer(const NodeID number_of_nodes, std::vector<QueryEdge> hierarchy_)
+        : number_of_nodes(number_of_nodes), hierarchy(std::move(hierarchy_))
+    {
+        tbb::parallel_sort(hierarchy.begin(), hierarchy.end());
+
+        first_edge.resize(number_of_nodes + 1, 0);
+        for (const auto &edge : hierarchy)
+        {
+            BOOST_ASSERT(edge.source < number_of_nodes);
+            BOOST_ASSERT(edge.target < number_of_nodes);
+            ++first_edge[edge.source + 1];
+        }
+        std::partial_sum(first_edge.begin(), first_edge.end(), first_edge.begin());
+    }
+
+    template <class ContainerT>
+    void Customize(const ContainerT &edge_based_edges,
+                   util::DeallocatingVector<QueryEdge> &customized_edges)
+    {
+        const auto base_arcs = GetBaseArcs(edge_based_edges);
+
+        forward_weights.assign(hierarchy.size(), INVALID_EDGE_WEIGHT);
+        backward_weights.assign(hierarchy.size(), INVALID_EDGE_WEIGHT);
+
+        // original edges do not depend on anything else
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, hierarchy.size()),
+                          [&](const tbb::blocked_range<std::size_t> &range) {
+                              for (auto edge = range.begin(); edge != range.end(); ++edge)
+                              {
+                                  const auto &query_edge = hierarchy[edge];
+                                  if (query_edge.data.shortcut)
+                                      continue;
+
+                                  if (query_edge.data.forward)
+                                      forward_weights[edge] = FindBaseWeight(
+                                          base_arcs, query_edge.source, query_edge.target);
+                                  if (query_edge.data.backward)
+                                      backward_weights[edge] = FindBaseWeight(
+                                          base_arcs, query_edge.target, query_edge.source);
+                              }
+                          });
+
+        const auto shortcuts_by_layer = GetShortcutsByLayer();
+        util::SimpleLogger().Write() << "Customizing " << hierarchy.size() << " edges in "
+                                     << shortcuts_by_layer.size() << " layers";
+
+        for (const auto &layer : shortcuts_by_layer)
+        {
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, layer.size()),
+                              [&](const tbb::blocked_range<std::size_t> &range) {
+                                  for (auto index = range.begin(); index != range.end(); ++index)
+                                  {
+                                      CustomizeShortcut(layer[index]);
+                                  }
+                              });
+        }
+
+        for (const auto edge : util::irange<std::size_t>(0, hierarchy.size()))
+        {
+            auto query_edge = hierarchy[edge];
+            const auto forward_weight = forward_weights[edge];
+            const auto backward_weight = backward_weights[edge];
+            if ((query_edge.data.forward && forward_weight == INVALID_EDGE_WEIGHT) ||
+                (query_edge.data.backward && backward_weight == INVALID_EDGE_WEIGHT))
+            {
+                throw util::exception("Shortcut " + std::to_string(query_edge.source) + "->" +
+                                      std::to_string(query_edge.target) +
+                                      " has no edges to bridge, the .hsgr does not belong to this "
+                                      "dataset.");
+            }
+
+            // bidirectional edges with weights that now differ are split up
+            if (query_edge.data.forward && query_edge.data.backward &&
+                forward_weight != backward_weight)
+            {
+                query_edge.data.backward = false;
+                query_edge.data.weight = forward_weight;
+                customized_edges.push_back(query_edge);
+
+                query_edge.data.forward = false;
+                query_edge.data.backward = true;
+                query_edge.data.weight = backward_weight;
+                customized_edges.push_back(query_edge);
+            }
+            else
+            {
+                query_edge.data.weight =
+                    query_edge.data.forward ? forward_weight : backward_weight;
+                customized_edges.push_back(query_edge);
+            }
+        }
+
+        hierarchy.clear();
+        hierarchy.shrink_to_fit();
+        forward_weights.clear();
+        backward_weights.clear();
+    }
+
+  private:
+    struct BaseArc
+    {
+        NodeID from;
+        NodeID to;
+        EdgeWeight weight;
+
+        bool operator<(const BaseArc &other) const
+        {
+            return std::tie(from, to, weight) < std::tie(other.from, other.to, other.weight);
+        }
+    };
+
+    template <class ContainerT> std::vector<BaseArc> GetBaseArcs(const ContainerT &edges) const
+    {
+        std::vector<BaseArc> arcs;
+        arcs.reserve(edges.size() * 2);
+        for (const auto &edge : edges)
+        {
+            // the contractor removes self-loops and uses at least a weight of 1
+            if (edge.source == edge.target)
+                continue;
+            const EdgeWeight weight = std::max(edge.weight, 1);
+            if (edge.forward)
+                arcs.push_back({edge.source, edge.target, weight});
+            if (edge.backward)
+                arcs.push_back({edge.target, edge.source, weight});
+        }
+
+        // keep the cheapest of parallel arcs
+        tbb::parallel_sort(arcs.begin(), arcs.end());
+        arcs.erase(std::unique(arcs.begin(),
+                               arcs.end(),
+                               [](const BaseArc &lhs, const BaseArc &rhs) {
+                                   return lhs.from == rhs.from && lhs.to == rhs.to;
+                               }),
+                   arcs.end());
+        return arcs;
+    }
+
+    static EdgeWeight
+    FindBaseWeight(const std::vector<BaseArc> &arcs, const NodeID from, const NodeID to)
+    {
+        const auto arc = std::lower_bound(arcs.begin(), arcs.end(), BaseArc{from, to, 0});
+        if (arc == arcs.end() || arc->from != from || arc->to != to)
+        {
+            throw util::exception("Edge " + std::to_string(from) + "->" + std::to_string(to) +
+                                  " of the hierarchy is not in the edge-expanded graph, the .hsgr"
+                                  " does not belong to this dataset.");
+        }
+        return arc->weight;
+    }
+
+    // Buckets the shortcuts by the layer of their middle node. A node is in a layer after all
+    // nodes that have edges to it, the nodes contracted before it. Nodes of the uncontracted
+    // core have cyclic edges and never get a layer, they are never the middle of a shortcut.
+    std::vector<std::vector<std::size_t>> GetShortcutsByLayer() const
+    {
+        const constexpr std::uint32_t NO_LAYER = std::numeric_limits<std::uint32_t>::max();
+
+        std::vector<std::uint32_t> in_degree(number_of_nodes, 0);
+        for (const auto &edge : hierarchy)
+        {
+            if (edge.source != edge.target)
+                ++in_degree[edge.target];
+        }
+
+        std::vector<std::uint32_t> layer(number_of_nodes, NO_LAYER);
+        std::vector<NodeID> current_layer, next_layer;
+        for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+        {
+            if (in_degree[node] == 0)
+                current_layer.push_back(node);
+        }
+
+        std::uint32_t current_level = 0;
+        while (!current_layer.empty())
+        {
+            for (const auto node : current_layer)
+            {
+                layer[node] = current_level;
+                for (const auto edge : util::irange(first_edge[node], first_edge[node + 1]))
+                {
+                    const auto target = hierarchy[edge].target;
+                    if (target != node && --in_degree[target] == 0)
+                        next_layer.push_back(target);
+                }
+            }
+            current_layer.swap(next_layer);
+            next_layer.clear();
+            ++current_level;
+        }
+
+        std::vector<std::vector<std::size_t>> shortcuts_by_layer(current_level);
+        for (const auto edge : util::irange<std::size_t>(0, hierarchy.size()))
+        {
+            const auto &query_edge = hierarchy[edge];
+            if (!query_edge.data.shortcut)
+                continue;
+
+            const NodeID middle = query_edge.data.id;
+            if (middle >= number_of_nodes || layer[middle] == NO_LAYER)
+            {
+                throw util::exception("Shortcut via " + std::to_string(middle) +
+                                      " does not belong to the contracted part of the hierarchy.");
+            }
+            shortcuts_by_layer[layer[middle]].push_back(edge);
+        }
+        return shortcuts_by_layer;
+    }
+
+    // Weight of the arc from `from` into `middle`, stored at middle as backward edge
+    EdgeWeight GetWeightInto(const NodeID middle, const NodeID from) const
+    {
+        EdgeWeight weight = INVALID_EDGE_WEIGHT;
+        for (const auto edge : util::irange(first_edge[middle], first_edge[middle + 1]))
+        {
+            if (hierarchy[edge].target == from && hierarchy[edge].data.backward)
+                weight = std::min(weight, backward_weights[edge]);
+        }
+        return weight;
+    }
+
+    // Weight of the arc from `middle` to `to`, stored at middle as forward edge
+    EdgeWeight GetWeightFrom(const NodeID middle, const NodeID to) const
+    {
+        EdgeWeight weight = INVALID_EDGE_WEIGHT;
+        for (const auto edge : util::irange(first_edge[middle], first_edge[middle + 1]))
+        {
+            if (hierarchy[edge].target == to && hierarchy[edge].data.forward)
+                weight = std::min(weight, forward_weights[edge]);
+        }
+        return weight;
+    }
+
+    void CustomizeShortcut(const std::size_t edge)
+    {
+        const auto &query_edge = hierarchy[edge];
+        const NodeID middle = query_edge.data.id;
+
+        const auto sum = [](const EdgeWeight first, const EdgeWeight second) {
+            if (first == INVALID_EDGE_WEIGHT || second == INVALID_EDGE_WEIGHT)
+                return INVALID_EDGE_WEIGHT;
+            return first + second;
+        };
+
+        if (query_edge.data.forward)
+        {
+            forward_weights[edge] = sum(GetWeightInto(middle, query_edge.source),
+                                        GetWeightFrom(middle, query_edge.target));
+        }
+        if (query_edge.data.backward)
+        {
+            backward_weights[edge] = sum(GetWeightInto(middle, query_edge.target),
+                                         GetWeightFrom(middle, query_edge.source));
+        }
+    }
+
+    const NodeID number_of_nodes;
+    std::vector<QueryEdge> hierarchy;
+    std::vector<EdgeID> first_edge;
+    std::vector<EdgeWeight> forward_weights;
+    std::vector<EdgeWeight> backward_weights;
+};
+}
+}
+
+#endif // OSRM_CONTRACTOR_GRAPH_CUSTOMIZER_HPP
@@ -0,0 +1,188 @@
+#ifndef OSRM_CONTRACTOR_NODE_RENUMBERING_HPP
+#define OSRM_CONTRACTOR_NODE_RENUMBERING_HPP
+
+#include "contractor/query_edge.hpp"
+#include "util/integer_range.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+namespace osrm
+{
+namespace contractor
+{
+
+/**
+ * Computes new ids for the nodes of a contracted graph so that nodes close in the hierarchy are
+ * close in memory. Edges of the hierarchy point from a node to one contracted later.
+ *
+ * Nodes are ordered by their layer in the hierarchy, the uncontracted core and the top layers
+ * first, since every search ends up there. Within a layer nodes keep the order of a depth-first
+ * search down the hierarchy from the top, which keeps nodes below the same parents together.
+ *
+ * Returns the new id of every node.
+ */
+template <typename ContainerT>
+std::vector<NodeID> computeLocalityPermutation(const NodeID number_of_nodes,
+                                               const ContainerT &edges)
+{
+    const constexpr std::uint32_t CORE_LAYER = std::numeric_limits<std::uint32_t>::max();
+
+    // upward and downward adjacency arrays of the hierarchy, without self-loops
+    std::vector<std::uint32_t> in_degree(number_of_nodes, 0);
+    std::vector<EdgeID> first_up(number_of_nodes + 1, 0);
+    std::vector<EdgeID> first_down(number_of_nodes + 1, 0);
+    for (const auto &edge : edges)
+    {
+        BOOST_ASSERT(edge.source < number_of_nodes && edge.target < number_of_nodes);
+        if (edge.source == edge.target)
+            continue;
+        ++in_degree[edge.target];
+        ++first_up[edge.source + 1];
+        ++first_down[edge.target + 1];
+    }
+    std::partial_sum(first_up.begin(), first_up.end(), first_up.begin());
+    std::partial_sum(first_down.begin(), first_down.end(), first_down.begin());
+
+    std::vector<NodeID> up_targets(first_up.back()), down_targets(first_down.back());
+    {
+        auto up_position = first_up;
+        auto down_position = first_down;
+        for (const auto &edge : edges)
+        {
+            if (edge.source == edge.target)
+                continue;
+            up_targets[up_position[edge.source]++] = edge.target;
+            down_targets[down_position[edge.target]++] = edge.source;
+        }
+    }
+
+    // a node is one layer above all nodes with edges to it, nodes of the core are on cycles and
+    // never get a layer
+    std::vector<std::uint32_t> layer(number_of_nodes, CORE_LAYER);
+    {
+        std::vector<NodeID> current_layer, next_layer;
+        for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+        {
+            if (in_degree[node] == 0)
+                current_layer.push_back(node);
+        }
+
+        std::uint32_t current_level = 0;
+        while (!current_layer.empty())
+        {
+            for (const auto node : current_layer)
+            {
+                layer[node] = current_level;
+                for (const auto edge : util::irange(first_up[node], first_up[node + 1]))
+                {
+                    if (--in_degree[up_targets[edge]] == 0)
+                        next_layer.push_back(up_targets[edge]);
+                }
+            }
+            current_layer.swap(next_layer);
+            next_layer.clear();
+            ++current_level;
+        }
+    }
+
+    // depth-first search down the hierarchy, starting at the top
+    std::vector<NodeID> roots(number_of_nodes);
+    std::iota(roots.begin(), roots.end(), 0);
+    std::stable_sort(roots.begin(), roots.end(), [&](const NodeID lhs, const NodeID rhs) {
+        return layer[lhs] > layer[rhs];
+    });
+
+    const constexpr NodeID UNVISITED = SPECIAL_NODEID;
+    std::vector<NodeID> dfs_order(number_of_nodes, UNVISITED);
+    NodeID dfs_index = 0;
+    std::vector<NodeID> stack;
+    for (const auto root : roots)
+    {
+        if (dfs_order[root] != UNVISITED)
+            continue;
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            const auto node = stack.back();
+            stack.pop_back();
+            if (dfs_order[node] != UNVISITED)
+                continue;
+            dfs_order[node] = dfs_index++;
+            // pushed in reverse so the first child is explored first
+            for (auto edge = first_down[node + 1]; edge > first_down[node]; --edge)
+            {
+                const auto child = down_targets[edge - 1];
+                if (dfs_order[child] == UNVISITED)
+                    stack.push_back(child);
+            }
+        }
+    }
+
+    std::vector<NodeID> order(number_of_nodes);
+    std::iota(order.begin(), order.end(), 0);
+    tbb::parallel_sort(order.begin(), order.end(), [&](const NodeID lhs, const NodeID rhs) {
+        return std::make_tuple(-static_cast<std::int64_t>(layer[lhs]), dfs_order[lhs]) <
+               std::make_tuple(-static_cast<std::int64_t>(layer[rhs]), dfs_order[rhs]);
+    });
+
+    std::vector<NodeID> permutation(number_of_nodes);
+    for (const auto new_id : util::irange<NodeID>(0, number_of_nodes))
+    {
+        permutation[order[new_id]] = new_id;
+    }
+    return permutation;
+}
+
+inline std::vector<NodeID> invertPermutation(const std::vector<NodeID> &permutation)
+{
+    std::vector<NodeID> inverse(permutation.size());
+    for (const auto old_id : util::irange<NodeID>(0, permutation.size()))
+    {
+        inverse[permutation[old_id]] = old_id;
+    }
+    return inverse;
+}
+
+// Renames the endpoints of all edges and the middle nodes of shortcuts
+template <typename ContainerT>
+void renumberEdges(ContainerT &edges, const std::vector<NodeID> &permutation)
+{
+    for (auto &edge : edges)
+    {
+        BOOST_ASSERT(edge.source < permutation.size() && edge.target < permutation.size());
+        edge.source = permutation[edge.source];
+        edge.target = permutation[edge.target];
+        if (edge.data.shortcut)
+        {
+            BOOST_ASSERT(edge.data.id < permutation.size());
+            edge.data.id = permutation[edge.data.id];
+        }
+    }
+}
+
+// Markers are either empty or have one entry per node
+inline std::vector<bool> renumberNodeMarkers(const std::vector<bool> &markers,
+                                             const std::vector<NodeID> &permutation)
+{
+    BOOST_ASSERT(markers.empty() || markers.size() == permutation.size());
+    std::vector<bool> renumbered(markers.size(), false);
+    for (const auto old_id : util::irange<NodeID>(0, markers.size()))
+    {
+        renumbered[permutation[old_id]] = markers[old_id];
+    }
+    return renumbered;
+}
+}
+}
+
+#endif // OSRM_CONTRACTOR_NODE_RENUMBERING_HPP
@@ -14,6 +14,36 @@ struct QueryEdge
 {
     NodeID source;
     NodeID target;
+
+    // Part of the edge data read by the searches on the hierarchy
+    struct SearchData
+    {
+        SearchData() : weight(0), forward(false), backward(false) {}
+
+        template <class OtherT>
+        SearchData(const OtherT &other)
+            : weight(other.weight), forward(other.forward), backward(other.backward)
+        {
+        }
+        int weight : 30;
+        bool forward : 1;
+        bool backward : 1;
+    };
+
+    // Part of the edge data only read when unpacking paths: the middle node of a shortcut or
+    // the id of the original edge
+    struct UnpackingData
+    {
+        UnpackingData() : id(0), shortcut(false) {}
+
+        template <class OtherT>
+        UnpackingData(const OtherT &other) : id(other.id), shortcut(other.shortcut)
+        {
+        }
+        NodeID id : 31;
+        bool shortcut : 1;
+    };
+
     struct EdgeData
     {
         EdgeData() : id(0), shortcut(false), weight(0), forward(false), backward(false) {}
@@ -26,6 +56,12 @@ struct QueryEdge
             forward = other.forward;
             backward = other.backward;
         }
+
+        EdgeData(const SearchData &search_data, const UnpackingData &unpacking_data)
+            : id(unpacking_data.id), shortcut(unpacking_data.shortcut), weight(search_data.weight),
+              forward(search_data.forward), backward(search_data.backward)
+        {
+        }
         NodeID id : 31;
         bool shortcut : 1;
         int weight : 30;
@@ -33,6 +69,9 @@ struct QueryEdge
         bool backward : 1;
     } data;
 
+    static_assert(sizeof(SearchData) == 4, "SearchData is expected to be packed in 4 bytes");
+    static_assert(sizeof(UnpackingData) == 4, "UnpackingData is expected to be packed in 4 bytes");
+
     QueryEdge() : source(SPECIAL_NODEID), target(SPECIAL_NODEID) {}
 
     QueryEdge(NodeID source, NodeID target, EdgeData data)
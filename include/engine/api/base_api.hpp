@@ -5,6 +5,7 @@
 #include "engine/datafacade/datafacade_base.hpp"
 
 #include "engine/api/json_factory.hpp"
+#include "engine/api/protobuf_factory.hpp"
 #include "engine/hint.hpp"
 
 #include <boost/assert.hpp>
@@ -53,6 +54,17 @@ class BaseAPI
                                   Hint{phantom, facade.GetCheckSum()});
     }
 
+    void MakeWaypoint(protozero::pbf_writer &parent,
+                      const protozero::pbf_tag_type tag,
+                      const PhantomNode &phantom) const
+    {
+        protobuf::makeWaypoint(parent,
+                               tag,
+                               phantom.location,
+                               facade.GetNameForID(phantom.name_id),
+                               Hint{phantom, facade.GetCheckSum()});
+    }
+
     const datafacade::BaseDataFacade &facade;
     const BaseParameters &parameters;
 };
@@ -30,6 +30,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "engine/api/route_parameters.hpp"
 
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -44,6 +45,8 @@ namespace api
  *
  * Holds member attributes:
  *  - timestamps: timestamp(s) for the corresponding input coordinate(s)
+ *  - session: id of an online matching the coordinates extend, `new` opens a session and the
+ *             response holds its id. Empty for a self-contained trace.
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
@@ -67,9 +70,16 @@ struct MatchParameters : public RouteParameters
     }
 
     std::vector<unsigned> timestamps;
+    std::string session;
+
+    bool OpensSession() const { return session == "new"; }
+
     bool IsValid() const
     {
-        return RouteParameters::IsValid() &&
+        // the points of a session can be sent one by one
+        const bool enough_coordinates =
+            coordinates.size() >= 2 || (!session.empty() && coordinates.size() == 1);
+        return enough_coordinates && BaseParameters::IsValid() &&
                (timestamps.empty() || timestamps.size() == coordinates.size());
     }
 };
@@ -0,0 +1,101 @@
+#ifndef ENGINE_API_PROTOBUF_FACTORY_HPP
+#define ENGINE_API_PROTOBUF_FACTORY_HPP
+
+#include "engine/hint.hpp"
+#include "util/coordinate.hpp"
+
+#include <protozero/pbf_writer.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+namespace protobuf
+{
+
+// Field numbers of the protobuf responses, the schema is documented in docs/http.md.
+// Every response message starts with the code and an optional error message.
+const constexpr protozero::pbf_tag_type CODE_TAG = 1;
+const constexpr protozero::pbf_tag_type MESSAGE_TAG = 2;
+
+namespace waypoint
+{
+const constexpr protozero::pbf_tag_type NAME_TAG = 1;
+const constexpr protozero::pbf_tag_type LONGITUDE_TAG = 2;
+const constexpr protozero::pbf_tag_type LATITUDE_TAG = 3;
+const constexpr protozero::pbf_tag_type HINT_TAG = 4;
+}
+
+namespace table
+{
+const constexpr protozero::pbf_tag_type SOURCES_TAG = 3;
+const constexpr protozero::pbf_tag_type DESTINATIONS_TAG = 4;
+const constexpr protozero::pbf_tag_type ROWS_TAG = 5;
+const constexpr protozero::pbf_tag_type COLUMNS_TAG = 6;
+const constexpr protozero::pbf_tag_type DURATIONS_TAG = 7;
+const constexpr protozero::pbf_tag_type DISTANCES_TAG = 8;
+}
+
+namespace route
+{
+const constexpr protozero::pbf_tag_type WAYPOINTS_TAG = 3;
+const constexpr protozero::pbf_tag_type ROUTES_TAG = 4;
+
+const constexpr protozero::pbf_tag_type DISTANCE_TAG = 1;
+const constexpr protozero::pbf_tag_type DURATION_TAG = 2;
+const constexpr protozero::pbf_tag_type GEOMETRY_TAG = 3;
+const constexpr protozero::pbf_tag_type LEGS_TAG = 4;
+
+const constexpr protozero::pbf_tag_type LEG_DISTANCE_TAG = 1;
+const constexpr protozero::pbf_tag_type LEG_DURATION_TAG = 2;
+const constexpr protozero::pbf_tag_type LEG_SUMMARY_TAG = 3;
+}
+
+inline void makeError(const std::string &code, const std::string &message, std::string &pbf_buffer)
+{
+    protozero::pbf_writer response(pbf_buffer);
+    response.add_string(CODE_TAG, code);
+    response.add_string(MESSAGE_TAG, message);
+}
+
+inline void makeWaypoint(protozero::pbf_writer &parent,
+                         const protozero::pbf_tag_type tag,
+                         const util::Coordinate location,
+                         const std::string &name,
+                         const Hint &hint)
+{
+    protozero::pbf_writer waypoint(parent, tag);
+    waypoint.add_string(waypoint::NAME_TAG, name);
+    waypoint.add_double(waypoint::LONGITUDE_TAG,
+                        static_cast<double>(util::toFloating(location.lon)));
+    waypoint.add_double(waypoint::LATITUDE_TAG,
+                        static_cast<double>(util::toFloating(location.lat)));
+    waypoint.add_string(waypoint::HINT_TAG, hint.ToBase64());
+}
+
+// Coordinates are written as packed sfixed32 pairs of longitude and latitude in fixed point
+// (degrees * 1e6) so clients can use the little-endian buffer directly.
+template <typename ForwardIter>
+void makeGeometry(protozero::pbf_writer &parent,
+                  const protozero::pbf_tag_type tag,
+                  ForwardIter begin,
+                  ForwardIter end)
+{
+    protozero::packed_field_sfixed32 geometry(parent, tag);
+    for (; begin != end; ++begin)
+    {
+        geometry.add_element(static_cast<std::int32_t>(begin->lon));
+        geometry.add_element(static_cast<std::int32_t>(begin->lat));
+    }
+}
+}
+}
+}
+}
+
+#endif // ENGINE_API_PROTOBUF_FACTORY_HPP
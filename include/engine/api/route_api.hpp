@@ -20,7 +20,11 @@
 #include "util/coordinate.hpp"
 #include "util/integer_range.hpp"
 
+#include <boost/optional.hpp>
+
+#include <cmath>
 #include <iterator>
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -40,27 +44,60 @@ class RouteAPI : public BaseAPI
 
     void MakeResponse(const InternalRouteResult &raw_route, util::json::Object &response) const
     {
-        auto number_of_routes = raw_route.has_alternative() ? 2UL : 1UL;
         util::json::Array routes;
-        routes.values.resize(number_of_routes);
-        routes.values[0] = MakeRoute(raw_route.segment_end_coordinates,
-                                     raw_route.unpacked_path_segments,
-                                     raw_route.source_traversed_in_reverse,
-                                     raw_route.target_traversed_in_reverse);
-        if (raw_route.has_alternative())
+        routes.values.reserve(1 + raw_route.number_of_alternatives());
+        routes.values.push_back(MakeRoute(raw_route.segment_end_coordinates,
+                                          raw_route.unpacked_path_segments,
+                                          raw_route.source_traversed_in_reverse,
+                                          raw_route.target_traversed_in_reverse));
+        for (const auto index : util::irange<std::size_t>(0UL, raw_route.number_of_alternatives()))
         {
             std::vector<std::vector<PathData>> wrapped_leg(1);
-            wrapped_leg.front() = std::move(raw_route.unpacked_alternative);
-            routes.values[1] = MakeRoute(raw_route.segment_end_coordinates,
-                                         wrapped_leg,
-                                         raw_route.alt_source_traversed_in_reverse,
-                                         raw_route.alt_target_traversed_in_reverse);
+            wrapped_leg.front() = raw_route.unpacked_alternatives[index];
+            routes.values.push_back(
+                MakeRoute(raw_route.segment_end_coordinates,
+                          wrapped_leg,
+                          {raw_route.alt_source_traversed_in_reverse[index]},
+                          {raw_route.alt_target_traversed_in_reverse[index]}));
         }
         response.values["waypoints"] = BaseAPI::MakeWaypoints(raw_route.segment_end_coordinates);
         response.values["routes"] = std::move(routes);
         response.values["code"] = "Ok";
     }
 
+    // Protobuf response with the waypoints and the distance, duration, overview geometry and
+    // legs of each route. Steps and annotations are only available in JSON responses.
+    void MakeResponse(const InternalRouteResult &raw_route, std::string &pbf_buffer) const
+    {
+        protozero::pbf_writer response(pbf_buffer);
+        response.add_string(protobuf::CODE_TAG, "Ok");
+
+        BaseAPI::MakeWaypoint(response,
+                              protobuf::route::WAYPOINTS_TAG,
+                              raw_route.segment_end_coordinates.front().source_phantom);
+        for (const auto &phantoms : raw_route.segment_end_coordinates)
+        {
+            BaseAPI::MakeWaypoint(
+                response, protobuf::route::WAYPOINTS_TAG, phantoms.target_phantom);
+        }
+
+        MakeRoute(response,
+                  raw_route.segment_end_coordinates,
+                  raw_route.unpacked_path_segments,
+                  raw_route.source_traversed_in_reverse,
+                  raw_route.target_traversed_in_reverse);
+        for (const auto index : util::irange<std::size_t>(0UL, raw_route.number_of_alternatives()))
+        {
+            std::vector<std::vector<PathData>> wrapped_leg(1);
+            wrapped_leg.front() = raw_route.unpacked_alternatives[index];
+            MakeRoute(response,
+                      raw_route.segment_end_coordinates,
+                      wrapped_leg,
+                      {raw_route.alt_source_traversed_in_reverse[index]},
+                      {raw_route.alt_target_traversed_in_reverse[index]});
+        }
+    }
+
     // FIXME gcc 4.8 doesn't support for lambdas to call protected member functions
     //  protected:
     template <typename ForwardIter>
@@ -80,13 +117,14 @@ class RouteAPI : public BaseAPI
         return json::makeGeoJSONGeometry(begin, end);
     }
 
-    util::json::Object MakeRoute(const std::vector<PhantomNodes> &segment_end_coordinates,
-                                 const std::vector<std::vector<PathData>> &unpacked_path_segments,
-                                 const std::vector<bool> &source_traversed_in_reverse,
-                                 const std::vector<bool> &target_traversed_in_reverse) const
+    // Assembles the legs of a route and their geometries, with steps if requested.
+    void MakeLegs(const std::vector<PhantomNodes> &segment_end_coordinates,
+                  const std::vector<std::vector<PathData>> &unpacked_path_segments,
+                  const std::vector<bool> &source_traversed_in_reverse,
+                  const std::vector<bool> &target_traversed_in_reverse,
+                  std::vector<guidance::RouteLeg> &legs,
+                  std::vector<guidance::LegGeometry> &leg_geometries) const
     {
-        std::vector<guidance::RouteLeg> legs;
-        std::vector<guidance::LegGeometry> leg_geometries;
         auto number_of_legs = segment_end_coordinates.size();
         legs.reserve(number_of_legs);
         leg_geometries.reserve(number_of_legs);
@@ -168,18 +206,43 @@ class RouteAPI : public BaseAPI
             leg_geometries.push_back(std::move(leg_geometry));
             legs.push_back(std::move(leg));
         }
+    }
+
+    boost::optional<std::vector<util::Coordinate>>
+    MakeOverview(const std::vector<guidance::LegGeometry> &leg_geometries) const
+    {
+        if (parameters.overview == RouteParameters::OverviewType::False)
+        {
+            return boost::none;
+        }
+
+        const auto use_simplification =
+            parameters.overview == RouteParameters::OverviewType::Simplified;
+        BOOST_ASSERT(use_simplification ||
+                     parameters.overview == RouteParameters::OverviewType::Full);
+
+        return guidance::assembleOverview(leg_geometries, use_simplification);
+    }
+
+    util::json::Object MakeRoute(const std::vector<PhantomNodes> &segment_end_coordinates,
+                                 const std::vector<std::vector<PathData>> &unpacked_path_segments,
+                                 const std::vector<bool> &source_traversed_in_reverse,
+                                 const std::vector<bool> &target_traversed_in_reverse) const
+    {
+        std::vector<guidance::RouteLeg> legs;
+        std::vector<guidance::LegGeometry> leg_geometries;
+        MakeLegs(segment_end_coordinates,
+                 unpacked_path_segments,
+                 source_traversed_in_reverse,
+                 target_traversed_in_reverse,
+                 legs,
+                 leg_geometries);
 
         auto route = guidance::assembleRoute(legs);
         boost::optional<util::json::Value> json_overview;
-        if (parameters.overview != RouteParameters::OverviewType::False)
+        if (auto overview = MakeOverview(leg_geometries))
         {
-            const auto use_simplification =
-                parameters.overview == RouteParameters::OverviewType::Simplified;
-            BOOST_ASSERT(use_simplification ||
-                         parameters.overview == RouteParameters::OverviewType::Full);
-
-            auto overview = guidance::assembleOverview(leg_geometries, use_simplification);
-            json_overview = MakeGeometry(overview.begin(), overview.end());
+            json_overview = MakeGeometry(overview->begin(), overview->end());
         }
 
         std::vector<util::json::Value> step_geometries;
@@ -263,6 +326,41 @@ class RouteAPI : public BaseAPI
         return result;
     }
 
+    void MakeRoute(protozero::pbf_writer &response,
+                   const std::vector<PhantomNodes> &segment_end_coordinates,
+                   const std::vector<std::vector<PathData>> &unpacked_path_segments,
+                   const std::vector<bool> &source_traversed_in_reverse,
+                   const std::vector<bool> &target_traversed_in_reverse) const
+    {
+        std::vector<guidance::RouteLeg> legs;
+        std::vector<guidance::LegGeometry> leg_geometries;
+        MakeLegs(segment_end_coordinates,
+                 unpacked_path_segments,
+                 source_traversed_in_reverse,
+                 target_traversed_in_reverse,
+                 legs,
+                 leg_geometries);
+        const auto route = guidance::assembleRoute(legs);
+
+        protozero::pbf_writer pbf_route(response, protobuf::route::ROUTES_TAG);
+        pbf_route.add_double(protobuf::route::DISTANCE_TAG, std::round(route.distance * 10) / 10.);
+        pbf_route.add_double(protobuf::route::DURATION_TAG, std::round(route.duration * 10) / 10.);
+        if (const auto overview = MakeOverview(leg_geometries))
+        {
+            protobuf::makeGeometry(
+                pbf_route, protobuf::route::GEOMETRY_TAG, overview->begin(), overview->end());
+        }
+        for (const auto &leg : legs)
+        {
+            protozero::pbf_writer pbf_leg(pbf_route, protobuf::route::LEGS_TAG);
+            pbf_leg.add_double(protobuf::route::LEG_DISTANCE_TAG,
+                               std::round(leg.distance * 10) / 10.);
+            pbf_leg.add_double(protobuf::route::LEG_DURATION_TAG,
+                               std::round(leg.duration * 10) / 10.);
+            pbf_leg.add_string(protobuf::route::LEG_SUMMARY_TAG, leg.summary);
+        }
+    }
+
     const RouteParameters &parameters;
 };
 
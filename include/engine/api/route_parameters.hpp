@@ -45,6 +45,7 @@ namespace api
  * Holds member attributes:
  *  - steps: return route step for each route leg
  *  - alternatives: tries to find alternative routes
+ *  - number_of_alternatives: how many alternative routes to look for, if alternatives are enabled
  *  - geometries: route geometry encoded in Polyline, Polyline6 or GeoJSON
  *  - overview: adds overview geometry either Full, Simplified (according to highest zoom level) or
  *              False (not at all)
@@ -101,6 +102,7 @@ struct RouteParameters : public BaseParameters
 
     bool steps = false;
     bool alternatives = false;
+    unsigned number_of_alternatives = 1;
     bool annotations = false;
     GeometriesType geometries = GeometriesType::Polyline;
     OverviewType overview = OverviewType::Simplified;
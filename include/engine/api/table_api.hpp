@@ -16,10 +16,14 @@
 #include "engine/internal_route_result.hpp"
 
 #include "util/integer_range.hpp"
+#include "util/json_writer.hpp"
 
 #include <boost/range/algorithm/transform.hpp>
 
+#include <cmath>
 #include <iterator>
+#include <limits>
+#include <string>
 
 namespace osrm
 {
@@ -37,6 +41,7 @@ class TableAPI final : public BaseAPI
     }
 
     virtual void MakeResponse(const std::vector<EdgeWeight> &durations,
+                              const std::vector<double> &distances,
                               const std::vector<PhantomNode> &phantoms,
                               util::json::Object &response) const
     {
@@ -65,11 +70,147 @@ class TableAPI final : public BaseAPI
             response.values["destinations"] = MakeWaypoints(phantoms, parameters.destinations);
         }
 
-        response.values["durations"] =
-            MakeTable(durations, number_of_sources, number_of_destinations);
+        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        {
+            response.values["durations"] =
+                MakeTable(durations, number_of_sources, number_of_destinations);
+        }
+        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+        {
+            response.values["distances"] =
+                MakeDistanceTable(distances, number_of_sources, number_of_destinations);
+        }
         response.values["code"] = "Ok";
     }
 
+    // Same response as above, streamed into the writer without building the matrices as json
+    // containers first.
+    virtual void MakeResponse(const std::vector<EdgeWeight> &durations,
+                              const std::vector<double> &distances,
+                              const std::vector<PhantomNode> &phantoms,
+                              util::json::Writer &writer) const
+    {
+        auto number_of_sources = parameters.sources.size();
+        auto number_of_destinations = parameters.destinations.size();
+
+        // rough estimate of the rendered numbers so the buffer is allocated once
+        writer.Reserve(durations.size() * 8 + distances.size() * 10 + phantoms.size() * 128);
+
+        writer.StartObject();
+        writer.Key("code");
+        writer.String("Ok");
+
+        // symmetric case
+        writer.Key("sources");
+        if (parameters.sources.empty())
+        {
+            writer.Value(MakeWaypoints(phantoms));
+            number_of_sources = phantoms.size();
+        }
+        else
+        {
+            writer.Value(MakeWaypoints(phantoms, parameters.sources));
+        }
+
+        writer.Key("destinations");
+        if (parameters.destinations.empty())
+        {
+            writer.Value(MakeWaypoints(phantoms));
+            number_of_destinations = phantoms.size();
+        }
+        else
+        {
+            writer.Value(MakeWaypoints(phantoms, parameters.destinations));
+        }
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        {
+            writer.Key("durations");
+            WriteTable(durations, number_of_sources, number_of_destinations, writer);
+        }
+        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+        {
+            writer.Key("distances");
+            WriteDistanceTable(distances, number_of_sources, number_of_destinations, writer);
+        }
+        writer.EndObject();
+    }
+
+    // Protobuf response, the matrices are packed little-endian floats in row-major order with NaN
+    // for unreachable entries.
+    virtual void MakeResponse(const std::vector<EdgeWeight> &durations,
+                              const std::vector<double> &distances,
+                              const std::vector<PhantomNode> &phantoms,
+                              std::string &pbf_buffer) const
+    {
+        auto number_of_sources = parameters.sources.size();
+        auto number_of_destinations = parameters.destinations.size();
+
+        protozero::pbf_writer response(pbf_buffer);
+        response.add_string(protobuf::CODE_TAG, "Ok");
+
+        // symmetric case
+        if (parameters.sources.empty())
+        {
+            for (const auto &phantom : phantoms)
+            {
+                BaseAPI::MakeWaypoint(response, protobuf::table::SOURCES_TAG, phantom);
+            }
+            number_of_sources = phantoms.size();
+        }
+        else
+        {
+            for (const auto idx : parameters.sources)
+            {
+                BOOST_ASSERT(idx < phantoms.size());
+                BaseAPI::MakeWaypoint(response, protobuf::table::SOURCES_TAG, phantoms[idx]);
+            }
+        }
+
+        if (parameters.destinations.empty())
+        {
+            for (const auto &phantom : phantoms)
+            {
+                BaseAPI::MakeWaypoint(response, protobuf::table::DESTINATIONS_TAG, phantom);
+            }
+            number_of_destinations = phantoms.size();
+        }
+        else
+        {
+            for (const auto idx : parameters.destinations)
+            {
+                BOOST_ASSERT(idx < phantoms.size());
+                BaseAPI::MakeWaypoint(response, protobuf::table::DESTINATIONS_TAG, phantoms[idx]);
+            }
+        }
+
+        response.add_uint32(protobuf::table::ROWS_TAG, number_of_sources);
+        response.add_uint32(protobuf::table::COLUMNS_TAG, number_of_destinations);
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        {
+            protozero::packed_field_float table(
+                response, protobuf::table::DURATIONS_TAG, durations.size());
+            for (const auto duration : durations)
+            {
+                table.add_element(duration == INVALID_EDGE_WEIGHT
+                                      ? std::numeric_limits<float>::quiet_NaN()
+                                      : static_cast<float>(duration / 10.));
+            }
+        }
+        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+        {
+            protozero::packed_field_float table(
+                response, protobuf::table::DISTANCES_TAG, distances.size());
+            for (const auto distance : distances)
+            {
+                table.add_element(distance == std::numeric_limits<double>::max()
+                                      ? std::numeric_limits<float>::quiet_NaN()
+                                      : static_cast<float>(std::round(distance * 10) / 10.));
+            }
+        }
+    }
+
     // FIXME gcc 4.8 doesn't support for lambdas to call protected member functions
     //  protected:
     virtual util::json::Array MakeWaypoints(const std::vector<PhantomNode> &phantoms) const
@@ -125,6 +266,85 @@ class TableAPI final : public BaseAPI
         return json_table;
     }
 
+    virtual util::json::Array MakeDistanceTable(const std::vector<double> &values,
+                                                std::size_t number_of_rows,
+                                                std::size_t number_of_columns) const
+    {
+        util::json::Array json_table;
+        for (const auto row : util::irange<std::size_t>(0UL, number_of_rows))
+        {
+            util::json::Array json_row;
+            auto row_begin_iterator = values.begin() + (row * number_of_columns);
+            auto row_end_iterator = values.begin() + ((row + 1) * number_of_columns);
+            json_row.values.resize(number_of_columns);
+            std::transform(row_begin_iterator,
+                           row_end_iterator,
+                           json_row.values.begin(),
+                           [](const double distance) {
+                               if (distance == std::numeric_limits<double>::max())
+                               {
+                                   return util::json::Value(util::json::Null());
+                               }
+                               return util::json::Value(
+                                   util::json::Number(std::round(distance * 10) / 10.));
+                           });
+            json_table.values.push_back(std::move(json_row));
+        }
+        return json_table;
+    }
+
+    virtual void WriteTable(const std::vector<EdgeWeight> &values,
+                            std::size_t number_of_rows,
+                            std::size_t number_of_columns,
+                            util::json::Writer &writer) const
+    {
+        writer.StartArray();
+        for (const auto row : util::irange<std::size_t>(0UL, number_of_rows))
+        {
+            writer.StartArray();
+            for (const auto column : util::irange<std::size_t>(0UL, number_of_columns))
+            {
+                const auto duration = values[row * number_of_columns + column];
+                if (duration == INVALID_EDGE_WEIGHT)
+                {
+                    writer.Null();
+                }
+                else
+                {
+                    writer.Number(duration / 10.);
+                }
+            }
+            writer.EndArray();
+        }
+        writer.EndArray();
+    }
+
+    virtual void WriteDistanceTable(const std::vector<double> &values,
+                                    std::size_t number_of_rows,
+                                    std::size_t number_of_columns,
+                                    util::json::Writer &writer) const
+    {
+        writer.StartArray();
+        for (const auto row : util::irange<std::size_t>(0UL, number_of_rows))
+        {
+            writer.StartArray();
+            for (const auto column : util::irange<std::size_t>(0UL, number_of_columns))
+            {
+                const auto distance = values[row * number_of_columns + column];
+                if (distance == std::numeric_limits<double>::max())
+                {
+                    writer.Null();
+                }
+                else
+                {
+                    writer.Number(std::round(distance * 10) / 10.);
+                }
+            }
+            writer.EndArray();
+        }
+        writer.EndArray();
+    }
+
     const TableParameters &parameters;
 };
 
@@ -34,6 +34,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <algorithm>
 #include <iterator>
+#include <type_traits>
 #include <vector>
 
 namespace osrm
@@ -51,14 +52,24 @@ namespace api
  *             use all coordinates as sources
  *  - destinations: indices into coordinates indicating destinations for the Table service, no
  *                  destinations means use all coordinates as destinations
+ *  - annotations: which matrices to compute, durations in seconds and/or distances in meters
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
  */
 struct TableParameters : public BaseParameters
 {
+    enum class AnnotationsType
+    {
+        None = 0,
+        Duration = 0x01,
+        Distance = 0x02,
+        All = Duration | Distance
+    };
+
     std::vector<std::size_t> sources;
     std::vector<std::size_t> destinations;
+    AnnotationsType annotations = AnnotationsType::Duration;
 
     TableParameters() = default;
     template <typename... Args>
@@ -75,6 +86,9 @@ struct TableParameters : public BaseParameters
         if (!BaseParameters::IsValid())
             return false;
 
+        if (annotations == AnnotationsType::None)
+            return false;
+
         // Distance Table makes only sense with 2+ coodinates
         if (coordinates.size() < 2)
             return false;
@@ -100,6 +114,26 @@ struct TableParameters : public BaseParameters
         return true;
     }
 };
+
+inline TableParameters::AnnotationsType operator|(TableParameters::AnnotationsType lhs,
+                                                  TableParameters::AnnotationsType rhs)
+{
+    using Underlying = std::underlying_type<TableParameters::AnnotationsType>::type;
+    return static_cast<TableParameters::AnnotationsType>(static_cast<Underlying>(lhs) |
+                                                         static_cast<Underlying>(rhs));
+}
+
+inline TableParameters::AnnotationsType &operator|=(TableParameters::AnnotationsType &lhs,
+                                                    TableParameters::AnnotationsType rhs)
+{
+    return lhs = lhs | rhs;
+}
+
+inline bool operator&(TableParameters::AnnotationsType lhs, TableParameters::AnnotationsType rhs)
+{
+    using Underlying = std::underlying_type<TableParameters::AnnotationsType>::type;
+    return static_cast<Underlying>(lhs) & static_cast<Underlying>(rhs);
+}
 }
 }
 }
@@ -0,0 +1,31 @@
+#ifndef ENGINE_CACHE_STATISTICS_HPP
+#define ENGINE_CACHE_STATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Counters of a cache shared by the requests of an engine, all zero if the cache is disabled
+struct CacheStatistics
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::size_t entries = 0;
+    // sum of the sizes of all entries
+    std::size_t size = 0;
+
+    double HitRate() const
+    {
+        const auto lookups = hits + misses;
+        return lookups == 0 ? 0. : static_cast<double>(hits) / lookups;
+    }
+};
+}
+}
+
+#endif
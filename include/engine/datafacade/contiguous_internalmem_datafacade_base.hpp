@@ -7,6 +7,7 @@
 #include "extractor/guidance/turn_instruction.hpp"
 #include "extractor/guidance/turn_lane_types.hpp"
 #include "extractor/profile_properties.hpp"
+#include "storage/shared_datatype.hpp"
 #include "util/guidance/bearing_class.hpp"
 #include "util/guidance/entry_class.hpp"
 #include "util/guidance/turn_lanes.hpp"
@@ -53,7 +54,7 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 {
   private:
     using super = BaseDataFacade;
-    using QueryGraph = util::StaticGraph<EdgeData, true>;
+    using QueryGraph = util::StaticGraph<SearchEdgeData, true>;
     using GraphNode = QueryGraph::NodeArrayEntry;
     using GraphEdge = QueryGraph::EdgeArrayEntry;
     using IndexBlock = util::RangeTable<16, true>::BlockT;
@@ -63,9 +64,11 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, true>::vector, true>;
     using SharedGeospatialQuery = GeospatialQuery<SharedRTree, BaseDataFacade>;
     using RTreeNode = SharedRTree::TreeNode;
+    using RTreeLeafNode = SharedRTree::LeafNode;
 
     unsigned m_check_sum;
     std::unique_ptr<QueryGraph> m_query_graph;
+    util::ShM<contractor::QueryEdge::UnpackingData, true>::vector m_edge_unpacking_list;
     std::string m_timestamp;
     extractor::ProfileProperties *m_profile_properties;
 
@@ -139,23 +142,39 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     {
         BOOST_ASSERT_MSG(!m_coordinate_list.empty(), "coordinates must be loaded before r-tree");
 
-        const auto file_index_ptr =
-            data_layout.GetBlockPtr<char>(memory_block, storage::DataLayout::FILE_INDEX_PATH);
-        file_index_path = boost::filesystem::path(file_index_ptr);
-        if (!boost::filesystem::exists(file_index_path))
+        auto tree_ptr =
+            data_layout.GetBlockPtr<RTreeNode>(memory_block, storage::DataLayout::R_SEARCH_TREE);
+        const auto number_of_leaves = data_layout.num_entries[storage::DataLayout::R_TREE_LEAVES];
+        if (number_of_leaves > 0)
         {
-            util::SimpleLogger().Write(logDEBUG) << "Leaf file name " << file_index_path.string();
-            throw util::exception("Could not load " + file_index_path.string() +
-                                  "Is any data loaded into shared memory?");
+            auto leaves_ptr = data_layout.GetBlockPtr<RTreeLeafNode>(
+                memory_block, storage::DataLayout::R_TREE_LEAVES);
+            m_static_rtree.reset(
+                new SharedRTree(tree_ptr,
+                                data_layout.num_entries[storage::DataLayout::R_SEARCH_TREE],
+                                leaves_ptr,
+                                number_of_leaves,
+                                m_coordinate_list));
         }
+        else
+        {
+            const auto file_index_ptr =
+                data_layout.GetBlockPtr<char>(memory_block, storage::DataLayout::FILE_INDEX_PATH);
+            file_index_path = boost::filesystem::path(file_index_ptr);
+            if (!boost::filesystem::exists(file_index_path))
+            {
+                util::SimpleLogger().Write(logDEBUG) << "Leaf file name "
+                                                     << file_index_path.string();
+                throw util::exception("Could not load " + file_index_path.string() +
+                                      "Is any data loaded into shared memory?");
+            }
 
-        auto tree_ptr =
-            data_layout.GetBlockPtr<RTreeNode>(memory_block, storage::DataLayout::R_SEARCH_TREE);
-        m_static_rtree.reset(
-            new SharedRTree(tree_ptr,
-                            data_layout.num_entries[storage::DataLayout::R_SEARCH_TREE],
-                            file_index_path,
-                            m_coordinate_list));
+            m_static_rtree.reset(
+                new SharedRTree(tree_ptr,
+                                data_layout.num_entries[storage::DataLayout::R_SEARCH_TREE],
+                                file_index_path,
+                                m_coordinate_list));
+        }
         m_geospatial_query.reset(
             new SharedGeospatialQuery(*m_static_rtree, m_coordinate_list, *this));
     }
@@ -173,6 +192,13 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         util::ShM<GraphEdge, true>::vector edge_list(
             graph_edges_ptr, data_layout.num_entries[storage::DataLayout::GRAPH_EDGE_LIST]);
         m_query_graph.reset(new QueryGraph(node_list, edge_list));
+
+        auto graph_edge_unpacking_ptr =
+            data_layout.GetBlockPtr<contractor::QueryEdge::UnpackingData>(
+                memory_block, storage::DataLayout::GRAPH_EDGE_UNPACKING_LIST);
+        m_edge_unpacking_list.reset(
+            graph_edge_unpacking_ptr,
+            data_layout.num_entries[storage::DataLayout::GRAPH_EDGE_UNPACKING_LIST]);
     }
 
     void InitializeNodeAndEdgeInformationPointers(storage::DataLayout &data_layout,
@@ -411,6 +437,13 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         InitializeIntersectionClassPointers(data_layout, memory_block);
     }
 
+    // Reads the r-tree leaves ahead if they are mapped from the leaf node file
+    void PrefetchRTreeLeaves() const
+    {
+        BOOST_ASSERT(m_static_rtree);
+        m_static_rtree->PrefetchLeaves();
+    }
+
     // search graph access
     unsigned GetNumberOfNodes() const override final { return m_query_graph->GetNumberOfNodes(); }
 
@@ -423,7 +456,12 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 
     NodeID GetTarget(const EdgeID e) const override final { return m_query_graph->GetTarget(e); }
 
-    EdgeData &GetEdgeData(const EdgeID e) const override final
+    EdgeData GetEdgeData(const EdgeID e) const override final
+    {
+        return EdgeData(m_query_graph->GetEdgeData(e), m_edge_unpacking_list[e]);
+    }
+
+    const SearchEdgeData &GetSearchEdgeData(const EdgeID e) const override final
     {
         return m_query_graph->GetEdgeData(e);
     }
@@ -458,7 +496,23 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
                             const NodeID to,
                             std::function<bool(EdgeData)> filter) const override final
     {
-        return m_query_graph->FindSmallestEdge(from, to, filter);
+        // the filter may look at the unpacking data, so this can not use the search graph only
+        EdgeID smallest_edge = SPECIAL_EDGEID;
+        EdgeWeight smallest_weight = INVALID_EDGE_WEIGHT;
+        for (const auto edge : m_query_graph->GetAdjacentEdgeRange(from))
+        {
+            if (m_query_graph->GetTarget(edge) != to)
+            {
+                continue;
+            }
+            const auto data = GetEdgeData(edge);
+            if (data.weight < smallest_weight && filter(data))
+            {
+                smallest_edge = edge;
+                smallest_weight = data.weight;
+            }
+        }
+        return smallest_edge;
     }
 
     // node and edge information access
@@ -858,6 +912,8 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 
     std::string GetTimestamp() const override final { return m_timestamp; }
 
+    unsigned GetDatasetTimestamp() const override { return 0; }
+
     bool GetContinueStraightDefault() const override final
     {
         return m_profile_properties->continue_straight_at_waypoint;
@@ -40,6 +40,7 @@ class BaseDataFacade
 {
   public:
     using EdgeData = contractor::QueryEdge::EdgeData;
+    using SearchEdgeData = contractor::QueryEdge::SearchData;
     using RTreeLeaf = extractor::EdgeBasedNode;
     BaseDataFacade() {}
     virtual ~BaseDataFacade() {}
@@ -53,7 +54,11 @@ class BaseDataFacade
 
     virtual NodeID GetTarget(const EdgeID e) const = 0;
 
-    virtual const EdgeData &GetEdgeData(const EdgeID e) const = 0;
+    // the full data of an edge, including the data needed for unpacking
+    virtual EdgeData GetEdgeData(const EdgeID e) const = 0;
+
+    // the weight and direction of an edge, all a search on the hierarchy needs
+    virtual const SearchEdgeData &GetSearchEdgeData(const EdgeID e) const = 0;
 
     virtual EdgeID BeginEdges(const NodeID n) const = 0;
 
@@ -171,6 +176,9 @@ class BaseDataFacade
 
     virtual std::string GetTimestamp() const = 0;
 
+    // Increases whenever osrm-datastore loads a new dataset, 0 for data that never changes
+    virtual unsigned GetDatasetTimestamp() const = 0;
+
     virtual bool GetContinueStraightDefault() const = 0;
 
     virtual double GetMapMatchingMaxSpeed() const = 0;
@@ -0,0 +1,88 @@
+#ifndef MMAP_MEMORY_DATAFACADE_HPP
+#define MMAP_MEMORY_DATAFACADE_HPP
+
+// implements all data storage by mapping a memory image of the data files
+
+#include "engine/datafacade/contiguous_internalmem_datafacade_base.hpp"
+#include "storage/huge_pages.hpp"
+#include "storage/shared_datatype.hpp"
+#include "storage/storage.hpp"
+#include "util/exception.hpp"
+#include "util/simple_logger.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace osrm
+{
+namespace engine
+{
+namespace datafacade
+{
+
+/**
+ * This datafacade maps a memory image of the data files read-only instead of
+ * loading them. The image has the same layout as the block used by the
+ * ProcessMemoryDataFacade and is written next to the data files the first time
+ * it is needed or when the data files changed, starting from an existing image
+ * only maps it. Since the mapping is backed by the page cache all processes
+ * using the same image share the memory, similar to osrm-datastore.
+ */
+class MMapMemoryDataFacade final : public ContiguousInternalMemoryDataFacadeBase
+{
+
+  private:
+    boost::interprocess::mapped_region image_region;
+    storage::DataLayout layout;
+
+  public:
+    explicit MMapMemoryDataFacade(const storage::StorageConfig &config,
+                                  const bool prefault_memory = false)
+    {
+        storage::Storage storage(config);
+        if (!storage.IsMemoryImageValid())
+        {
+            storage.WriteMemoryImage();
+        }
+
+        const auto &image_path = config.memory_image_path.string();
+        util::SimpleLogger().Write() << "mapping memory image " << image_path;
+
+        const boost::interprocess::file_mapping mapping(image_path.c_str(),
+                                                        boost::interprocess::read_only);
+        image_region = boost::interprocess::mapped_region(mapping, boost::interprocess::read_only);
+
+        // the header can only be read once the image is known to be large enough to hold it
+        const auto image_size = image_region.get_size();
+        if (image_size < sizeof(storage::MemoryImageHeader))
+        {
+            throw util::exception("Memory image " + image_path + " is truncated");
+        }
+        char *image_ptr = static_cast<char *>(image_region.get_address());
+        const auto header = reinterpret_cast<const storage::MemoryImageHeader *>(image_ptr);
+        if (header->data_offset > image_size ||
+            image_size - header->data_offset < header->layout.GetSizeOfLayout())
+        {
+            throw util::exception("Memory image " + image_path + " is truncated");
+        }
+        layout = header->layout;
+
+        if (prefault_memory)
+        {
+            storage::prefaultMemory(image_region.get_address(), image_region.get_size());
+        }
+
+        // Adjust all the private m_* members to point into the mapping
+        InitializeInternalPointers(layout, image_ptr + header->data_offset);
+
+        if (prefault_memory)
+        {
+            PrefetchRTreeLeaves();
+        }
+    }
+};
+}
+}
+}
+
+#endif // MMAP_MEMORY_DATAFACADE_HPP
@@ -4,6 +4,7 @@
 // implements all data storage when shared memory is _NOT_ used
 
 #include "engine/datafacade/contiguous_internalmem_datafacade_base.hpp"
+#include "storage/huge_pages.hpp"
 #include "storage/storage.hpp"
 
 namespace osrm
@@ -19,17 +20,19 @@ namespace datafacade
  * shared memory, so this class, and the SharedMemoryDataFacade both
  * share a common base.
  * This class holds a unique_ptr to the memory block, so it
- * is auto-freed upon destruction.
+ * is auto-freed upon destruction. The block can be backed by huge pages.
  */
 class ProcessMemoryDataFacade final : public ContiguousInternalMemoryDataFacadeBase
 {
 
   private:
-    std::unique_ptr<char[]> internal_memory;
+    std::unique_ptr<storage::ProcessMemory> internal_memory;
     std::unique_ptr<storage::DataLayout> internal_layout;
 
   public:
-    explicit ProcessMemoryDataFacade(const storage::StorageConfig &config)
+    explicit ProcessMemoryDataFacade(const storage::StorageConfig &config,
+                                     const storage::HugePages huge_pages = storage::HugePages::None,
+                                     const bool prefault_memory = false)
     {
         storage::Storage storage(config);
 
@@ -38,11 +41,18 @@ class ProcessMemoryDataFacade final : public ContiguousInternalMemoryDataFacadeB
         storage.PopulateLayout(*internal_layout);
 
         // Allocate the memory block, then load data from files into it
-        internal_memory = std::make_unique<char[]>(internal_layout->GetSizeOfLayout());
-        storage.PopulateData(*internal_layout, internal_memory.get());
+        internal_memory = std::make_unique<storage::ProcessMemory>(
+            internal_layout->GetSizeOfLayout(), huge_pages);
+        storage.PopulateData(*internal_layout, internal_memory->Ptr());
 
         // Adjust all the private m_* members to point to the right places
-        InitializeInternalPointers(*internal_layout.get(), internal_memory.get());
+        InitializeInternalPointers(*internal_layout.get(), internal_memory->Ptr());
+
+        // the leaves are still mapped from the leaf node file
+        if (prefault_memory)
+        {
+            PrefetchRTreeLeaves();
+        }
     }
 };
 }
@@ -86,6 +86,8 @@ class SharedMemoryDataFacade : public ContiguousInternalMemoryDataFacadeBase
         InitializeInternalPointers(*reinterpret_cast<storage::DataLayout *>(m_layout_memory->Ptr()),
                                    reinterpret_cast<char *>(m_large_memory->Ptr()));
     }
+
+    unsigned GetDatasetTimestamp() const override final { return shared_timestamp; }
 };
 }
 }
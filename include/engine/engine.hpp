@@ -8,9 +8,14 @@
 #include "engine/api/table_parameters.hpp"
 #include "engine/api/tile_parameters.hpp"
 #include "engine/api/trip_parameters.hpp"
+#include "engine/cache_statistics.hpp"
 #include "engine/data_watchdog.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/engine_config.hpp"
+#include "engine/matching_sessions.hpp"
+#include "engine/snapping_cache.hpp"
+#include "engine/tile_archive.hpp"
+#include "engine/tile_cache.hpp"
 #include "engine/plugins/match.hpp"
 #include "engine/plugins/nearest.hpp"
 #include "engine/plugins/table.hpp"
@@ -23,6 +28,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -41,16 +47,31 @@ class Engine final
     Engine &operator=(const Engine &) = delete;
 
     Status Route(const api::RouteParameters &parameters, util::json::Object &result) const;
+    Status Route(const api::RouteParameters &parameters, std::string &result) const;
     Status Table(const api::TableParameters &parameters, util::json::Object &result) const;
+    Status Table(const api::TableParameters &parameters, std::vector<char> &result) const;
+    Status Table(const api::TableParameters &parameters, std::string &result) const;
     Status Nearest(const api::NearestParameters &parameters, util::json::Object &result) const;
     Status Trip(const api::TripParameters &parameters, util::json::Object &result) const;
     Status Match(const api::MatchParameters &parameters, util::json::Object &result) const;
+    Status Match(const std::vector<api::MatchParameters> &parameters,
+                 util::json::Object &result) const;
     Status Tile(const api::TileParameters &parameters, std::string &result) const;
 
+    CacheStatistics GetSnappingCacheStatistics() const;
+
   private:
     std::unique_ptr<storage::SharedBarriers> lock;
     std::unique_ptr<DataWatchdog> watchdog;
 
+    // shared by the plugins, empty if disabled
+    std::shared_ptr<SnappingCache> snapping_cache;
+    // online map matching state, empty if disabled
+    std::shared_ptr<MatchingSessions> matching_sessions;
+    // rendered debug tiles, empty if disabled
+    std::shared_ptr<TileCache> tile_cache;
+    std::shared_ptr<const TileArchive> tile_archive;
+
     const plugins::ViaRoutePlugin route_plugin;
     const plugins::TablePlugin table_plugin;
     const plugins::NearestPlugin nearest_plugin;
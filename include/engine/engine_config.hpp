@@ -28,10 +28,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ENGINE_CONFIG_HPP
 #define ENGINE_CONFIG_HPP
 
+#include "storage/huge_pages.hpp"
 #include "storage/storage_config.hpp"
 
 #include <boost/filesystem/path.hpp>
 
+#include <cstddef>
 #include <string>
 
 namespace osrm
@@ -54,6 +56,8 @@ namespace engine
  *  - Nearest
  *
  * In addition, shared memory can be used for datasets loaded with osrm-datastore.
+ * Without shared memory the data files can be memory mapped instead of loaded (use_mmap), which
+ * starts up faster and lets processes using the same files share the memory.
  *
  * \see OSRM, StorageConfig
  */
@@ -64,10 +68,29 @@ struct EngineConfig final
     storage::StorageConfig storage_config;
     int max_locations_trip = -1;
     int max_locations_viaroute = -1;
+    // maximum number of alternatives of a route request
+    int max_alternatives = -1;
     int max_locations_distance_table = -1;
     int max_locations_map_matching = -1;
     int max_results_nearest = -1;
+    // maximum number of traces of a batch match request
+    int max_traces_map_matching = -1;
     bool use_shared_memory = true;
+    bool use_mmap = false;
+    // pages backing the data loaded into process memory
+    storage::HugePages huge_pages = storage::HugePages::None;
+    // touch all mapped data on startup instead of faulting it in on the first queries
+    bool prefault_memory = false;
+    // number of snapped coordinates kept across requests, 0 disables the cache
+    std::size_t snapping_cache_size = 0;
+    // number of online map matching sessions kept, 0 disables them
+    std::size_t max_matching_sessions = 0;
+    // seconds an unused online map matching session is kept
+    unsigned matching_session_timeout = 60;
+    // bytes of rendered debug tiles kept across requests, 0 disables the cache
+    std::size_t tile_cache_size = 0;
+    // debug tiles rendered ahead of time by osrm-tiles, served instead of rendering them
+    boost::filesystem::path tile_archive_path;
 };
 }
 }
@@ -48,6 +48,19 @@ struct TransitionLogProbability
     double operator()(const double d_t) const { return -log_beta - d_t / beta; }
 };
 
+// Rows of a hidden markov model kept for the next call of an online matching. Parents refer to
+// the rows kept, rows whose parent was dropped are their own parent.
+struct HiddenMarkovModelState
+{
+    std::vector<std::vector<double>> viterbi;
+    std::vector<std::vector<std::pair<unsigned, unsigned>>> parents;
+    std::vector<std::vector<float>> path_distances;
+    std::vector<std::vector<bool>> pruned;
+    std::vector<bool> breakage;
+
+    std::size_t NumberOfRows() const { return breakage.size(); }
+};
+
 template <class CandidateLists> struct HiddenMarkovModel
 {
     std::vector<std::vector<double>> viterbi;
@@ -100,6 +113,53 @@ template <class CandidateLists> struct HiddenMarkovModel
         std::fill(breakage.begin() + initial_timestamp, breakage.end(), true);
     }
 
+    // Copies the rows of a previous model into the first rows of this one, the candidates of
+    // these rows have to be the same
+    void Restore(const HiddenMarkovModelState &state)
+    {
+        BOOST_ASSERT(state.NumberOfRows() <= viterbi.size());
+
+        for (const auto t : util::irange<std::size_t>(0UL, state.NumberOfRows()))
+        {
+            BOOST_ASSERT(state.viterbi[t].size() == viterbi[t].size());
+            viterbi[t] = state.viterbi[t];
+            parents[t] = state.parents[t];
+            path_distances[t] = state.path_distances[t];
+            pruned[t] = state.pruned[t];
+            breakage[t] = state.breakage[t];
+        }
+    }
+
+    // Saves the rows from first_timestamp on
+    void Save(const std::size_t first_timestamp, HiddenMarkovModelState &state) const
+    {
+        BOOST_ASSERT(first_timestamp <= viterbi.size());
+
+        state.viterbi.assign(viterbi.begin() + first_timestamp, viterbi.end());
+        state.parents.assign(parents.begin() + first_timestamp, parents.end());
+        state.path_distances.assign(path_distances.begin() + first_timestamp,
+                                    path_distances.end());
+        state.pruned.assign(pruned.begin() + first_timestamp, pruned.end());
+        state.breakage.assign(breakage.begin() + first_timestamp, breakage.end());
+
+        for (const auto t : util::irange<std::size_t>(0UL, state.NumberOfRows()))
+        {
+            for (const auto s : util::irange<std::size_t>(0UL, state.parents[t].size()))
+            {
+                auto &parent = state.parents[t][s];
+                if (parent.first < first_timestamp)
+                {
+                    parent = std::make_pair(t, s);
+                    state.path_distances[t][s] = 0;
+                }
+                else
+                {
+                    parent.first -= first_timestamp;
+                }
+            }
+        }
+    }
+
     std::size_t initialize(std::size_t initial_timestamp)
     {
         auto num_points = candidates_list.size();
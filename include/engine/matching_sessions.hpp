@@ -0,0 +1,102 @@
+#ifndef ENGINE_MATCHING_SESSIONS_HPP
+#define ENGINE_MATCHING_SESSIONS_HPP
+
+#include "engine/routing_algorithms/map_matching.hpp"
+
+#include "util/coordinate.hpp"
+
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+/**
+ * Keeps the state of online map matchings between requests. Live tracking clients send the new
+ * trace points of a vehicle with the id of its session, only these points are matched against
+ * the Viterbi state carried over from the previous request instead of matching the whole trace
+ * again.
+ *
+ * The ids are generated when a session is opened. They are 128 random bits taken from
+ * std::random_device, so a client cannot guess the id of another client's session.
+ *
+ * Sessions expire after not being used for the timeout given. If there are more sessions than
+ * the capacity the least recently used one is dropped.
+ */
+class MatchingSessions
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    // The last trace points of a session and the matching state covering them
+    struct Session
+    {
+        // held while a request updates the session
+        std::mutex mutex;
+        // candidates are only valid on the dataset they were snapped on
+        unsigned dataset_timestamp = 0;
+        std::vector<util::Coordinate> coordinates;
+        std::vector<unsigned> timestamps;
+        std::vector<boost::optional<double>> gps_precisions;
+        routing_algorithms::CandidateLists candidates;
+        routing_algorithms::MatchingState state;
+
+        // Drops all points, e.g. when the dataset changed
+        void Reset(const unsigned new_dataset_timestamp);
+        // Drops the points the matching state does not cover anymore
+        void DropUnusedPoints();
+    };
+
+    MatchingSessions(const std::size_t capacity, const std::chrono::seconds timeout);
+
+    MatchingSessions(const MatchingSessions &) = delete;
+    MatchingSessions &operator=(const MatchingSessions &) = delete;
+
+    // Opens a new session, returns its id and the session
+    std::pair<std::string, std::shared_ptr<Session>> Open() { return Open(Clock::now()); }
+    std::pair<std::string, std::shared_ptr<Session>> Open(const Clock::time_point now);
+
+    // Returns the session with the given id, nullptr if it does not exist or expired
+    std::shared_ptr<Session> Find(const std::string &id) { return Find(id, Clock::now()); }
+    std::shared_ptr<Session> Find(const std::string &id, const Clock::time_point now);
+
+    std::size_t Size() const;
+
+  private:
+    struct Entry
+    {
+        std::string id;
+        std::shared_ptr<Session> session;
+        Clock::time_point last_used;
+    };
+    // most recently used first
+    using Entries = std::list<Entry>;
+
+    // both expect the mutex to be held, std::random_device is not thread safe
+    void DropExpired(const Clock::time_point now);
+    std::string MakeId();
+
+    const std::size_t capacity;
+    const std::chrono::seconds timeout;
+
+    mutable std::mutex mutex;
+    std::random_device random_device;
+    Entries entries;
+    std::unordered_map<std::string, Entries::iterator> index;
+};
+}
+}
+
+#endif
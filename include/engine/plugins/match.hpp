@@ -5,10 +5,12 @@
 #include "engine/plugins/plugin_base.hpp"
 
 #include "engine/map_matching/bayes_classifier.hpp"
+#include "engine/matching_sessions.hpp"
 #include "engine/routing_algorithms/map_matching.hpp"
 #include "engine/routing_algorithms/shortest_path.hpp"
 #include "util/json_util.hpp"
 
+#include <memory>
 #include <vector>
 
 namespace osrm
@@ -27,9 +29,12 @@ class MatchPlugin : public BasePlugin
     static const constexpr double DEFAULT_GPS_PRECISION = 5;
     static const constexpr double RADIUS_MULTIPLIER = 3;
 
-    MatchPlugin(const int max_locations_map_matching)
+    MatchPlugin(const int max_locations_map_matching,
+                const int max_traces_map_matching = -1,
+                std::shared_ptr<MatchingSessions> sessions = nullptr)
         : map_matching(heaps, DEFAULT_GPS_PRECISION), shortest_path(heaps),
-          max_locations_map_matching(max_locations_map_matching)
+          max_locations_map_matching(max_locations_map_matching),
+          max_traces_map_matching(max_traces_map_matching), sessions(std::move(sessions))
     {
     }
 
@@ -37,11 +42,39 @@ class MatchPlugin : public BasePlugin
                          const api::MatchParameters &parameters,
                          util::json::Object &json_result) const;
 
+    // Matches the traces in parallel. The response holds the result of every trace in input
+    // order, each with its own code, a failing trace does not fail the batch.
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const std::vector<api::MatchParameters> &parameters,
+                         util::json::Object &json_result) const;
+
   private:
+    // Opens or looks up the session of the request, the response holds the session id
+    Status HandleSessionRequest(const datafacade::BaseDataFacade &facade,
+                                const api::MatchParameters &parameters,
+                                const std::vector<double> &search_radiuses,
+                                util::json::Object &json_result) const;
+
+    // Extends the online matching of the session by the coordinates of the request
+    Status MatchSession(const datafacade::BaseDataFacade &facade,
+                        const api::MatchParameters &parameters,
+                        const std::vector<double> &search_radiuses,
+                        MatchingSessions::Session &session,
+                        util::json::Object &json_result) const;
+
+    // Computes the routes through the matched candidates and renders the response
+    Status MakeResponse(const datafacade::BaseDataFacade &facade,
+                        const api::MatchParameters &parameters,
+                        const SubMatchingList &sub_matchings,
+                        util::json::Object &json_result) const;
+
     mutable SearchEngineData heaps;
     mutable routing_algorithms::MapMatching<datafacade::BaseDataFacade> map_matching;
     mutable routing_algorithms::ShortestPathRouting<datafacade::BaseDataFacade> shortest_path;
     const int max_locations_map_matching;
+    const int max_traces_map_matching;
+    // empty if online matching is disabled
+    const std::shared_ptr<MatchingSessions> sessions;
 };
 }
 }
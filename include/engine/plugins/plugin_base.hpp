@@ -2,17 +2,25 @@
 #define BASE_PLUGIN_HPP
 
 #include "engine/api/base_parameters.hpp"
+#include "engine/api/protobuf_factory.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/phantom_node.hpp"
+#include "engine/snapping_cache.hpp"
 #include "engine/status.hpp"
 
 #include "util/coordinate.hpp"
 #include "util/coordinate_calculation.hpp"
+#include "util/hilbert_value.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_container.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,6 +34,14 @@ namespace plugins
 class BasePlugin
 {
   protected:
+    BasePlugin() = default;
+
+    // Plugins given a cache look up coordinates they snapped for earlier requests in it
+    explicit BasePlugin(std::shared_ptr<SnappingCache> snapping_cache_)
+        : snapping_cache(std::move(snapping_cache_))
+    {
+    }
+
     bool CheckAllCoordinates(const std::vector<util::Coordinate> &coordinates) const
     {
         return !std::any_of(
@@ -43,6 +59,13 @@ class BasePlugin
         return Status::Error;
     }
 
+    Status
+    Error(const std::string &code, const std::string &message, std::string &pbf_result) const
+    {
+        api::protobuf::makeError(code, message, pbf_result);
+        return Status::Error;
+    }
+
     // Decides whether to use the phantom node from a big or small component if both are found.
     // Returns true if all phantom nodes are in the same component after snapping.
     std::vector<PhantomNode>
@@ -119,8 +142,7 @@ class BasePlugin
         const bool use_hints = !parameters.hints.empty();
         const bool use_bearings = !parameters.bearings.empty();
 
-        for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
-        {
+        SnapInSpatialOrder(parameters.coordinates, [&](const std::size_t i) {
             if (use_hints && parameters.hints[i] &&
                 parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
             {
@@ -129,7 +151,7 @@ class BasePlugin
                     util::coordinate_calculation::haversineDistance(
                         parameters.coordinates[i], parameters.hints[i]->phantom.location),
                 });
-                continue;
+                return;
             }
             if (use_bearings && parameters.bearings[i])
             {
@@ -144,7 +166,7 @@ class BasePlugin
                 phantom_nodes[i] =
                     facade.NearestPhantomNodesInRange(parameters.coordinates[i], radiuses[i]);
             }
-        }
+        });
 
         return phantom_nodes;
     }
@@ -162,8 +184,7 @@ class BasePlugin
         const bool use_radiuses = !parameters.radiuses.empty();
 
         BOOST_ASSERT(parameters.IsValid());
-        for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
-        {
+        SnapInSpatialOrder(parameters.coordinates, [&](const std::size_t i) {
             if (use_hints && parameters.hints[i] &&
                 parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
             {
@@ -172,7 +193,7 @@ class BasePlugin
                     util::coordinate_calculation::haversineDistance(
                         parameters.coordinates[i], parameters.hints[i]->phantom.location),
                 });
-                continue;
+                return;
             }
 
             if (use_bearings && parameters.bearings[i])
@@ -206,13 +227,7 @@ class BasePlugin
                         facade.NearestPhantomNodes(parameters.coordinates[i], number_of_results);
                 }
             }
-
-            // we didn't find a fitting node, return error
-            if (phantom_nodes[i].empty())
-            {
-                break;
-            }
-        }
+        });
         return phantom_nodes;
     }
 
@@ -225,15 +240,26 @@ class BasePlugin
         const bool use_bearings = !parameters.bearings.empty();
         const bool use_radiuses = !parameters.radiuses.empty();
 
+        const auto dataset_timestamp = facade.GetDatasetTimestamp();
+
         BOOST_ASSERT(parameters.IsValid());
-        for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
-        {
+        SnapInSpatialOrder(parameters.coordinates, [&](const std::size_t i) {
             if (use_hints && parameters.hints[i] &&
                 parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
             {
                 phantom_node_pairs[i].first = parameters.hints[i]->phantom;
                 // we don't set the second one - it will be marked as invalid
-                continue;
+                return;
+            }
+
+            const SnappingCache::Key cache_key(
+                parameters.coordinates[i],
+                use_radiuses ? parameters.radiuses[i] : boost::none,
+                use_bearings ? parameters.bearings[i] : boost::none);
+            if (snapping_cache &&
+                snapping_cache->Find(dataset_timestamp, cache_key, phantom_node_pairs[i]))
+            {
+                return;
             }
 
             if (use_bearings && parameters.bearings[i])
@@ -272,6 +298,14 @@ class BasePlugin
                 }
             }
 
+            if (snapping_cache)
+            {
+                snapping_cache->Insert(dataset_timestamp, cache_key, phantom_node_pairs[i]);
+            }
+        });
+
+        for (const auto i : util::irange<std::size_t>(0UL, phantom_node_pairs.size()))
+        {
             // we didn't find a fitting node, return error
             if (!phantom_node_pairs[i].first.IsValid(facade.GetNumberOfNodes()))
             {
@@ -279,11 +313,41 @@ class BasePlugin
                 phantom_node_pairs.pop_back();
                 break;
             }
-            BOOST_ASSERT(phantom_node_pairs[i].first.IsValid(facade.GetNumberOfNodes()));
-            BOOST_ASSERT(phantom_node_pairs[i].second.IsValid(facade.GetNumberOfNodes()));
         }
         return phantom_node_pairs;
     }
+
+  private:
+    std::shared_ptr<SnappingCache> snapping_cache;
+
+    // Below this many coordinates snapping on the calling thread is faster than splitting it up
+    static const constexpr std::size_t PARALLEL_SNAPPING_THRESHOLD = 64;
+    static const constexpr std::size_t SNAPPING_GRAIN_SIZE = 16;
+
+    // Calls snap(i) for all coordinates, in the order of the hilbert curve. Nearest queries for
+    // consecutive coordinates walk mostly the same r-tree nodes and leaf pages, which are still
+    // cached from the previous query. Large batches are split into ranges of this order, so each
+    // thread snaps a spatially coherent group of coordinates.
+    template <typename SnapT>
+    void SnapInSpatialOrder(const std::vector<util::Coordinate> &coordinates,
+                            const SnapT &snap) const
+    {
+        const auto order = util::hilbertOrder(coordinates);
+        if (order.size() < PARALLEL_SNAPPING_THRESHOLD)
+        {
+            std::for_each(order.begin(), order.end(), snap);
+            return;
+        }
+
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, order.size(), SNAPPING_GRAIN_SIZE),
+            [&](const tbb::blocked_range<std::size_t> &range) {
+                for (auto position = range.begin(); position != range.end(); ++position)
+                {
+                    snap(order[position]);
+                }
+            });
+    }
 };
 }
 }
@@ -8,6 +8,10 @@
 #include "engine/search_engine_data.hpp"
 #include "util/json_container.hpp"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace osrm
 {
 namespace engine
@@ -18,13 +22,33 @@ namespace plugins
 class TablePlugin final : public BasePlugin
 {
   public:
-    explicit TablePlugin(const int max_locations_distance_table);
+    explicit TablePlugin(const int max_locations_distance_table,
+                         std::shared_ptr<SnappingCache> snapping_cache = nullptr);
 
     Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                          const api::TableParameters &params,
                          util::json::Object &result) const;
 
+    // Renders the JSON response directly into the buffer, see util::json::Writer.
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::TableParameters &params,
+                         std::vector<char> &result) const;
+
+    // Protobuf response, see api::TableAPI.
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::TableParameters &params,
+                         std::string &result) const;
+
   private:
+    using TablesT = std::pair<std::vector<EdgeWeight>, std::vector<double>>;
+
+    // Computes the tables, or fills error_result and returns an error status.
+    Status ComputeTables(const datafacade::BaseDataFacade &facade,
+                         const api::TableParameters &params,
+                         std::vector<PhantomNode> &snapped_phantoms,
+                         TablesT &tables,
+                         util::json::Object &error_result) const;
+
     mutable SearchEngineData heaps;
     mutable routing_algorithms::ManyToManyRouting<datafacade::BaseDataFacade> distance_table;
     const int max_locations_distance_table;
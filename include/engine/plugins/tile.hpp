@@ -5,7 +5,10 @@
 #include "engine/plugins/plugin_base.hpp"
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/routing_algorithms/shortest_path.hpp"
+#include "engine/tile_archive.hpp"
+#include "engine/tile_cache.hpp"
 
+#include <memory>
 #include <string>
 
 /*
@@ -15,6 +18,9 @@
  * to display maps that show the exact road network that
  * OSRM is routing.  This is very useful for debugging routing
  * errors
+ *
+ * Tiles are looked up in a pre-rendered tile archive and a cache of recently
+ * rendered tiles first, if given.
  */
 namespace osrm
 {
@@ -26,9 +32,20 @@ namespace plugins
 class TilePlugin final : public BasePlugin
 {
   public:
+    explicit TilePlugin(std::shared_ptr<TileCache> tile_cache = nullptr,
+                        std::shared_ptr<const TileArchive> tile_archive = nullptr);
+
     Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                          const api::TileParameters &parameters,
                          std::string &pbf_buffer) const;
+
+  private:
+    Status RenderTile(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                      const api::TileParameters &parameters,
+                      std::string &pbf_buffer) const;
+
+    const std::shared_ptr<TileCache> tile_cache;
+    const std::shared_ptr<const TileArchive> tile_archive;
 };
 }
 }
@@ -39,8 +39,10 @@ class TripPlugin final : public BasePlugin
                                      const std::vector<NodeID> &trip) const;
 
   public:
-    explicit TripPlugin(const int max_locations_trip_)
-        : shortest_path(heaps), duration_table(heaps), max_locations_trip(max_locations_trip_)
+    explicit TripPlugin(const int max_locations_trip_,
+                        std::shared_ptr<SnappingCache> snapping_cache = nullptr)
+        : BasePlugin(std::move(snapping_cache)), shortest_path(heaps), duration_table(heaps),
+          max_locations_trip(max_locations_trip_)
     {
     }
 
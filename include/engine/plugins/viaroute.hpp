@@ -34,13 +34,26 @@ class ViaRoutePlugin final : public BasePlugin
     mutable routing_algorithms::DirectShortestPathRouting<datafacade::BaseDataFacade>
         direct_shortest_path;
     const int max_locations_viaroute;
+    const int max_alternatives;
+
+    template <typename ResultT>
+    Status HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                             const api::RouteParameters &route_parameters,
+                             ResultT &result) const;
 
   public:
-    explicit ViaRoutePlugin(int max_locations_viaroute);
+    ViaRoutePlugin(int max_locations_viaroute,
+                   int max_alternatives,
+                   std::shared_ptr<SnappingCache> snapping_cache = nullptr);
 
     Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                          const api::RouteParameters &route_parameters,
                          util::json::Object &json_result) const;
+
+    // Protobuf response, see api::RouteAPI.
+    Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                         const api::RouteParameters &route_parameters,
+                         std::string &pbf_result) const;
 };
 }
 }
@@ -8,10 +8,12 @@
 #include <boost/assert.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <iterator>
+#include <stack>
 #include <unordered_map>
 #include <unordered_set>
-
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -31,8 +33,11 @@ class AlternativeRouting final
 {
     using super = BasicRoutingInterface<DataFacadeT, AlternativeRouting<DataFacadeT>>;
     using EdgeData = typename DataFacadeT::EdgeData;
+    using SearchEdgeData = typename DataFacadeT::SearchEdgeData;
     using QueryHeap = SearchEngineData::QueryHeap;
     using SearchSpaceEdge = std::pair<NodeID, NodeID>;
+    // original edge, packed into a single key, and its weight
+    using UnpackedEdge = std::pair<std::uint64_t, EdgeWeight>;
 
     struct RankedCandidateNode
     {
@@ -60,24 +65,24 @@ class AlternativeRouting final
 
     virtual ~AlternativeRouting() {}
 
+    // Finds up to number_of_alternatives alternatives next to the shortest path, ranked by length
+    // and sharing. All via paths are taken from the search spaces of the single bidirectional
+    // search, only the T-Test of the best candidates runs additional (local) searches.
     void operator()(const DataFacadeT &facade,
                     const PhantomNodes &phantom_node_pair,
+                    const unsigned number_of_alternatives,
                     InternalRouteResult &raw_route_data)
     {
-        std::vector<NodeID> alternative_path;
         std::vector<NodeID> via_node_candidate_list;
         std::vector<SearchSpaceEdge> forward_search_space;
         std::vector<SearchSpaceEdge> reverse_search_space;
 
         // Init queues, semi-expensive because access to TSS invokes a sys-call
         engine_working_data.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes());
-        engine_working_data.InitializeOrClearSecondThreadLocalStorage(facade.GetNumberOfNodes());
         engine_working_data.InitializeOrClearThirdThreadLocalStorage(facade.GetNumberOfNodes());
 
         QueryHeap &forward_heap1 = *(engine_working_data.forward_heap_1);
         QueryHeap &reverse_heap1 = *(engine_working_data.reverse_heap_1);
-        QueryHeap &forward_heap2 = *(engine_working_data.forward_heap_2);
-        QueryHeap &reverse_heap2 = *(engine_working_data.reverse_heap_2);
 
         int upper_bound_to_shortest_path_weight = INVALID_EDGE_WEIGHT;
         NodeID middle_node = SPECIAL_NODEID;
@@ -235,14 +240,9 @@ class AlternativeRouting final
             }
         }
 
-        // util::SimpleLogger().Write(logDEBUG) << "fwd_search_space size: " <<
-        // forward_search_space.size() << ", marked " << approximated_forward_sharing.size() << "
-        // nodes";
-        // util::SimpleLogger().Write(logDEBUG) << "rev_search_space size: " <<
-        // reverse_search_space.size() << ", marked " << approximated_reverse_sharing.size() << "
-        // nodes";
-
-        std::vector<NodeID> preselected_node_list;
+        // The via paths <s,..,v,..,t> follow the parent pointers of both search spaces, so their
+        // length is known from the keys and their sharing with the shortest path from the sweeps.
+        std::vector<RankedCandidateNode> ranked_candidates_list;
         for (const NodeID node : via_node_candidate_list)
         {
             if (node == middle_node)
@@ -267,9 +267,11 @@ class AlternativeRouting final
 
             if (length_passes && sharing_passes && stretch_passes)
             {
-                preselected_node_list.emplace_back(node);
+                ranked_candidates_list.emplace_back(
+                    node, approximated_length, approximated_sharing);
             }
         }
+        std::sort(ranked_candidates_list.begin(), ranked_candidates_list.end());
 
         std::vector<NodeID> &packed_shortest_path = packed_forward_path;
         if (!path_is_a_loop)
@@ -279,85 +281,110 @@ class AlternativeRouting final
             packed_shortest_path.insert(
                 packed_shortest_path.end(), packed_reverse_path.begin(), packed_reverse_path.end());
         }
-        std::vector<RankedCandidateNode> ranked_candidates_list;
 
-        // prioritizing via nodes for deep inspection
-        for (const NodeID node : preselected_node_list)
+        // Unpack shortest path
+        BOOST_ASSERT(!packed_shortest_path.empty());
+        raw_route_data.unpacked_path_segments.resize(1);
+        raw_route_data.source_traversed_in_reverse.push_back(
+            (packed_shortest_path.front() !=
+             phantom_node_pair.source_phantom.forward_segment_id.id));
+        raw_route_data.target_traversed_in_reverse.push_back(
+            (packed_shortest_path.back() !=
+             phantom_node_pair.target_phantom.forward_segment_id.id));
+
+        super::UnpackPath(facade,
+                          // -- packed input
+                          packed_shortest_path.begin(),
+                          packed_shortest_path.end(),
+                          // -- start of route
+                          phantom_node_pair,
+                          // -- unpacked output
+                          raw_route_data.unpacked_path_segments.front());
+        raw_route_data.shortest_path_length = upper_bound_to_shortest_path_weight;
+
+        if (ranked_candidates_list.empty() || number_of_alternatives == 0)
         {
-            int length_of_via_path = 0, sharing_of_via_path = 0;
-            ComputeLengthAndSharingOfViaPath(facade,
-                                             node,
-                                             &length_of_via_path,
-                                             &sharing_of_via_path,
-                                             packed_shortest_path,
-                                             min_edge_offset);
-            const int maximum_allowed_sharing =
-                static_cast<int>(upper_bound_to_shortest_path_weight * VIAPATH_GAMMA);
-            if (sharing_of_via_path <= maximum_allowed_sharing &&
-                length_of_via_path <= upper_bound_to_shortest_path_weight * (1 + VIAPATH_EPSILON))
-            {
-                ranked_candidates_list.emplace_back(node, length_of_via_path, sharing_of_via_path);
-            }
+            return;
         }
-        std::sort(ranked_candidates_list.begin(), ranked_candidates_list.end());
 
-        NodeID selected_via_node = SPECIAL_NODEID;
-        int length_of_via_path = INVALID_EDGE_WEIGHT;
-        NodeID s_v_middle = SPECIAL_NODEID, v_t_middle = SPECIAL_NODEID;
+        // Select the best ranked candidates that share little with the shortest path and all
+        // alternatives selected before. Packed paths share at most as much as their unpacked
+        // edges, so candidates failing on the packed paths are discarded without unpacking.
+        const int maximum_allowed_sharing =
+            static_cast<int>(upper_bound_to_shortest_path_weight * VIAPATH_GAMMA);
+        std::unordered_set<std::uint64_t> selected_edges;
+        std::vector<UnpackedEdge> unpacked_edges;
+        UnpackEdges(facade, packed_shortest_path, unpacked_edges);
+        for (const auto &edge : unpacked_edges)
+        {
+            selected_edges.insert(edge.first);
+        }
+
+        std::vector<NodeID> selected_via_nodes;
+        std::unordered_set<NodeID> nodes_on_path;
+        std::vector<NodeID> packed_s_v_path;
+        std::vector<NodeID> packed_v_t_path;
         for (const RankedCandidateNode &candidate : ranked_candidates_list)
         {
-            if (ViaNodeCandidatePassesTTest(facade,
-                                            forward_heap1,
-                                            reverse_heap1,
-                                            forward_heap2,
-                                            reverse_heap2,
-                                            candidate,
-                                            upper_bound_to_shortest_path_weight,
-                                            &length_of_via_path,
-                                            &s_v_middle,
-                                            &v_t_middle,
-                                            min_edge_offset))
+            const bool packed_sharing_passes =
+                std::all_of(selected_via_nodes.begin(),
+                            selected_via_nodes.end(),
+                            [&](const NodeID via_node) {
+                                return ComputePackedSharing(forward_heap1,
+                                                            reverse_heap1,
+                                                            candidate.node,
+                                                            via_node,
+                                                            nodes_on_path) <=
+                                       maximum_allowed_sharing;
+                            });
+            if (!packed_sharing_passes)
             {
-                // select first admissable
-                selected_via_node = candidate.node;
-                break;
+                continue;
             }
-        }
 
-        // Unpack shortest path and alternative, if they exist
-        if (INVALID_EDGE_WEIGHT != upper_bound_to_shortest_path_weight)
-        {
-            BOOST_ASSERT(!packed_shortest_path.empty());
-            raw_route_data.unpacked_path_segments.resize(1);
-            raw_route_data.source_traversed_in_reverse.push_back(
-                (packed_shortest_path.front() !=
-                 phantom_node_pair.source_phantom.forward_segment_id.id));
-            raw_route_data.target_traversed_in_reverse.push_back(
-                (packed_shortest_path.back() !=
-                 phantom_node_pair.target_phantom.forward_segment_id.id));
+            packed_s_v_path.clear();
+            super::RetrievePackedPathFromSingleHeap(forward_heap1, candidate.node, packed_s_v_path);
+            std::reverse(packed_s_v_path.begin(), packed_s_v_path.end());
+            packed_s_v_path.emplace_back(candidate.node);
+            packed_v_t_path.clear();
+            packed_v_t_path.emplace_back(candidate.node);
+            super::RetrievePackedPathFromSingleHeap(reverse_heap1, candidate.node, packed_v_t_path);
+
+            unpacked_edges.clear();
+            UnpackEdges(facade, packed_s_v_path, unpacked_edges);
+            UnpackEdges(facade, packed_v_t_path, unpacked_edges);
+            int sharing_of_via_path = 0;
+            for (const auto &edge : unpacked_edges)
+            {
+                if (selected_edges.count(edge.first) > 0)
+                {
+                    sharing_of_via_path += edge.second;
+                }
+            }
+            if (sharing_of_via_path > maximum_allowed_sharing)
+            {
+                continue;
+            }
 
-            super::UnpackPath(facade,
-                              // -- packed input
-                              packed_shortest_path.begin(),
-                              packed_shortest_path.end(),
-                              // -- start of route
-                              phantom_node_pair,
-                              // -- unpacked output
-                              raw_route_data.unpacked_path_segments.front());
-            raw_route_data.shortest_path_length = upper_bound_to_shortest_path_weight;
-        }
+            if (!ViaNodeCandidatePassesTTest(facade,
+                                             packed_s_v_path,
+                                             packed_v_t_path,
+                                             upper_bound_to_shortest_path_weight,
+                                             min_edge_offset))
+            {
+                continue;
+            }
 
-        if (SPECIAL_NODEID != selected_via_node)
-        {
-            std::vector<NodeID> packed_alternate_path;
-            // retrieve alternate path
-            RetrievePackedAlternatePath(forward_heap1,
-                                        reverse_heap1,
-                                        forward_heap2,
-                                        reverse_heap2,
-                                        s_v_middle,
-                                        v_t_middle,
-                                        packed_alternate_path);
+            selected_via_nodes.push_back(candidate.node);
+            for (const auto &edge : unpacked_edges)
+            {
+                selected_edges.insert(edge.first);
+            }
+
+            std::vector<NodeID> &packed_alternate_path = packed_s_v_path;
+            packed_alternate_path.insert(packed_alternate_path.end(),
+                                         std::next(packed_v_t_path.begin()),
+                                         packed_v_t_path.end());
 
             raw_route_data.alt_source_traversed_in_reverse.push_back(
                 (packed_alternate_path.front() !=
@@ -367,263 +394,83 @@ class AlternativeRouting final
                  phantom_node_pair.target_phantom.forward_segment_id.id));
 
             // unpack the alternate path
+            raw_route_data.unpacked_alternatives.emplace_back();
             super::UnpackPath(facade,
                               packed_alternate_path.begin(),
                               packed_alternate_path.end(),
                               phantom_node_pair,
-                              raw_route_data.unpacked_alternative);
+                              raw_route_data.unpacked_alternatives.back());
 
-            raw_route_data.alternative_path_length = length_of_via_path;
-        }
-        else
-        {
-            BOOST_ASSERT(raw_route_data.alternative_path_length == INVALID_EDGE_WEIGHT);
+            raw_route_data.alternative_path_lengths.push_back(candidate.length);
+
+            if (selected_via_nodes.size() == number_of_alternatives)
+            {
+                break;
+            }
         }
     }
 
   private:
-    // unpack alternate <s,..,v,..,t> by exploring search spaces from v
-    void RetrievePackedAlternatePath(const QueryHeap &forward_heap1,
-                                     const QueryHeap &reverse_heap1,
-                                     const QueryHeap &forward_heap2,
-                                     const QueryHeap &reverse_heap2,
-                                     const NodeID s_v_middle,
-                                     const NodeID v_t_middle,
-                                     std::vector<NodeID> &packed_path) const
+    // Weight shared by the via paths of two candidates. Both follow the parent pointers of the
+    // search spaces, so they share the path from s to their last common ancestor in the forward
+    // search space and the path from the last common ancestor in the reverse one to t.
+    // nodes_on_path is scratch space reused by all candidates of a query.
+    int ComputePackedSharing(const QueryHeap &forward_heap,
+                             const QueryHeap &reverse_heap,
+                             const NodeID first_via_node,
+                             const NodeID second_via_node,
+                             std::unordered_set<NodeID> &nodes_on_path) const
     {
-        // fetch packed path [s,v)
-        std::vector<NodeID> packed_v_t_path;
-        super::RetrievePackedPathFromHeap(forward_heap1, reverse_heap2, s_v_middle, packed_path);
-        packed_path.pop_back(); // remove middle node. It's in both half-paths
-
-        // fetch patched path [v,t]
-        super::RetrievePackedPathFromHeap(
-            forward_heap2, reverse_heap1, v_t_middle, packed_v_t_path);
-
-        packed_path.insert(packed_path.end(), packed_v_t_path.begin(), packed_v_t_path.end());
+        return ComputeCommonPrefixWeight(
+                   forward_heap, first_via_node, second_via_node, nodes_on_path) +
+               ComputeCommonPrefixWeight(
+                   reverse_heap, first_via_node, second_via_node, nodes_on_path);
     }
 
-    // TODO: reorder parameters
-    // compute and unpack <s,..,v> and <v,..,t> by exploring search spaces
-    // from v and intersecting against queues. only half-searches have to be
-    // done at this stage
-    void ComputeLengthAndSharingOfViaPath(const DataFacadeT &facade,
-                                          const NodeID via_node,
-                                          int *real_length_of_via_path,
-                                          int *sharing_of_via_path,
-                                          const std::vector<NodeID> &packed_shortest_path,
-                                          const EdgeWeight min_edge_offset)
+    int ComputeCommonPrefixWeight(const QueryHeap &search_heap,
+                                  const NodeID first_node,
+                                  const NodeID second_node,
+                                  std::unordered_set<NodeID> &nodes_on_path) const
     {
-        engine_working_data.InitializeOrClearSecondThreadLocalStorage(facade.GetNumberOfNodes());
-
-        QueryHeap &existing_forward_heap = *engine_working_data.forward_heap_1;
-        QueryHeap &existing_reverse_heap = *engine_working_data.reverse_heap_1;
-        QueryHeap &new_forward_heap = *engine_working_data.forward_heap_2;
-        QueryHeap &new_reverse_heap = *engine_working_data.reverse_heap_2;
-
-        std::vector<NodeID> packed_s_v_path;
-        std::vector<NodeID> packed_v_t_path;
-
-        std::vector<NodeID> partially_unpacked_shortest_path;
-        std::vector<NodeID> partially_unpacked_via_path;
-
-        NodeID s_v_middle = SPECIAL_NODEID;
-        int upper_bound_s_v_path_length = INVALID_EDGE_WEIGHT;
-        new_reverse_heap.Insert(via_node, 0, via_node);
-        // compute path <s,..,v> by reusing forward search from s
-        const bool constexpr STALLING_ENABLED = true;
-        const bool constexpr DO_NOT_FORCE_LOOPS = false;
-        while (!new_reverse_heap.Empty())
+        // same walk as RetrievePackedPathFromSingleHeap, without materializing the path
+        nodes_on_path.clear();
+        NodeID node_on_path = second_node;
+        nodes_on_path.insert(node_on_path);
+        while (node_on_path != search_heap.GetData(node_on_path).parent &&
+               search_heap.WasInserted(search_heap.GetData(node_on_path).parent))
         {
-            super::RoutingStep(facade,
-                               new_reverse_heap,
-                               existing_forward_heap,
-                               s_v_middle,
-                               upper_bound_s_v_path_length,
-                               min_edge_offset,
-                               false,
-                               STALLING_ENABLED,
-                               DO_NOT_FORCE_LOOPS,
-                               DO_NOT_FORCE_LOOPS);
-        }
-        // compute path <v,..,t> by reusing backward search from node t
-        NodeID v_t_middle = SPECIAL_NODEID;
-        int upper_bound_of_v_t_path_length = INVALID_EDGE_WEIGHT;
-        new_forward_heap.Insert(via_node, 0, via_node);
-        while (!new_forward_heap.Empty())
-        {
-            super::RoutingStep(facade,
-                               new_forward_heap,
-                               existing_reverse_heap,
-                               v_t_middle,
-                               upper_bound_of_v_t_path_length,
-                               min_edge_offset,
-                               true,
-                               STALLING_ENABLED,
-                               DO_NOT_FORCE_LOOPS,
-                               DO_NOT_FORCE_LOOPS);
-        }
-        *real_length_of_via_path = upper_bound_s_v_path_length + upper_bound_of_v_t_path_length;
-
-        if (SPECIAL_NODEID == s_v_middle || SPECIAL_NODEID == v_t_middle)
-        {
-            return;
-        }
-
-        // retrieve packed paths
-        super::RetrievePackedPathFromHeap(
-            existing_forward_heap, new_reverse_heap, s_v_middle, packed_s_v_path);
-        super::RetrievePackedPathFromHeap(
-            new_forward_heap, existing_reverse_heap, v_t_middle, packed_v_t_path);
-
-        // partial unpacking, compute sharing
-        // First partially unpack s-->v until paths deviate, note length of common path.
-        const auto s_v_min_path_size =
-            std::min(packed_s_v_path.size(), packed_shortest_path.size()) - 1;
-        for (const auto current_node : util::irange<std::size_t>(0UL, s_v_min_path_size))
-        {
-            if (packed_s_v_path[current_node] == packed_shortest_path[current_node] &&
-                packed_s_v_path[current_node + 1] == packed_shortest_path[current_node + 1])
-            {
-                EdgeID edgeID = facade.FindEdgeInEitherDirection(packed_s_v_path[current_node],
-                                                                 packed_s_v_path[current_node + 1]);
-                *sharing_of_via_path += facade.GetEdgeData(edgeID).weight;
-            }
-            else
-            {
-                if (packed_s_v_path[current_node] == packed_shortest_path[current_node])
-                {
-                    super::UnpackEdge(facade,
-                                      packed_s_v_path[current_node],
-                                      packed_s_v_path[current_node + 1],
-                                      partially_unpacked_via_path);
-                    super::UnpackEdge(facade,
-                                      packed_shortest_path[current_node],
-                                      packed_shortest_path[current_node + 1],
-                                      partially_unpacked_shortest_path);
-                    break;
-                }
-            }
-        }
-        // traverse partially unpacked edge and note common prefix
-        const int64_t packed_path_length =
-            static_cast<int64_t>(std::min(partially_unpacked_via_path.size(),
-                                          partially_unpacked_shortest_path.size())) -
-            1;
-        for (int64_t current_node = 0; (current_node < packed_path_length) &&
-                                       (partially_unpacked_via_path[current_node] ==
-                                            partially_unpacked_shortest_path[current_node] &&
-                                        partially_unpacked_via_path[current_node + 1] ==
-                                            partially_unpacked_shortest_path[current_node + 1]);
-             ++current_node)
-        {
-            EdgeID selected_edge =
-                facade.FindEdgeInEitherDirection(partially_unpacked_via_path[current_node],
-                                                 partially_unpacked_via_path[current_node + 1]);
-            *sharing_of_via_path += facade.GetEdgeData(selected_edge).weight;
+            node_on_path = search_heap.GetData(node_on_path).parent;
+            nodes_on_path.insert(node_on_path);
         }
 
-        // Second, partially unpack v-->t in reverse order until paths deviate and note lengths
-        int64_t via_path_index = static_cast<int64_t>(packed_v_t_path.size()) - 1;
-        int64_t shortest_path_index = static_cast<int64_t>(packed_shortest_path.size()) - 1;
-        for (; via_path_index > 0 && shortest_path_index > 0;
-             --via_path_index, --shortest_path_index)
+        NodeID current_node = first_node;
+        while (nodes_on_path.count(current_node) == 0)
         {
-            if (packed_v_t_path[via_path_index - 1] ==
-                    packed_shortest_path[shortest_path_index - 1] &&
-                packed_v_t_path[via_path_index] == packed_shortest_path[shortest_path_index])
-            {
-                EdgeID edgeID = facade.FindEdgeInEitherDirection(
-                    packed_v_t_path[via_path_index - 1], packed_v_t_path[via_path_index]);
-                *sharing_of_via_path += facade.GetEdgeData(edgeID).weight;
-            }
-            else
+            const NodeID parent = search_heap.GetData(current_node).parent;
+            if (parent == current_node || !search_heap.WasInserted(parent))
             {
-                if (packed_v_t_path[via_path_index] == packed_shortest_path[shortest_path_index])
-                {
-                    super::UnpackEdge(facade,
-                                      packed_v_t_path[via_path_index - 1],
-                                      packed_v_t_path[via_path_index],
-                                      partially_unpacked_via_path);
-                    super::UnpackEdge(facade,
-                                      packed_shortest_path[shortest_path_index - 1],
-                                      packed_shortest_path[shortest_path_index],
-                                      partially_unpacked_shortest_path);
-                    break;
-                }
+                return 0;
             }
+            current_node = parent;
         }
+        return std::max(0, search_heap.GetKey(current_node));
+    }
 
-        via_path_index = static_cast<int64_t>(partially_unpacked_via_path.size()) - 1;
-        shortest_path_index = static_cast<int64_t>(partially_unpacked_shortest_path.size()) - 1;
-        for (; via_path_index > 0 && shortest_path_index > 0;
-             --via_path_index, --shortest_path_index)
-        {
-            if (partially_unpacked_via_path[via_path_index - 1] ==
-                    partially_unpacked_shortest_path[shortest_path_index - 1] &&
-                partially_unpacked_via_path[via_path_index] ==
-                    partially_unpacked_shortest_path[shortest_path_index])
-            {
-                EdgeID edgeID = facade.FindEdgeInEitherDirection(
-                    partially_unpacked_via_path[via_path_index - 1],
-                    partially_unpacked_via_path[via_path_index]);
-                *sharing_of_via_path += facade.GetEdgeData(edgeID).weight;
-            }
-            else
-            {
-                break;
-            }
-        }
-        // finished partial unpacking spree! Amount of sharing is stored to appropriate pointer
-        // variable
+    // appends the original edges of a packed path with their weights
+    void UnpackEdges(const DataFacadeT &facade,
+                     const std::vector<NodeID> &packed_path,
+                     std::vector<UnpackedEdge> &unpacked_edges) const
+    {
+        UnpackCHPath(
+            facade,
+            packed_path.begin(),
+            packed_path.end(),
+            [&unpacked_edges](const std::pair<NodeID, NodeID> &edge, const EdgeData &data) {
+                const auto key = (static_cast<std::uint64_t>(edge.first) << 32) | edge.second;
+                unpacked_edges.emplace_back(key, data.weight);
+            });
     }
 
-    // int approximateAmountOfSharing(
-    //     const NodeID alternate_path_middle_node_id,
-    //     QueryHeap & forward_heap,
-    //     QueryHeap & reverse_heap,
-    //     const std::vector<NodeID> & packed_shortest_path
-    // ) const {
-    //     std::vector<NodeID> packed_alternate_path;
-    //     super::RetrievePackedPathFromHeap(
-    //         forward_heap,
-    //         reverse_heap,
-    //         alternate_path_middle_node_id,
-    //         packed_alternate_path
-    //     );
-
-    //     if(packed_shortest_path.size() < 2 || packed_alternate_path.size() < 2) {
-    //         return 0;
-    //     }
-
-    //     int sharing = 0;
-    //     int aindex = 0;
-    //     //compute forward sharing
-    //     while( (packed_alternate_path[aindex] == packed_shortest_path[aindex]) &&
-    //     (packed_alternate_path[aindex+1] == packed_shortest_path[aindex+1]) ) {
-    //         //            util::SimpleLogger().Write() << "retrieving edge (" <<
-    //         packed_alternate_path[aindex] << "," << packed_alternate_path[aindex+1] << ")";
-    //         EdgeID edgeID = facade->FindEdgeInEitherDirection(packed_alternate_path[aindex],
-    //         packed_alternate_path[aindex+1]);
-    //         sharing += facade->GetEdgeData(edgeID).weight;
-    //         ++aindex;
-    //     }
-
-    //     aindex = packed_alternate_path.size()-1;
-    //     int bindex = packed_shortest_path.size()-1;
-    //     //compute backward sharing
-    //     while( aindex > 0 && bindex > 0 && (packed_alternate_path[aindex] ==
-    //     packed_shortest_path[bindex]) && (packed_alternate_path[aindex-1] ==
-    //     packed_shortest_path[bindex-1]) ) {
-    //         EdgeID edgeID = facade->FindEdgeInEitherDirection(packed_alternate_path[aindex],
-    //         packed_alternate_path[aindex-1]);
-    //         sharing += facade->GetEdgeData(edgeID).weight;
-    //         --aindex; --bindex;
-    //     }
-    //     return sharing;
-    // }
-
-    // todo: reorder parameters
     template <bool is_forward_directed>
     void AlternativeRoutingStep(const DataFacadeT &facade,
                                 QueryHeap &heap1,
@@ -639,10 +486,6 @@ class AlternativeRouting final
 
         const NodeID node = forward_heap.DeleteMin();
         const int weight = forward_heap.GetKey(node);
-        // const NodeID parentnode = forward_heap.GetData(node).parent;
-        // util::SimpleLogger().Write() << (is_forward_directed ? "[fwd] " : "[rev] ") << "settled
-        // edge ("
-        // << parentnode << "," << node << "), dist: " << weight;
 
         const int scaled_weight =
             static_cast<int>((weight + min_edge_offset) / (1. + VIAPATH_EPSILON));
@@ -665,13 +508,6 @@ class AlternativeRouting final
                 {
                     *middle_node = node;
                     *upper_bound_to_shortest_path_weight = new_weight;
-                    //     util::SimpleLogger().Write() << "accepted middle_node " << *middle_node
-                    //     << " at
-                    //     weight " << new_weight;
-                    // } else {
-                    //     util::SimpleLogger().Write() << "discarded middle_node " << *middle_node
-                    //     << "
-                    //     at weight " << new_weight;
                 }
                 else
                 {
@@ -690,7 +526,7 @@ class AlternativeRouting final
 
         for (auto edge : facade.GetAdjacentEdgeRange(node))
         {
-            const EdgeData &data = facade.GetEdgeData(edge);
+            const SearchEdgeData &data = facade.GetSearchEdgeData(edge);
             const bool edge_is_forward_directed =
                 (is_forward_directed ? data.forward : data.backward);
             if (edge_is_forward_directed)
@@ -720,89 +556,17 @@ class AlternativeRouting final
 
     // conduct T-Test
     bool ViaNodeCandidatePassesTTest(const DataFacadeT &facade,
-                                     QueryHeap &existing_forward_heap,
-                                     QueryHeap &existing_reverse_heap,
-                                     QueryHeap &new_forward_heap,
-                                     QueryHeap &new_reverse_heap,
-                                     const RankedCandidateNode &candidate,
+                                     const std::vector<NodeID> &packed_s_v_path,
+                                     const std::vector<NodeID> &packed_v_t_path,
                                      const int length_of_shortest_path,
-                                     int *length_of_via_path,
-                                     NodeID *s_v_middle,
-                                     NodeID *v_t_middle,
                                      const EdgeWeight min_edge_offset) const
     {
-        new_forward_heap.Clear();
-        new_reverse_heap.Clear();
-        std::vector<NodeID> packed_s_v_path;
-        std::vector<NodeID> packed_v_t_path;
-
-        *s_v_middle = SPECIAL_NODEID;
-        int upper_bound_s_v_path_length = INVALID_EDGE_WEIGHT;
-        // compute path <s,..,v> by reusing forward search from s
-        new_reverse_heap.Insert(candidate.node, 0, candidate.node);
+        BOOST_ASSERT(!packed_s_v_path.empty() && !packed_v_t_path.empty());
+        BOOST_ASSERT(packed_s_v_path.back() == packed_v_t_path.front());
+        NodeID s_P = packed_s_v_path.back(), t_P = packed_v_t_path.front();
         const bool constexpr STALLING_ENABLED = true;
         const bool constexpr DO_NOT_FORCE_LOOPS = false;
-        while (new_reverse_heap.Size() > 0)
-        {
-            super::RoutingStep(facade,
-                               new_reverse_heap,
-                               existing_forward_heap,
-                               *s_v_middle,
-                               upper_bound_s_v_path_length,
-                               min_edge_offset,
-                               false,
-                               STALLING_ENABLED,
-                               DO_NOT_FORCE_LOOPS,
-                               DO_NOT_FORCE_LOOPS);
-        }
 
-        if (INVALID_EDGE_WEIGHT == upper_bound_s_v_path_length)
-        {
-            return false;
-        }
-
-        // compute path <v,..,t> by reusing backward search from t
-        *v_t_middle = SPECIAL_NODEID;
-        int upper_bound_of_v_t_path_length = INVALID_EDGE_WEIGHT;
-        new_forward_heap.Insert(candidate.node, 0, candidate.node);
-        while (new_forward_heap.Size() > 0)
-        {
-            super::RoutingStep(facade,
-                               new_forward_heap,
-                               existing_reverse_heap,
-                               *v_t_middle,
-                               upper_bound_of_v_t_path_length,
-                               min_edge_offset,
-                               true,
-                               STALLING_ENABLED,
-                               DO_NOT_FORCE_LOOPS,
-                               DO_NOT_FORCE_LOOPS);
-        }
-
-        if (INVALID_EDGE_WEIGHT == upper_bound_of_v_t_path_length)
-        {
-            return false;
-        }
-
-        *length_of_via_path = upper_bound_s_v_path_length + upper_bound_of_v_t_path_length;
-
-        // retrieve packed paths
-        super::RetrievePackedPathFromHeap(
-            existing_forward_heap, new_reverse_heap, *s_v_middle, packed_s_v_path);
-
-        super::RetrievePackedPathFromHeap(
-            new_forward_heap, existing_reverse_heap, *v_t_middle, packed_v_t_path);
-
-        NodeID s_P = *s_v_middle, t_P = *v_t_middle;
-        if (SPECIAL_NODEID == s_P)
-        {
-            return false;
-        }
-
-        if (SPECIAL_NODEID == t_P)
-        {
-            return false;
-        }
         const int T_threshold = static_cast<int>(VIAPATH_EPSILON * length_of_shortest_path);
         int unpacked_until_weight = 0;
 
@@ -812,7 +576,7 @@ class AlternativeRouting final
         {
             const EdgeID current_edge_id =
                 facade.FindEdgeInEitherDirection(packed_s_v_path[i - 1], packed_s_v_path[i]);
-            const int length_of_current_edge = facade.GetEdgeData(current_edge_id).weight;
+            const int length_of_current_edge = facade.GetSearchEdgeData(current_edge_id).weight;
             if ((length_of_current_edge + unpacked_until_weight) >= T_threshold)
             {
                 unpack_stack.emplace(packed_s_v_path[i - 1], packed_s_v_path[i]);
@@ -843,7 +607,8 @@ class AlternativeRouting final
                 const NodeID via_path_middle_node_id = current_edge_data.id;
                 const EdgeID second_segment_edge_id =
                     facade.FindEdgeInEitherDirection(via_path_middle_node_id, via_path_edge.second);
-                const int second_segment_length = facade.GetEdgeData(second_segment_edge_id).weight;
+                const int second_segment_length =
+                    facade.GetSearchEdgeData(second_segment_edge_id).weight;
                 // attention: !unpacking in reverse!
                 // Check if second segment is the one to go over treshold? if yes add second segment
                 // to stack, else push first segment to stack and add weight of second one.
@@ -875,7 +640,7 @@ class AlternativeRouting final
         {
             const EdgeID edgeID =
                 facade.FindEdgeInEitherDirection(packed_v_t_path[i], packed_v_t_path[i + 1]);
-            int length_of_current_edge = facade.GetEdgeData(edgeID).weight;
+            int length_of_current_edge = facade.GetSearchEdgeData(edgeID).weight;
             if (length_of_current_edge + unpacked_until_weight >= T_threshold)
             {
                 unpack_stack.emplace(packed_v_t_path[i], packed_v_t_path[i + 1]);
@@ -905,7 +670,7 @@ class AlternativeRouting final
                 const NodeID middleOfViaPath = current_edge_data.id;
                 EdgeID edgeIDOfFirstSegment =
                     facade.FindEdgeInEitherDirection(via_path_edge.first, middleOfViaPath);
-                int lengthOfFirstSegment = facade.GetEdgeData(edgeIDOfFirstSegment).weight;
+                int lengthOfFirstSegment = facade.GetSearchEdgeData(edgeIDOfFirstSegment).weight;
                 // Check if first segment is the one to go over treshold? if yes first segment to
                 // stack, else push second segment to stack and add weight of first one.
                 if (unpacked_until_weight + lengthOfFirstSegment >= T_threshold)
@@ -1,15 +1,21 @@
 #ifndef MANY_TO_MANY_ROUTING_HPP
 #define MANY_TO_MANY_ROUTING_HPP
 
+#include "engine/routing_algorithms/many_to_many_buckets.hpp"
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
+#include "util/integer_range.hpp"
 #include "util/typedefs.hpp"
 
 #include <boost/assert.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
 #include <limits>
 #include <memory>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -19,26 +25,17 @@ namespace engine
 namespace routing_algorithms
 {
 
-template <class DataFacadeT>
+// The bucket store is a template parameter only so table-bench can compare implementations
+template <class DataFacadeT, class BucketStoreT = SortedBucketStore>
 class ManyToManyRouting final
-    : public BasicRoutingInterface<DataFacadeT, ManyToManyRouting<DataFacadeT>>
+    : public BasicRoutingInterface<DataFacadeT, ManyToManyRouting<DataFacadeT, BucketStoreT>>
 {
-    using super = BasicRoutingInterface<DataFacadeT, ManyToManyRouting<DataFacadeT>>;
-    using QueryHeap = SearchEngineData::QueryHeap;
+    using super = BasicRoutingInterface<DataFacadeT, ManyToManyRouting<DataFacadeT, BucketStoreT>>;
+    using QueryHeap = SearchEngineData::ManyToManyQueryHeap;
     SearchEngineData &engine_working_data;
 
-    struct NodeBucket
-    {
-        unsigned target_id; // essentially a row in the weight matrix
-        EdgeWeight weight;
-        NodeBucket(const unsigned target_id, const EdgeWeight weight)
-            : target_id(target_id), weight(weight)
-        {
-        }
-    };
-
-    // FIXME This should be replaced by an std::unordered_multimap, though this needs benchmarking
-    using SearchSpaceWithBuckets = std::unordered_map<NodeID, std::vector<NodeBucket>>;
+    // Built once after all backward searches are done, so the forward searches do not allocate.
+    using SearchSpaceWithBuckets = BucketStoreT;
 
   public:
     ManyToManyRouting(SearchEngineData &engine_working_data)
@@ -50,152 +47,272 @@ class ManyToManyRouting final
                                        const std::vector<PhantomNode> &phantom_nodes,
                                        const std::vector<std::size_t> &source_indices,
                                        const std::vector<std::size_t> &target_indices) const
+    {
+        return operator()(facade, phantom_nodes, source_indices, target_indices, false).first;
+    }
+
+    // Computes the duration table and, if requested, the length in meters of the same shortest
+    // paths. Distances are obtained by unpacking the path over the middle node of every entry,
+    // unreachable entries are INVALID_EDGE_WEIGHT and std::numeric_limits<double>::max().
+    // Entries with a duration of at least weight_upper_bound are unreachable as well, which lets
+    // all searches stop as soon as their heaps exceed the bound.
+    std::pair<std::vector<EdgeWeight>, std::vector<double>>
+    operator()(const DataFacadeT &facade,
+               const std::vector<PhantomNode> &phantom_nodes,
+               const std::vector<std::size_t> &source_indices,
+               const std::vector<std::size_t> &target_indices,
+               const bool calculate_distance,
+               const EdgeWeight weight_upper_bound = INVALID_EDGE_WEIGHT) const
     {
         const auto number_of_sources =
             source_indices.empty() ? phantom_nodes.size() : source_indices.size();
         const auto number_of_targets =
             target_indices.empty() ? phantom_nodes.size() : target_indices.size();
         const auto number_of_entries = number_of_sources * number_of_targets;
-        std::vector<EdgeWeight> result_table(number_of_entries,
-                                             std::numeric_limits<EdgeWeight>::max());
+        // only weights below the bound are accepted as entries
+        std::vector<EdgeWeight> result_table(number_of_entries, weight_upper_bound);
+        std::vector<NodeID> middle_nodes_table(number_of_entries, SPECIAL_NODEID);
+        std::vector<double> distance_table;
+        if (calculate_distance)
+        {
+            distance_table.resize(number_of_entries, std::numeric_limits<double>::max());
+        }
 
-        engine_working_data.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes());
+        const auto get_source_phantom = [&](const std::size_t row_idx) -> const PhantomNode & {
+            return source_indices.empty() ? phantom_nodes[row_idx]
+                                          : phantom_nodes[source_indices[row_idx]];
+        };
+        const auto get_target_phantom = [&](const std::size_t column_idx) -> const PhantomNode & {
+            return target_indices.empty() ? phantom_nodes[column_idx]
+                                          : phantom_nodes[target_indices[column_idx]];
+        };
 
-        QueryHeap &query_heap = *(engine_working_data.forward_heap_1);
+        // Sources start at the negative offset of their phantom nodes, so the backward searches
+        // have to go beyond the bound by the largest of these offsets.
+        EdgeWeight backward_upper_bound = weight_upper_bound;
+        if (weight_upper_bound != INVALID_EDGE_WEIGHT)
+        {
+            EdgeWeight max_source_offset = 0;
+            for (const auto row_idx : util::irange<std::size_t>(0, number_of_sources))
+            {
+                const auto &phantom = get_source_phantom(row_idx);
+                if (phantom.forward_segment_id.enabled)
+                {
+                    max_source_offset =
+                        std::max(max_source_offset, phantom.GetForwardWeightPlusOffset());
+                }
+                if (phantom.reverse_segment_id.enabled)
+                {
+                    max_source_offset =
+                        std::max(max_source_offset, phantom.GetReverseWeightPlusOffset());
+                }
+            }
+            backward_upper_bound =
+                max_source_offset < INVALID_EDGE_WEIGHT - weight_upper_bound
+                    ? weight_upper_bound + max_source_offset
+                    : INVALID_EDGE_WEIGHT;
+        }
 
-        SearchSpaceWithBuckets search_space_with_buckets;
+        // Every backward search records its settled nodes separately, so the searches can run
+        // on different threads. Each thread uses its own thread-local heap.
+        std::vector<std::vector<NodeBucket>> target_search_spaces(number_of_targets);
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, number_of_targets),
+            [&](const tbb::blocked_range<std::size_t> &range) {
+                engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+                    facade.GetNumberOfNodes());
+                QueryHeap &query_heap = *(engine_working_data.many_to_many_heap);
+
+                for (auto column_idx = range.begin(); column_idx != range.end(); ++column_idx)
+                {
+                    const auto &phantom = get_target_phantom(column_idx);
+                    query_heap.Clear();
+                    // insert target(s) at weight 0
 
-        unsigned column_idx = 0;
-        const auto search_target_phantom = [&](const PhantomNode &phantom) {
-            query_heap.Clear();
-            // insert target(s) at weight 0
+                    if (phantom.forward_segment_id.enabled)
+                    {
+                        query_heap.Insert(phantom.forward_segment_id.id,
+                                          phantom.GetForwardWeightPlusOffset(),
+                                          phantom.forward_segment_id.id);
+                    }
+                    if (phantom.reverse_segment_id.enabled)
+                    {
+                        query_heap.Insert(phantom.reverse_segment_id.id,
+                                          phantom.GetReverseWeightPlusOffset(),
+                                          phantom.reverse_segment_id.id);
+                    }
 
-            if (phantom.forward_segment_id.enabled)
-            {
-                query_heap.Insert(phantom.forward_segment_id.id,
-                                  phantom.GetForwardWeightPlusOffset(),
-                                  phantom.forward_segment_id.id);
-            }
-            if (phantom.reverse_segment_id.enabled)
-            {
-                query_heap.Insert(phantom.reverse_segment_id.id,
-                                  phantom.GetReverseWeightPlusOffset(),
-                                  phantom.reverse_segment_id.id);
-            }
+                    // explore search space
+                    auto &search_space = target_search_spaces[column_idx];
+                    while (!query_heap.Empty() && query_heap.MinKey() < backward_upper_bound)
+                    {
+                        BackwardRoutingStep(facade, column_idx, query_heap, search_space);
+                    }
+                }
+            });
+
+        // build the bucket store, the forward searches only read from it
+        const SearchSpaceWithBuckets search_space_with_buckets(target_search_spaces);
+        target_search_spaces.clear();
+
+        // for each source do forward search, every row of the result table is written by
+        // exactly one search and needs no synchronization
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, number_of_sources),
+            [&](const tbb::blocked_range<std::size_t> &range) {
+                engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+                    facade.GetNumberOfNodes());
+                QueryHeap &query_heap = *(engine_working_data.many_to_many_heap);
+
+                for (auto row_idx = range.begin(); row_idx != range.end(); ++row_idx)
+                {
+                    const auto &phantom = get_source_phantom(row_idx);
+                    query_heap.Clear();
+                    // insert target(s) at weight 0
 
-            // explore search space
-            while (!query_heap.Empty())
-            {
-                BackwardRoutingStep(facade, column_idx, query_heap, search_space_with_buckets);
-            }
-            ++column_idx;
-        };
+                    if (phantom.forward_segment_id.enabled)
+                    {
+                        query_heap.Insert(phantom.forward_segment_id.id,
+                                          -phantom.GetForwardWeightPlusOffset(),
+                                          phantom.forward_segment_id.id);
+                    }
+                    if (phantom.reverse_segment_id.enabled)
+                    {
+                        query_heap.Insert(phantom.reverse_segment_id.id,
+                                          -phantom.GetReverseWeightPlusOffset(),
+                                          phantom.reverse_segment_id.id);
+                    }
 
-        // for each source do forward search
-        unsigned row_idx = 0;
-        const auto search_source_phantom = [&](const PhantomNode &phantom) {
-            query_heap.Clear();
-            // insert target(s) at weight 0
+                    // explore search space, the weights of the targets are never negative
+                    while (!query_heap.Empty() && query_heap.MinKey() < weight_upper_bound)
+                    {
+                        ForwardRoutingStep(facade,
+                                           row_idx,
+                                           number_of_targets,
+                                           query_heap,
+                                           search_space_with_buckets,
+                                           result_table,
+                                           middle_nodes_table);
+                    }
 
-            if (phantom.forward_segment_id.enabled)
-            {
-                query_heap.Insert(phantom.forward_segment_id.id,
-                                  -phantom.GetForwardWeightPlusOffset(),
-                                  phantom.forward_segment_id.id);
-            }
-            if (phantom.reverse_segment_id.enabled)
-            {
-                query_heap.Insert(phantom.reverse_segment_id.id,
-                                  -phantom.GetReverseWeightPlusOffset(),
-                                  phantom.reverse_segment_id.id);
-            }
+                    if (weight_upper_bound != INVALID_EDGE_WEIGHT)
+                    {
+                        for (const auto column_idx :
+                             util::irange<std::size_t>(0, number_of_targets))
+                        {
+                            const auto entry_idx = row_idx * number_of_targets + column_idx;
+                            if (middle_nodes_table[entry_idx] == SPECIAL_NODEID)
+                            {
+                                result_table[entry_idx] = INVALID_EDGE_WEIGHT;
+                            }
+                        }
+                    }
 
-            // explore search space
-            while (!query_heap.Empty())
-            {
-                ForwardRoutingStep(facade,
-                                   row_idx,
-                                   number_of_targets,
-                                   query_heap,
-                                   search_space_with_buckets,
-                                   result_table);
-            }
-            ++row_idx;
+                    // the search tree of the source is still in the heap, unpack the row now
+                    if (calculate_distance)
+                    {
+                        for (const auto column_idx :
+                             util::irange<std::size_t>(0, number_of_targets))
+                        {
+                            const auto entry_idx = row_idx * number_of_targets + column_idx;
+                            if (middle_nodes_table[entry_idx] == SPECIAL_NODEID)
+                            {
+                                continue;
+                            }
+
+                            const auto packed_path =
+                                RetrievePackedPath(query_heap,
+                                                   search_space_with_buckets,
+                                                   middle_nodes_table[entry_idx],
+                                                   column_idx,
+                                                   result_table[entry_idx]);
+                            distance_table[entry_idx] =
+                                super::GetPathDistance(facade,
+                                                       packed_path,
+                                                       phantom,
+                                                       get_target_phantom(column_idx));
+                        }
+                    }
+                }
+            });
+
+        return std::make_pair(std::move(result_table), std::move(distance_table));
+    }
+
+    // Assembles the packed path of a table entry from the forward search heap of its source and
+    // the parents stored in the buckets of its target column.
+    std::vector<NodeID> RetrievePackedPath(const QueryHeap &forward_heap,
+                                           const SearchSpaceWithBuckets &search_space_with_buckets,
+                                           const NodeID middle_node,
+                                           const unsigned column_idx,
+                                           const EdgeWeight weight) const
+    {
+        std::vector<NodeID> packed_path;
+
+        const auto find_bucket = [&](const NodeID node) -> const NodeBucket & {
+            return FindBucket(search_space_with_buckets, node, column_idx);
         };
 
-        if (target_indices.empty())
+        // a self loop at the middle node makes up the full path
+        if (weight != forward_heap.GetKey(middle_node) + find_bucket(middle_node).weight)
         {
-            for (const auto &phantom : phantom_nodes)
-            {
-                search_target_phantom(phantom);
-            }
-        }
-        else
-        {
-            for (const auto index : target_indices)
-            {
-                const auto &phantom = phantom_nodes[index];
-                search_target_phantom(phantom);
-            }
+            packed_path.push_back(middle_node);
+            packed_path.push_back(middle_node);
+            return packed_path;
         }
 
-        if (source_indices.empty())
-        {
-            for (const auto &phantom : phantom_nodes)
-            {
-                search_source_phantom(phantom);
-            }
-        }
-        else
+        super::RetrievePackedPathFromSingleHeap(forward_heap, middle_node, packed_path);
+        std::reverse(packed_path.begin(), packed_path.end());
+        packed_path.push_back(middle_node);
+
+        // all initial nodes of the backward search have themselves as parent
+        const NodeBucket *bucket = &find_bucket(middle_node);
+        while (bucket->parent_node != bucket->middle_node)
         {
-            for (const auto index : source_indices)
-            {
-                const auto &phantom = phantom_nodes[index];
-                search_source_phantom(phantom);
-            }
+            packed_path.push_back(bucket->parent_node);
+            bucket = &find_bucket(bucket->parent_node);
         }
 
-        return result_table;
+        return packed_path;
     }
 
     void ForwardRoutingStep(const DataFacadeT &facade,
-                            const unsigned row_idx,
-                            const unsigned number_of_targets,
+                            const std::size_t row_idx,
+                            const std::size_t number_of_targets,
                             QueryHeap &query_heap,
                             const SearchSpaceWithBuckets &search_space_with_buckets,
-                            std::vector<EdgeWeight> &result_table) const
+                            std::vector<EdgeWeight> &result_table,
+                            std::vector<NodeID> &middle_nodes_table) const
     {
         const NodeID node = query_heap.DeleteMin();
         const int source_weight = query_heap.GetKey(node);
 
-        // check if each encountered node has an entry
-        const auto bucket_iterator = search_space_with_buckets.find(node);
-        // iterate bucket if there exists one
-        if (bucket_iterator != search_space_with_buckets.end())
+        // iterate the buckets of the node, the range is empty if it has none
+        for (const NodeBucket &current_bucket : search_space_with_buckets.GetBuckets(node))
         {
-            const std::vector<NodeBucket> &bucket_list = bucket_iterator->second;
-            for (const NodeBucket &current_bucket : bucket_list)
+            // get target id from bucket entry
+            const unsigned column_idx = current_bucket.column_idx;
+            const int target_weight = current_bucket.weight;
+            const auto entry_idx = row_idx * number_of_targets + column_idx;
+            auto &current_weight = result_table[entry_idx];
+            // check if new weight is better
+            const EdgeWeight new_weight = source_weight + target_weight;
+            if (new_weight < 0)
             {
-                // get target id from bucket entry
-                const unsigned column_idx = current_bucket.target_id;
-                const int target_weight = current_bucket.weight;
-                auto &current_weight = result_table[row_idx * number_of_targets + column_idx];
-                // check if new weight is better
-                const EdgeWeight new_weight = source_weight + target_weight;
-                if (new_weight < 0)
+                const EdgeWeight loop_weight = super::GetLoopWeight(facade, node);
+                const int new_weight_with_loop = new_weight + loop_weight;
+                if (loop_weight != INVALID_EDGE_WEIGHT && new_weight_with_loop >= 0 &&
+                    new_weight_with_loop < current_weight)
                 {
-                    const EdgeWeight loop_weight = super::GetLoopWeight(facade, node);
-                    const int new_weight_with_loop = new_weight + loop_weight;
-                    if (loop_weight != INVALID_EDGE_WEIGHT && new_weight_with_loop >= 0)
-                    {
-                        current_weight = std::min(current_weight, new_weight_with_loop);
-                    }
-                }
-                else if (new_weight < current_weight)
-                {
-                    result_table[row_idx * number_of_targets + column_idx] = new_weight;
+                    current_weight = new_weight_with_loop;
+                    middle_nodes_table[entry_idx] = node;
                 }
             }
+            else if (new_weight < current_weight)
+            {
+                current_weight = new_weight;
+                middle_nodes_table[entry_idx] = node;
+            }
         }
         if (StallAtNode<true>(facade, node, source_weight, query_heap))
         {
@@ -207,13 +324,14 @@ class ManyToManyRouting final
     void BackwardRoutingStep(const DataFacadeT &facade,
                              const unsigned column_idx,
                              QueryHeap &query_heap,
-                             SearchSpaceWithBuckets &search_space_with_buckets) const
+                             std::vector<NodeBucket> &search_space) const
     {
         const NodeID node = query_heap.DeleteMin();
         const int target_weight = query_heap.GetKey(node);
 
-        // store settled nodes in search space bucket
-        search_space_with_buckets[node].emplace_back(column_idx, target_weight);
+        // store settled nodes, they are moved into the buckets once all searches are done
+        search_space.emplace_back(
+            node, query_heap.GetData(node).parent, column_idx, target_weight);
 
         if (StallAtNode<false>(facade, node, target_weight, query_heap))
         {
@@ -231,7 +349,7 @@ class ManyToManyRouting final
     {
         for (auto edge : facade.GetAdjacentEdgeRange(node))
         {
-            const auto &data = facade.GetEdgeData(edge);
+            const auto &data = facade.GetSearchEdgeData(edge);
             const bool direction_flag = (forward_direction ? data.forward : data.backward);
             if (direction_flag)
             {
@@ -266,7 +384,7 @@ class ManyToManyRouting final
     {
         for (auto edge : facade.GetAdjacentEdgeRange(node))
         {
-            const auto &data = facade.GetEdgeData(edge);
+            const auto &data = facade.GetSearchEdgeData(edge);
             const bool reverse_flag = ((!forward_direction) ? data.forward : data.backward);
             if (reverse_flag)
             {
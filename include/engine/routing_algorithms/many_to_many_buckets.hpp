@@ -0,0 +1,182 @@
+#ifndef MANY_TO_MANY_BUCKETS_HPP
+#define MANY_TO_MANY_BUCKETS_HPP
+
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/range/iterator_range_core.hpp>
+
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace routing_algorithms
+{
+
+// Node settled by the backward search of a target column, the forward searches meet it there
+struct NodeBucket
+{
+    NodeID middle_node;
+    NodeID parent_node;  // parent in the backward search, used to unpack the path
+    unsigned column_idx; // essentially a column in the weight matrix
+    EdgeWeight weight;
+
+    NodeBucket(const NodeID middle_node,
+               const NodeID parent_node,
+               const unsigned column_idx,
+               const EdgeWeight weight)
+        : middle_node(middle_node), parent_node(parent_node), column_idx(column_idx),
+          weight(weight)
+    {
+    }
+
+    bool operator<(const NodeBucket &rhs) const
+    {
+        return std::tie(middle_node, column_idx) < std::tie(rhs.middle_node, rhs.column_idx);
+    }
+};
+
+using BucketRange = boost::iterator_range<std::vector<NodeBucket>::const_iterator>;
+
+inline std::size_t countBuckets(const std::vector<std::vector<NodeBucket>> &search_spaces)
+{
+    return std::accumulate(search_spaces.begin(),
+                           search_spaces.end(),
+                           std::size_t{0},
+                           [](const std::size_t sum, const std::vector<NodeBucket> &search_space) {
+                               return sum + search_space.size();
+                           });
+}
+
+// All buckets in one contiguous array sorted by middle node, the buckets of a node are found by
+// binary search. Building it only touches the buckets, so it does not depend on the size of the
+// graph.
+class SortedBucketStore
+{
+  public:
+    explicit SortedBucketStore(const std::vector<std::vector<NodeBucket>> &search_spaces)
+    {
+        buckets.reserve(countBuckets(search_spaces));
+        for (const auto &search_space : search_spaces)
+        {
+            buckets.insert(buckets.end(), search_space.begin(), search_space.end());
+        }
+        tbb::parallel_sort(buckets.begin(), buckets.end());
+    }
+
+    // buckets of the node ordered by column, empty if it has none
+    BucketRange GetBuckets(const NodeID node) const
+    {
+        const auto range =
+            std::equal_range(buckets.begin(), buckets.end(), node, MiddleNodeLess{});
+        return boost::make_iterator_range(range.first, range.second);
+    }
+
+  private:
+    struct MiddleNodeLess
+    {
+        bool operator()(const NodeBucket &bucket, const NodeID node) const
+        {
+            return bucket.middle_node < node;
+        }
+        bool operator()(const NodeID node, const NodeBucket &bucket) const
+        {
+            return node < bucket.middle_node;
+        }
+    };
+
+    std::vector<NodeBucket> buckets;
+};
+
+// All buckets in one contiguous array grouped by middle node. The settled nodes are numbered in
+// the order they are first seen and a hash map gives their number, so the offsets only cover the
+// settled nodes and not the id range of the graph. Building it is a counting sort instead of a
+// comparison sort, a lookup is a hash probe and two array reads. Kept to compare against
+// SortedBucketStore in table-bench.
+class IndexedBucketStore
+{
+  public:
+    explicit IndexedBucketStore(const std::vector<std::vector<NodeBucket>> &search_spaces)
+    {
+        const auto number_of_buckets = countBuckets(search_spaces);
+        node_indices.reserve(number_of_buckets);
+
+        // count the buckets of every node, then turn the counts into end offsets
+        offsets.assign(1, 0);
+        for (const auto &search_space : search_spaces)
+        {
+            for (const auto &bucket : search_space)
+            {
+                const auto inserted = node_indices.emplace(
+                    bucket.middle_node, static_cast<std::uint32_t>(offsets.size() - 1));
+                if (inserted.second)
+                {
+                    offsets.push_back(0);
+                }
+                ++offsets[inserted.first->second + 1];
+            }
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        // the search spaces are in column order, so the buckets of a node stay ordered by column
+        std::vector<std::uint32_t> insert_positions(offsets.begin(), offsets.end() - 1);
+        buckets.resize(number_of_buckets, NodeBucket{SPECIAL_NODEID, SPECIAL_NODEID, 0, 0});
+        for (const auto &search_space : search_spaces)
+        {
+            for (const auto &bucket : search_space)
+            {
+                buckets[insert_positions[node_indices.find(bucket.middle_node)->second]++] =
+                    bucket;
+            }
+        }
+    }
+
+    // buckets of the node ordered by column, empty if it has none
+    BucketRange GetBuckets(const NodeID node) const
+    {
+        const auto node_index = node_indices.find(node);
+        if (node_index == node_indices.end())
+        {
+            return boost::make_iterator_range(buckets.end(), buckets.end());
+        }
+        return boost::make_iterator_range(buckets.begin() + offsets[node_index->second],
+                                          buckets.begin() + offsets[node_index->second + 1]);
+    }
+
+  private:
+    std::unordered_map<NodeID, std::uint32_t> node_indices;
+    std::vector<std::uint32_t> offsets;
+    std::vector<NodeBucket> buckets;
+};
+
+// Bucket of the node in the given column, it has to exist
+template <typename BucketStoreT>
+const NodeBucket &
+FindBucket(const BucketStoreT &store, const NodeID node, const unsigned column_idx)
+{
+    const auto buckets = store.GetBuckets(node);
+    const auto bucket = std::lower_bound(buckets.begin(),
+                                         buckets.end(),
+                                         column_idx,
+                                         [](const NodeBucket &lhs, const unsigned rhs) {
+                                             return lhs.column_idx < rhs;
+                                         });
+    BOOST_ASSERT(bucket != buckets.end());
+    BOOST_ASSERT(bucket->middle_node == node && bucket->column_idx == column_idx);
+    return *bucket;
+}
+}
+}
+}
+
+#endif // MANY_TO_MANY_BUCKETS_HPP
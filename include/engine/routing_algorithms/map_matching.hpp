@@ -1,6 +1,7 @@
 #ifndef MAP_MATCHING_HPP
 #define MAP_MATCHING_HPP
 
+#include "engine/routing_algorithms/many_to_many.hpp"
 #include "engine/routing_algorithms/routing_base.hpp"
 
 #include "engine/map_matching/hidden_markov_model.hpp"
@@ -16,6 +17,8 @@
 #include <algorithm>
 #include <deque>
 #include <iomanip>
+#include <iterator>
+#include <limits>
 #include <numeric>
 #include <utility>
 #include <vector>
@@ -35,14 +38,29 @@ using SubMatchingList = std::vector<map_matching::SubMatching>;
 constexpr static const unsigned MAX_BROKEN_STATES = 10;
 static const constexpr double MATCHING_BETA = 10;
 constexpr static const double MAX_DISTANCE_DELTA = 2000.;
+// trace points an online matching keeps for the next call
+constexpr static const std::size_t ONLINE_MATCHING_POINTS = 2 * MAX_BROKEN_STATES;
+
+// Viterbi state of an online matching, carried from one call to the next so every call only
+// extends the model by the new trace points. It covers the last ONLINE_MATCHING_POINTS trace
+// points of the previous call, all indices are relative to the first of them.
+struct MatchingState
+{
+    map_matching::HiddenMarkovModelState model;
+    std::size_t breakage_begin = map_matching::INVALID_STATE;
+    std::vector<std::size_t> split_points;
+    std::vector<std::size_t> prev_unbroken_timestamps;
+
+    std::size_t NumberOfPoints() const { return model.NumberOfRows(); }
+};
 
 // implements a hidden markov model map matching algorithm
 template <class DataFacadeT>
 class MapMatching final : public BasicRoutingInterface<DataFacadeT, MapMatching<DataFacadeT>>
 {
     using super = BasicRoutingInterface<DataFacadeT, MapMatching<DataFacadeT>>;
-    using QueryHeap = SearchEngineData::QueryHeap;
     SearchEngineData &engine_working_data;
+    ManyToManyRouting<DataFacadeT> transition_routing;
     map_matching::EmissionLogProbability default_emission_log_probability;
     map_matching::TransitionLogProbability transition_log_probability;
     map_matching::MatchingConfidence confidence;
@@ -63,9 +81,103 @@ class MapMatching final : public BasicRoutingInterface<DataFacadeT, MapMatching<
         return *median;
     }
 
+    // Computes the network distances from all candidates of the previous timestamp that are not
+    // pruned to all candidates of the current one with a single many-to-many search. Pairs
+    // that are not connected within duration_upper_bound get std::numeric_limits<double>::max().
+    std::vector<double> GetTransitionDistances(const DataFacadeT &facade,
+                                               const CandidateList &prev_candidates,
+                                               const std::vector<bool> &prev_pruned,
+                                               const CandidateList &current_candidates,
+                                               const EdgeWeight duration_upper_bound) const
+    {
+        std::vector<double> distances(prev_candidates.size() * current_candidates.size(),
+                                      std::numeric_limits<double>::max());
+
+        std::vector<PhantomNode> phantom_nodes;
+        phantom_nodes.reserve(prev_candidates.size() + current_candidates.size());
+        std::vector<std::size_t> source_indices, target_indices;
+        for (const auto s : util::irange<std::size_t>(0UL, prev_candidates.size()))
+        {
+            if (!prev_pruned[s])
+            {
+                source_indices.push_back(phantom_nodes.size());
+                phantom_nodes.push_back(prev_candidates[s].phantom_node);
+            }
+        }
+        if (source_indices.empty())
+        {
+            return distances;
+        }
+        for (const auto &candidate : current_candidates)
+        {
+            target_indices.push_back(phantom_nodes.size());
+            phantom_nodes.push_back(candidate.phantom_node);
+        }
+
+        const bool constexpr CALCULATE_DISTANCE = true;
+        const auto table = transition_routing(facade,
+                                              phantom_nodes,
+                                              source_indices,
+                                              target_indices,
+                                              CALCULATE_DISTANCE,
+                                              duration_upper_bound);
+
+        // the rows of the table only cover the candidates that are not pruned
+        std::size_t row_idx = 0;
+        for (const auto s : util::irange<std::size_t>(0UL, prev_candidates.size()))
+        {
+            if (prev_pruned[s])
+            {
+                continue;
+            }
+            std::copy_n(table.second.begin() + row_idx * current_candidates.size(),
+                        current_candidates.size(),
+                        distances.begin() + s * current_candidates.size());
+            ++row_idx;
+        }
+        return distances;
+    }
+
+    // Keeps the last ONLINE_MATCHING_POINTS rows of the model for the next call. Unbroken points
+    // that are dropped can no longer be fallen back to when the following points break.
+    void SaveState(const HMM &model,
+                   const std::size_t breakage_begin,
+                   const std::vector<std::size_t> &split_points,
+                   const std::vector<std::size_t> &prev_unbroken_timestamps,
+                   MatchingState &state) const
+    {
+        const auto number_of_points = model.breakage.size();
+        const auto first_kept =
+            number_of_points - std::min(number_of_points, ONLINE_MATCHING_POINTS);
+
+        model.Save(first_kept, state.model);
+
+        state.breakage_begin = breakage_begin == map_matching::INVALID_STATE
+                                   ? breakage_begin
+                                   : std::max(breakage_begin, first_kept) - first_kept;
+
+        state.split_points.clear();
+        for (const auto split_point : split_points)
+        {
+            if (split_point > first_kept)
+            {
+                state.split_points.push_back(split_point - first_kept);
+            }
+        }
+
+        state.prev_unbroken_timestamps.clear();
+        for (const auto timestamp : prev_unbroken_timestamps)
+        {
+            if (timestamp >= first_kept)
+            {
+                state.prev_unbroken_timestamps.push_back(timestamp - first_kept);
+            }
+        }
+    }
+
   public:
     MapMatching(SearchEngineData &engine_working_data, const double default_gps_precision)
-        : engine_working_data(engine_working_data),
+        : engine_working_data(engine_working_data), transition_routing(engine_working_data),
           default_emission_log_probability(default_gps_precision),
           transition_log_probability(MATCHING_BETA)
     {
@@ -77,6 +189,40 @@ class MapMatching final : public BasicRoutingInterface<DataFacadeT, MapMatching<
                const std::vector<util::Coordinate> &trace_coordinates,
                const std::vector<unsigned> &trace_timestamps,
                const std::vector<boost::optional<double>> &trace_gps_precision) const
+    {
+        return Match(facade,
+                     candidates_list,
+                     trace_coordinates,
+                     trace_timestamps,
+                     trace_gps_precision,
+                     nullptr);
+    }
+
+    // Online matching: the first state.NumberOfPoints() trace points are the ones kept from the
+    // previous call, only the transitions to the points following them are computed. On return
+    // the state covers the last points of this call.
+    SubMatchingList operator()(const DataFacadeT &facade,
+                               const CandidateLists &candidates_list,
+                               const std::vector<util::Coordinate> &trace_coordinates,
+                               const std::vector<unsigned> &trace_timestamps,
+                               const std::vector<boost::optional<double>> &trace_gps_precision,
+                               MatchingState &state) const
+    {
+        return Match(facade,
+                     candidates_list,
+                     trace_coordinates,
+                     trace_timestamps,
+                     trace_gps_precision,
+                     &state);
+    }
+
+  private:
+    SubMatchingList Match(const DataFacadeT &facade,
+                          const CandidateLists &candidates_list,
+                          const std::vector<util::Coordinate> &trace_coordinates,
+                          const std::vector<unsigned> &trace_timestamps,
+                          const std::vector<boost::optional<double>> &trace_gps_precision,
+                          MatchingState *state) const
     {
         SubMatchingList sub_matchings;
 
@@ -152,26 +298,48 @@ class MapMatching final : public BasicRoutingInterface<DataFacadeT, MapMatching<
 
         HMM model(candidates_list, emission_log_probabilities);
 
-        std::size_t initial_timestamp = model.initialize(0);
-        if (initial_timestamp == map_matching::INVALID_STATE)
-        {
-            return sub_matchings;
-        }
-
-        engine_working_data.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes());
-        engine_working_data.InitializeOrClearSecondThreadLocalStorage(facade.GetNumberOfNodes());
-
-        QueryHeap &forward_heap = *(engine_working_data.forward_heap_1);
-        QueryHeap &reverse_heap = *(engine_working_data.reverse_heap_1);
-        QueryHeap &forward_core_heap = *(engine_working_data.forward_heap_2);
-        QueryHeap &reverse_core_heap = *(engine_working_data.reverse_heap_2);
-
+        std::size_t initial_timestamp = map_matching::INVALID_STATE;
+        std::size_t first_timestamp = 0;
         std::size_t breakage_begin = map_matching::INVALID_STATE;
         std::vector<std::size_t> split_points;
         std::vector<std::size_t> prev_unbroken_timestamps;
         prev_unbroken_timestamps.reserve(candidates_list.size());
-        prev_unbroken_timestamps.push_back(initial_timestamp);
-        for (auto t = initial_timestamp + 1; t < candidates_list.size(); ++t)
+
+        // a state without unbroken points can not be extended, start over on all points then
+        if (state != nullptr && !state->prev_unbroken_timestamps.empty())
+        {
+            BOOST_ASSERT(state->NumberOfPoints() <= candidates_list.size());
+            model.Restore(state->model);
+            initial_timestamp = std::distance(
+                model.breakage.begin(),
+                std::find(model.breakage.begin(), model.breakage.end(), false));
+            first_timestamp = state->NumberOfPoints();
+            breakage_begin = state->breakage_begin;
+            // sub matchings that ended before the points kept are not reconstructed again
+            std::copy_if(state->split_points.begin(),
+                         state->split_points.end(),
+                         std::back_inserter(split_points),
+                         [&](const std::size_t split_point) {
+                             return split_point > initial_timestamp;
+                         });
+            prev_unbroken_timestamps = state->prev_unbroken_timestamps;
+        }
+        else
+        {
+            initial_timestamp = model.initialize(0);
+            if (initial_timestamp == map_matching::INVALID_STATE)
+            {
+                if (state != nullptr)
+                {
+                    *state = MatchingState{};
+                }
+                return sub_matchings;
+            }
+            first_timestamp = initial_timestamp + 1;
+            prev_unbroken_timestamps.push_back(initial_timestamp);
+        }
+
+        for (auto t = first_timestamp; t < candidates_list.size(); ++t)
         {
 
             const bool gap_in_trace = [&, use_timestamps]() {
@@ -211,7 +379,15 @@ class MapMatching final : public BasicRoutingInterface<DataFacadeT, MapMatching<
                 const int duration_upper_bound =
                     ((haversine_distance + max_distance_delta) * 0.25) * 10;
 
-                // compute d_t for this timestamp and the next one
+                // compute d_t for this timestamp and the next one, all network distances come
+                // from one many-to-many search instead of a query per pair of candidates
+                const auto network_distances =
+                    GetTransitionDistances(facade,
+                                           prev_unbroken_timestamps_list,
+                                           prev_pruned,
+                                           current_timestamps_list,
+                                           duration_upper_bound);
+
                 for (const auto s : util::irange<std::size_t>(0UL, prev_viterbi.size()))
                 {
                     if (prev_pruned[s])
@@ -229,33 +405,8 @@ class MapMatching final : public BasicRoutingInterface<DataFacadeT, MapMatching<
                             continue;
                         }
 
-                        forward_heap.Clear();
-                        reverse_heap.Clear();
-
-                        double network_distance;
-                        if (facade.GetCoreSize() > 0)
-                        {
-                            forward_core_heap.Clear();
-                            reverse_core_heap.Clear();
-                            network_distance = super::GetNetworkDistanceWithCore(
-                                facade,
-                                forward_heap,
-                                reverse_heap,
-                                forward_core_heap,
-                                reverse_core_heap,
-                                prev_unbroken_timestamps_list[s].phantom_node,
-                                current_timestamps_list[s_prime].phantom_node,
-                                duration_upper_bound);
-                        }
-                        else
-                        {
-                            network_distance = super::GetNetworkDistance(
-                                facade,
-                                forward_heap,
-                                reverse_heap,
-                                prev_unbroken_timestamps_list[s].phantom_node,
-                                current_timestamps_list[s_prime].phantom_node);
-                        }
+                        const double network_distance =
+                            network_distances[s * current_viterbi.size() + s_prime];
 
                         // get distance diff between loc1/2 and locs/s_prime
                         const auto d_t = std::abs(network_distance - haversine_distance);
@@ -331,6 +482,11 @@ class MapMatching final : public BasicRoutingInterface<DataFacadeT, MapMatching<
             }
         }
 
+        if (state != nullptr)
+        {
+            SaveState(model, breakage_begin, split_points, prev_unbroken_timestamps, *state);
+        }
+
         if (!prev_unbroken_timestamps.empty())
         {
             split_points.push_back(prev_unbroken_timestamps.back() + 1);
@@ -33,6 +33,7 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
 {
   private:
     using EdgeData = typename DataFacadeT::EdgeData;
+    using SearchEdgeData = typename DataFacadeT::SearchEdgeData;
 
   public:
     /*
@@ -93,7 +94,7 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
                     // check whether there is a loop present at the node
                     for (const auto edge : facade.GetAdjacentEdgeRange(node))
                     {
-                        const EdgeData &data = facade.GetEdgeData(edge);
+                        const SearchEdgeData &data = facade.GetSearchEdgeData(edge);
                         bool forward_directionFlag =
                             (forward_direction ? data.forward : data.backward);
                         if (forward_directionFlag)
@@ -136,7 +137,7 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
         {
             for (const auto edge : facade.GetAdjacentEdgeRange(node))
             {
-                const EdgeData &data = facade.GetEdgeData(edge);
+                const SearchEdgeData &data = facade.GetSearchEdgeData(edge);
                 const bool reverse_flag = ((!forward_direction) ? data.forward : data.backward);
                 if (reverse_flag)
                 {
@@ -158,7 +159,7 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
 
         for (const auto edge : facade.GetAdjacentEdgeRange(node))
         {
-            const EdgeData &data = facade.GetEdgeData(edge);
+            const SearchEdgeData &data = facade.GetSearchEdgeData(edge);
             bool forward_directionFlag = (forward_direction ? data.forward : data.backward);
             if (forward_directionFlag)
             {
@@ -189,7 +190,7 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
         EdgeWeight loop_weight = INVALID_EDGE_WEIGHT;
         for (auto edge : facade.GetAdjacentEdgeRange(node))
         {
-            const auto &data = facade.GetEdgeData(edge);
+            const auto &data = facade.GetSearchEdgeData(edge);
             if (data.forward)
             {
                 const NodeID to = facade.GetTarget(edge);
@@ -450,7 +451,8 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
         RetrievePackedPathFromSingleHeap(reverse_heap, middle_node_id, packed_path);
     }
 
-    void RetrievePackedPathFromSingleHeap(const SearchEngineData::QueryHeap &search_heap,
+    template <typename HeapT>
+    void RetrievePackedPathFromSingleHeap(const HeapT &search_heap,
                                           const NodeID middle_node_id,
                                           std::vector<NodeID> &packed_path) const
     {
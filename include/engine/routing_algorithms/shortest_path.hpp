@@ -396,7 +396,7 @@ class ShortestPathRouting final
                 (INVALID_EDGE_WEIGHT == new_total_weight_to_reverse))
             {
                 raw_route_data.shortest_path_length = INVALID_EDGE_WEIGHT;
-                raw_route_data.alternative_path_length = INVALID_EDGE_WEIGHT;
+                raw_route_data.alternative_path_lengths.clear();
                 return;
             }
 
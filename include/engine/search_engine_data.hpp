@@ -19,22 +19,45 @@ struct HeapData
 
 struct SearchEngineData
 {
-    using QueryHeap =
-        util::BinaryHeap<NodeID, NodeID, int, HeapData, util::UnorderedMapStorage<NodeID, int>>;
+    // Number of children per node of the heaps. A 4-ary heap only pays off for searches that
+    // settle far more nodes than a CH search does, compare them with heap-bench before changing.
+    static const constexpr unsigned QUERY_HEAP_ARITY = 2;
+    static const constexpr unsigned MANY_TO_MANY_HEAP_ARITY = 2;
+
+    using QueryHeap = util::DAryHeap<NodeID,
+                                     NodeID,
+                                     int,
+                                     HeapData,
+                                     util::UnorderedMapStorage<NodeID, int>,
+                                     QUERY_HEAP_ARITY>;
     using SearchEngineHeapPtr = boost::thread_specific_ptr<QueryHeap>;
 
+    // The many-to-many searches run many times per request on every worker thread, so they
+    // index the heap with an array over all nodes that is cleared in constant time instead of
+    // hashing node ids.
+    using ManyToManyQueryHeap = util::DAryHeap<NodeID,
+                                               NodeID,
+                                               int,
+                                               HeapData,
+                                               util::TimestampedArrayStorage<NodeID, int>,
+                                               MANY_TO_MANY_HEAP_ARITY>;
+    using ManyToManyHeapPtr = boost::thread_specific_ptr<ManyToManyQueryHeap>;
+
     static SearchEngineHeapPtr forward_heap_1;
     static SearchEngineHeapPtr reverse_heap_1;
     static SearchEngineHeapPtr forward_heap_2;
     static SearchEngineHeapPtr reverse_heap_2;
     static SearchEngineHeapPtr forward_heap_3;
     static SearchEngineHeapPtr reverse_heap_3;
+    static ManyToManyHeapPtr many_to_many_heap;
 
     void InitializeOrClearFirstThreadLocalStorage(const unsigned number_of_nodes);
 
     void InitializeOrClearSecondThreadLocalStorage(const unsigned number_of_nodes);
 
     void InitializeOrClearThirdThreadLocalStorage(const unsigned number_of_nodes);
+
+    void InitializeOrClearManyToManyThreadLocalStorage(const unsigned number_of_nodes);
 };
 }
 }
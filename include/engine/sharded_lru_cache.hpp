@@ -0,0 +1,206 @@
+#ifndef ENGINE_SHARDED_LRU_CACHE_HPP
+#define ENGINE_SHARDED_LRU_CACHE_HPP
+
+#include "engine/cache_statistics.hpp"
+#include "util/simple_logger.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Every entry counts as one towards the capacity
+template <typename ValueT> struct UnitEntrySize
+{
+    std::size_t operator()(const ValueT &) const { return 1; }
+};
+
+/**
+ * Least recently used cache shared by concurrent requests, see SnappingCache and TileCache.
+ *
+ * The cache is split into shards, each with its own lock and least recently used order, so
+ * requests running in parallel rarely wait on each other. The capacity is the sum of the sizes of
+ * all entries as returned by EntrySizeT, split evenly over the shards.
+ *
+ * Every lookup passes the timestamp of the dataset it runs on, see
+ * BaseDataFacade::GetDatasetTimestamp. Once a newer dataset is seen the entries of the old one are
+ * dropped, requests still running on an older dataset bypass the cache.
+ */
+template <typename KeyT,
+          typename ValueT,
+          typename HashT = std::hash<KeyT>,
+          typename EqualT = std::equal_to<KeyT>,
+          typename EntrySizeT = UnitEntrySize<ValueT>>
+class ShardedLRUCache
+{
+  public:
+    using Statistics = CacheStatistics;
+
+    // The name is used to log the statistics on destruction
+    ShardedLRUCache(std::string name, const std::size_t capacity)
+        : name(std::move(name)),
+          shard_capacity(
+              std::max<std::size_t>(1, (capacity + NUMBER_OF_SHARDS - 1) / NUMBER_OF_SHARDS)),
+          hits(0), misses(0), evictions(0)
+    {
+    }
+
+    ~ShardedLRUCache()
+    {
+        const auto statistics = GetStatistics();
+        util::SimpleLogger().Write() << name << ": " << statistics.hits << " hits, "
+                                     << statistics.misses << " misses (" << std::fixed
+                                     << std::setprecision(1) << 100. * statistics.HitRate()
+                                     << "%), " << statistics.evictions << " evictions";
+    }
+
+    ShardedLRUCache(const ShardedLRUCache &) = delete;
+    ShardedLRUCache &operator=(const ShardedLRUCache &) = delete;
+
+    // Returns true and sets value if the key was inserted on this dataset before
+    bool Find(const unsigned dataset_timestamp, const KeyT &key, ValueT &value)
+    {
+        auto &shard = GetShard(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (UpdateDataset(shard, dataset_timestamp))
+            {
+                const auto entry = shard.index.find(key);
+                if (entry != shard.index.end())
+                {
+                    shard.entries.splice(shard.entries.begin(), shard.entries, entry->second);
+                    value = entry->second->second;
+                    ++hits;
+                    return true;
+                }
+            }
+        }
+        ++misses;
+        return false;
+    }
+
+    // Entries larger than the capacity of a shard are not cached
+    void Insert(const unsigned dataset_timestamp, const KeyT &key, const ValueT &value)
+    {
+        const auto value_size = EntrySizeT()(value);
+        if (value_size > shard_capacity)
+        {
+            return;
+        }
+
+        auto &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!UpdateDataset(shard, dataset_timestamp))
+        {
+            return;
+        }
+
+        // another request could have computed the same value in the meantime
+        const auto entry = shard.index.find(key);
+        if (entry != shard.index.end())
+        {
+            shard.size -= EntrySizeT()(entry->second->second);
+            shard.entries.erase(entry->second);
+            shard.index.erase(entry);
+        }
+
+        while (shard.size + value_size > shard_capacity)
+        {
+            BOOST_ASSERT(!shard.entries.empty());
+            shard.size -= EntrySizeT()(shard.entries.back().second);
+            shard.index.erase(shard.entries.back().first);
+            shard.entries.pop_back();
+            ++evictions;
+        }
+        shard.entries.emplace_front(key, value);
+        shard.index.emplace(key, shard.entries.begin());
+        shard.size += value_size;
+    }
+
+    Statistics GetStatistics() const
+    {
+        std::size_t entries = 0;
+        std::size_t size = 0;
+        for (const auto &shard : shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            entries += shard.entries.size();
+            size += shard.size;
+        }
+        Statistics statistics;
+        statistics.hits = hits;
+        statistics.misses = misses;
+        statistics.evictions = evictions;
+        statistics.entries = entries;
+        statistics.size = size;
+        return statistics;
+    }
+
+  private:
+    struct Shard
+    {
+        using Entries = std::list<std::pair<KeyT, ValueT>>;
+
+        mutable std::mutex mutex;
+        unsigned dataset_timestamp = 0;
+        // sum of the sizes of the entries in the shard
+        std::size_t size = 0;
+        // most recently used first
+        Entries entries;
+        std::unordered_map<KeyT, typename Entries::iterator, HashT, EqualT> index;
+    };
+
+    static const constexpr std::size_t NUMBER_OF_SHARDS = 16;
+
+    Shard &GetShard(const KeyT &key)
+    {
+        // the low bits of the hash select the bucket in the shard, so use the high bits of a
+        // multiplicative hash of it here (std::hash of integers is the identity)
+        const std::uint64_t hash = HashT()(key) * 0x9E3779B97F4A7C15ull;
+        return shards[(hash >> 56) % NUMBER_OF_SHARDS];
+    }
+
+    // Drops the entries of older datasets, returns false if the shard is on a newer one already
+    bool UpdateDataset(Shard &shard, const unsigned dataset_timestamp)
+    {
+        if (dataset_timestamp < shard.dataset_timestamp)
+        {
+            return false;
+        }
+        if (dataset_timestamp > shard.dataset_timestamp)
+        {
+            shard.entries.clear();
+            shard.index.clear();
+            shard.size = 0;
+            shard.dataset_timestamp = dataset_timestamp;
+        }
+        return true;
+    }
+
+    const std::string name;
+    const std::size_t shard_capacity;
+    std::array<Shard, NUMBER_OF_SHARDS> shards;
+
+    std::atomic<std::uint64_t> hits;
+    std::atomic<std::uint64_t> misses;
+    std::atomic<std::uint64_t> evictions;
+};
+}
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef ENGINE_SNAPPING_CACHE_HPP
+#define ENGINE_SNAPPING_CACHE_HPP
+
+#include "engine/bearing.hpp"
+#include "engine/phantom_node.hpp"
+#include "engine/sharded_lru_cache.hpp"
+
+#include "util/coordinate.hpp"
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Snapping input of a coordinate, a cache hit returns exactly what snapping would have returned
+struct SnappingCacheKey
+{
+    SnappingCacheKey(const util::Coordinate coordinate,
+                     const boost::optional<double> &radius,
+                     const boost::optional<Bearing> &bearing);
+
+    std::int32_t lon;
+    std::int32_t lat;
+    // negative if not set
+    double radius;
+    short bearing;
+    short bearing_range;
+};
+
+struct SnappingCacheKeyHash
+{
+    std::size_t operator()(const SnappingCacheKey &key) const;
+};
+
+struct SnappingCacheKeyEqual
+{
+    bool operator()(const SnappingCacheKey &lhs, const SnappingCacheKey &rhs) const;
+};
+
+/**
+ * Caches snapped coordinates across requests, for clients that send the same locations over and
+ * over. Entries are keyed by the fixed point input coordinate and the radius and bearing the
+ * coordinate was snapped with. The capacity is given in number of coordinates.
+ */
+class SnappingCache final : public ShardedLRUCache<SnappingCacheKey,
+                                                   PhantomNodePair,
+                                                   SnappingCacheKeyHash,
+                                                   SnappingCacheKeyEqual>
+{
+  public:
+    using Key = SnappingCacheKey;
+
+    explicit SnappingCache(const std::size_t capacity)
+        : ShardedLRUCache("snapping cache", capacity)
+    {
+    }
+};
+}
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef ENGINE_TILE_ARCHIVE_HPP
+#define ENGINE_TILE_ARCHIVE_HPP
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+namespace tile_archive
+{
+// The file starts with the header, followed by the data of all tiles and the index sorted by
+// tile. All numbers are stored in native byte order.
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    // of the .hsgr the tiles were rendered from, see BaseDataFacade::GetCheckSum
+    std::uint32_t checksum;
+    std::uint64_t number_of_tiles;
+    std::uint64_t index_offset;
+};
+
+struct IndexEntry
+{
+    std::uint64_t key;
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+inline std::uint64_t MakeKey(const unsigned z, const unsigned x, const unsigned y)
+{
+    // x and y are below 2^z and z below 32
+    return (static_cast<std::uint64_t>(z) << 58) | (static_cast<std::uint64_t>(x) << 29) | y;
+}
+}
+
+/**
+ * Debug tiles rendered ahead of time by osrm-tiles, so serving a tile of a pre-rendered area is a
+ * lookup in the index instead of rendering it. The file is mapped read-only and shared by all
+ * requests.
+ */
+class TileArchive
+{
+  public:
+    explicit TileArchive(const boost::filesystem::path &path);
+
+    // Checksum of the data the tiles were rendered from, tiles of other data must not be served
+    unsigned GetCheckSum() const { return header->checksum; }
+    std::size_t GetNumberOfTiles() const { return header->number_of_tiles; }
+
+    // Returns true and sets tile if the archive contains it
+    bool Find(const unsigned z, const unsigned x, const unsigned y, std::string &tile) const;
+
+  private:
+    boost::iostreams::mapped_file_source region;
+    const tile_archive::Header *header;
+    const tile_archive::IndexEntry *index_begin;
+    const tile_archive::IndexEntry *index_end;
+};
+
+/**
+ * Writes a tile archive, tiles can be added from multiple threads in any order.
+ */
+class TileArchiveWriter
+{
+  public:
+    TileArchiveWriter(const boost::filesystem::path &path, const unsigned checksum);
+
+    void Write(const unsigned z, const unsigned x, const unsigned y, const std::string &tile);
+
+    // Writes the index and header, no tiles can be added afterwards
+    void Finish();
+
+  private:
+    std::mutex mutex;
+    boost::filesystem::ofstream output;
+    const unsigned checksum;
+    std::uint64_t offset;
+    std::vector<tile_archive::IndexEntry> index;
+};
+}
+}
+
+#endif
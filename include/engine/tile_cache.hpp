@@ -0,0 +1,69 @@
+#ifndef ENGINE_TILE_CACHE_HPP
+#define ENGINE_TILE_CACHE_HPP
+
+#include "engine/sharded_lru_cache.hpp"
+#include "engine/tile_archive.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace osrm
+{
+namespace engine
+{
+
+struct TileSize
+{
+    std::size_t operator()(const std::string &tile) const { return tile.size(); }
+};
+
+/**
+ * Caches rendered debug tiles across requests. Map viewers request the same tiles over and over
+ * while panning, a hit saves the r-tree query, the turn analysis and the encoding of the tile.
+ *
+ * The capacity is given in bytes of tile data, tiles of low zoom levels in dense areas are a lot
+ * larger than others. Tiles larger than the capacity of a shard are not cached.
+ */
+class TileCache final : private ShardedLRUCache<std::uint64_t,
+                                                std::string,
+                                                std::hash<std::uint64_t>,
+                                                std::equal_to<std::uint64_t>,
+                                                TileSize>
+{
+    using Base = ShardedLRUCache<std::uint64_t,
+                                 std::string,
+                                 std::hash<std::uint64_t>,
+                                 std::equal_to<std::uint64_t>,
+                                 TileSize>;
+
+  public:
+    using Base::Statistics;
+    using Base::GetStatistics;
+
+    explicit TileCache(const std::size_t capacity) : Base("tile cache", capacity) {}
+
+    // Returns true and sets tile if it was rendered on this dataset before
+    bool Find(const unsigned dataset_timestamp,
+              const unsigned z,
+              const unsigned x,
+              const unsigned y,
+              std::string &tile)
+    {
+        return Base::Find(dataset_timestamp, tile_archive::MakeKey(z, x, y), tile);
+    }
+
+    void Insert(const unsigned dataset_timestamp,
+                const unsigned z,
+                const unsigned x,
+                const unsigned y,
+                const std::string &tile)
+    {
+        Base::Insert(dataset_timestamp, tile_archive::MakeKey(z, x, y), tile);
+    }
+};
+}
+}
+
+#endif
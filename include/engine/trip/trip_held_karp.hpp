@@ -0,0 +1,204 @@
+#ifndef TRIP_HELD_KARP_HPP
+#define TRIP_HELD_KARP_HPP
+
+#include "util/dist_table_wrapper.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace trip
+{
+
+// Largest component solved exactly, the tables take 5 bytes per entry and have
+// (n - 1) * 2^(n - 2) entries: 1.2 MiB for 16 locations, but already 25 MiB for 20. Larger
+// components are left to farthest insertion and local search.
+const constexpr std::size_t HELD_KARP_MAX_FEASABLE = 16;
+
+namespace detail
+{
+// Removes the given bit from a subset and shifts the higher bits down by one. Subsets always
+// contain their last location, so the tables are indexed without it.
+inline std::uint32_t RemoveBit(const std::uint32_t subset, const std::size_t bit)
+{
+    const std::uint32_t lower_bits = subset & ((std::uint32_t{1} << bit) - 1);
+    return lower_bits | ((subset >> (bit + 1)) << bit);
+}
+
+// Index of the lowest location in a subset, found by multiplying with a de Bruijn sequence
+inline std::size_t LowestBit(const std::uint32_t subset)
+{
+    static const constexpr std::uint8_t positions[32] = {0,  1,  28, 2,  29, 14, 24, 3,
+                                                         30, 22, 20, 15, 25, 17, 4,  8,
+                                                         31, 27, 13, 23, 21, 19, 16, 7,
+                                                         26, 12, 18, 6,  11, 5,  10, 9};
+    BOOST_ASSERT(subset != 0);
+    return positions[((subset & (~subset + 1)) * 0x077CB531u) >> 27];
+}
+
+// Next larger subset with the same number of locations (Gosper's hack)
+inline std::uint32_t NextSubset(const std::uint32_t subset)
+{
+    const std::uint32_t lowest_bit = subset & (~subset + 1);
+    const std::uint32_t ripple = subset + lowest_bit;
+    return (((ripple ^ subset) >> 2) / lowest_bit) | ripple;
+}
+
+inline EdgeWeight AddWeights(const EdgeWeight lhs, const EdgeWeight rhs)
+{
+    const auto sum = static_cast<std::int64_t>(lhs) + rhs;
+    return static_cast<EdgeWeight>(
+        std::min<std::int64_t>(sum, std::numeric_limits<EdgeWeight>::max()));
+}
+}
+
+// Computes the shortest round trip exactly with the Held-Karp dynamic program in O(2^n n^2)
+// instead of trying all O(n!) permutations. The trip starts at the first location, the costs of
+// the paths from it through all subsets of the other locations are computed in layers of
+// increasing subset size. The subsets of a layer only depend on the previous layer, so they are
+// evaluated in parallel.
+template <typename NodeIDIterator>
+std::vector<NodeID> HeldKarpTrip(const NodeIDIterator start,
+                                 const NodeIDIterator end,
+                                 const std::size_t number_of_locations,
+                                 const util::DistTableWrapper<EdgeWeight> &dist_table)
+{
+    (void)number_of_locations; // unused
+
+    const std::vector<NodeID> locations(start, end);
+    BOOST_ASSERT_MSG(!locations.empty(), "no locations given");
+    BOOST_ASSERT_MSG(locations.size() <= HELD_KARP_MAX_FEASABLE, "too many locations");
+
+    // every order of up to two locations is the same round trip
+    if (locations.size() <= 2)
+    {
+        return locations;
+    }
+
+    // the locations visited between leaving and returning to the first one
+    const std::size_t number_of_stops = locations.size() - 1;
+    const std::uint32_t all_stops = (std::uint32_t{1} << number_of_stops) - 1;
+
+    // copy the durations into a dense table, the dynamic program reads them over and over, all
+    // durations to the same stop are next to each other
+    std::vector<EdgeWeight> durations_to(number_of_stops * number_of_stops);
+    std::vector<EdgeWeight> from_start(number_of_stops);
+    std::vector<EdgeWeight> to_start(number_of_stops);
+    for (std::size_t from = 0; from < number_of_stops; ++from)
+    {
+        from_start[from] = dist_table(locations.front(), locations[from + 1]);
+        to_start[from] = dist_table(locations[from + 1], locations.front());
+        for (std::size_t to = 0; to < number_of_stops; ++to)
+        {
+            durations_to[to * number_of_stops + from] =
+                dist_table(locations[from + 1], locations[to + 1]);
+        }
+    }
+
+    // cost of the shortest path from the start through all stops of a subset, ending at its last
+    // stop, and the stop visited before the last one
+    const auto index = [number_of_stops](const std::uint32_t subset, const std::size_t last) {
+        return detail::RemoveBit(subset, last) * number_of_stops + last;
+    };
+    const std::size_t table_size = (std::size_t{1} << (number_of_stops - 1)) * number_of_stops;
+    std::vector<EdgeWeight> costs(table_size, INVALID_EDGE_WEIGHT);
+    std::vector<std::uint8_t> predecessors(table_size, 0);
+
+    for (std::size_t last = 0; last < number_of_stops; ++last)
+    {
+        costs[index(std::uint32_t{1} << last, last)] = from_start[last];
+    }
+
+    std::vector<std::uint32_t> layer;
+    for (std::size_t layer_size = 2; layer_size <= number_of_stops; ++layer_size)
+    {
+        layer.clear();
+        for (std::uint32_t subset = (std::uint32_t{1} << layer_size) - 1; subset <= all_stops;
+             subset = detail::NextSubset(subset))
+        {
+            layer.push_back(subset);
+        }
+
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, layer.size(), 256),
+            [&](const tbb::blocked_range<std::size_t> &range) {
+                for (auto subset_index = range.begin(); subset_index != range.end();
+                     ++subset_index)
+                {
+                    const auto subset = layer[subset_index];
+                    for (auto last_bits = subset; last_bits != 0; last_bits &= last_bits - 1)
+                    {
+                        const std::size_t last = detail::LowestBit(last_bits);
+                        const auto previous_subset = subset ^ (std::uint32_t{1} << last);
+                        const auto durations_to_last = &durations_to[last * number_of_stops];
+
+                        auto best_cost = INVALID_EDGE_WEIGHT;
+                        std::size_t best_previous = 0;
+                        for (auto previous_bits = previous_subset; previous_bits != 0;
+                             previous_bits &= previous_bits - 1)
+                        {
+                            const std::size_t previous = detail::LowestBit(previous_bits);
+                            const auto cost =
+                                detail::AddWeights(costs[index(previous_subset, previous)],
+                                                   durations_to_last[previous]);
+                            if (cost < best_cost)
+                            {
+                                best_cost = cost;
+                                best_previous = previous;
+                            }
+                        }
+
+                        costs[index(subset, last)] = best_cost;
+                        predecessors[index(subset, last)] =
+                            static_cast<std::uint8_t>(best_previous);
+                    }
+                }
+            });
+    }
+
+    auto best_cost = INVALID_EDGE_WEIGHT;
+    std::size_t last = 0;
+    for (std::size_t candidate = 0; candidate < number_of_stops; ++candidate)
+    {
+        const auto cost =
+            detail::AddWeights(costs[index(all_stops, candidate)], to_start[candidate]);
+        if (cost < best_cost)
+        {
+            best_cost = cost;
+            last = candidate;
+        }
+    }
+
+    // follow the predecessors back to the start
+    std::vector<NodeID> route(locations.size());
+    route.front() = locations.front();
+    std::uint32_t subset = all_stops;
+    for (auto position = number_of_stops; position > 0; --position)
+    {
+        route[position] = locations[last + 1];
+        const auto previous = predecessors[index(subset, last)];
+        subset ^= std::uint32_t{1} << last;
+        last = previous;
+    }
+    BOOST_ASSERT(subset == 0);
+
+    return route;
+}
+}
+}
+}
+
+#endif // TRIP_HELD_KARP_HPP
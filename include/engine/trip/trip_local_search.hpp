@@ -0,0 +1,154 @@
+#ifndef TRIP_LOCAL_SEARCH_HPP
+#define TRIP_LOCAL_SEARCH_HPP
+
+#include "util/dist_table_wrapper.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace trip
+{
+
+namespace detail
+{
+// Sums of the durations along the route up to each position, in driving direction and against
+// it. The durations are asymmetric, so reversing a part of the route changes its duration.
+inline void ComputeRouteDurations(const std::vector<NodeID> &route,
+                                  const util::DistTableWrapper<EdgeWeight> &dist_table,
+                                  std::vector<std::int64_t> &forward,
+                                  std::vector<std::int64_t> &backward)
+{
+    forward.resize(route.size());
+    backward.resize(route.size());
+    forward.front() = 0;
+    backward.front() = 0;
+    for (std::size_t position = 1; position < route.size(); ++position)
+    {
+        forward[position] =
+            forward[position - 1] + dist_table(route[position - 1], route[position]);
+        backward[position] =
+            backward[position - 1] + dist_table(route[position], route[position - 1]);
+    }
+}
+
+// Applies the first 2-opt move that shortens the round trip: the part of the route between two
+// of its legs is reversed, the legs are reconnected to its other ends.
+inline bool TwoOptMove(std::vector<NodeID> &route,
+                       const util::DistTableWrapper<EdgeWeight> &dist_table,
+                       std::vector<std::int64_t> &forward,
+                       std::vector<std::int64_t> &backward)
+{
+    ComputeRouteDurations(route, dist_table, forward, backward);
+
+    const auto size = route.size();
+    for (std::size_t first = 0; first + 2 < size; ++first)
+    {
+        for (std::size_t last = first + 2; last < size; ++last)
+        {
+            // reverse the part from first + 1 to last
+            const auto after_last = route[(last + 1) % size];
+            const std::int64_t removed = dist_table(route[first], route[first + 1]) +
+                                         dist_table(route[last], after_last) +
+                                         (forward[last] - forward[first + 1]);
+            const std::int64_t added = dist_table(route[first], route[last]) +
+                                       dist_table(route[first + 1], after_last) +
+                                       (backward[last] - backward[first + 1]);
+            if (added < removed)
+            {
+                std::reverse(route.begin() + first + 1, route.begin() + last + 1);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Applies the first Or-opt move that shortens the round trip: up to three consecutive locations
+// are moved to another place in the route, keeping their order.
+inline bool OrOptMove(std::vector<NodeID> &route,
+                      const util::DistTableWrapper<EdgeWeight> &dist_table)
+{
+    const auto size = route.size();
+    for (std::size_t length = 1; length <= 3; ++length)
+    {
+        // the first location stays in place, it is where the trip starts
+        for (std::size_t first = 1; first + length <= size; ++first)
+        {
+            const auto last = first + length - 1;
+            const auto before = route[first - 1];
+            const auto after = route[(last + 1) % size];
+            if (before == after)
+            {
+                continue;
+            }
+
+            const std::int64_t gain = static_cast<std::int64_t>(dist_table(before, route[first])) +
+                                      dist_table(route[last], after) - dist_table(before, after);
+
+            // insert between the locations at position and position + 1
+            for (std::size_t position = 0; position < size; ++position)
+            {
+                if (position + 1 >= first && position <= last)
+                {
+                    continue;
+                }
+                const auto from = route[position];
+                const auto to = route[(position + 1) % size];
+                const std::int64_t cost =
+                    static_cast<std::int64_t>(dist_table(from, route[first])) +
+                    dist_table(route[last], to) - dist_table(from, to);
+                if (cost < gain)
+                {
+                    const std::vector<NodeID> segment(route.begin() + first,
+                                                      route.begin() + last + 1);
+                    route.erase(route.begin() + first, route.begin() + last + 1);
+                    const auto insert_after = position < first ? position : position - length;
+                    route.insert(route.begin() + insert_after + 1, segment.begin(), segment.end());
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+}
+
+// Shortens a round trip computed by a heuristic with 2-opt and Or-opt moves until none of them
+// improves it anymore or the time budget is used up. The first location stays in front.
+inline void ImproveTrip(std::vector<NodeID> &route,
+                        const util::DistTableWrapper<EdgeWeight> &dist_table,
+                        const std::chrono::steady_clock::duration time_budget)
+{
+    if (route.size() < 4)
+    {
+        return;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + time_budget;
+    std::vector<std::int64_t> forward;
+    std::vector<std::int64_t> backward;
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (!detail::TwoOptMove(route, dist_table, forward, backward) &&
+            !detail::OrOptMove(route, dist_table))
+        {
+            break;
+        }
+    }
+}
+}
+}
+}
+
+#endif // TRIP_LOCAL_SEARCH_HPP
@@ -3,6 +3,7 @@
 
 #include "util/attributes.hpp"
 #include "util/bearing.hpp"
+#include "util/concurrent_id_map.hpp"
 #include "util/coordinate.hpp"
 #include "util/coordinate_calculation.hpp"
 #include "util/guidance/toolkit.hpp"
@@ -39,7 +40,8 @@ namespace guidance
 {
 
 using util::guidance::LaneTupleIdPair;
-using LaneDataIdMap = std::unordered_map<LaneTupleIdPair, LaneDataID, boost::hash<LaneTupleIdPair>>;
+using LaneDataIdMap =
+    util::ConcurrentIdMap<LaneTupleIdPair, LaneDataID, boost::hash<LaneTupleIdPair>>;
 
 using util::guidance::angularDeviation;
 using util::guidance::entersRoundabout;
@@ -28,11 +28,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef OSRM_HPP
 #define OSRM_HPP
 
+#include "osrm/cache_statistics.hpp"
 #include "osrm/osrm_fwd.hpp"
 #include "osrm/status.hpp"
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -85,6 +87,15 @@ class OSRM final
      */
     Status Route(const RouteParameters &parameters, json::Object &result) const;
 
+    /**
+     * Shortest path queries for coordinates, as protobuf message.
+     *
+     * \param parameters route query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, RouteParameters and the RouteResponse message in docs/http.md
+     */
+    Status Route(const RouteParameters &parameters, std::string &result) const;
+
     /**
      * Distance tables for coordinates.
      *
@@ -94,6 +105,29 @@ class OSRM final
      */
     Status Table(const TableParameters &parameters, json::Object &result) const;
 
+    /**
+     * Distance tables for coordinates, rendered as JSON text.
+     *
+     * Streams the response into the buffer without building a json::Object first, which is
+     * considerably faster for large tables.
+     *
+     * \param parameters table query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, TableParameters and util::json::Writer
+     */
+    Status Table(const TableParameters &parameters, std::vector<char> &result) const;
+
+    /**
+     * Distance tables for coordinates, as protobuf message.
+     *
+     * The matrices are packed little-endian floats that can be used without copying them.
+     *
+     * \param parameters table query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, TableParameters and the TableResponse message in docs/http.md
+     */
+    Status Table(const TableParameters &parameters, std::string &result) const;
+
     /**
      * Nearest street segment for coordinate.
      *
@@ -121,6 +155,18 @@ class OSRM final
      */
     Status Match(const MatchParameters &parameters, json::Object &result) const;
 
+    /**
+     * Match: snaps a batch of noisy coordinate traces to the road network
+     *
+     * The traces are matched in parallel. The result holds the response of every trace in input
+     * order under `results`, a trace that can not be matched does not fail the whole batch.
+     *
+     * \param parameters match query specific parameters of every trace
+     * \return Status indicating success for the batch or failure
+     * \see Status, MatchParameters and json::Object
+     */
+    Status Match(const std::vector<MatchParameters> &parameters, json::Object &result) const;
+
     /**
      * Tile: vector tiles with internal graph representation
      *
@@ -130,6 +176,16 @@ class OSRM final
      */
     Status Tile(const TileParameters &parameters, std::string &result) const;
 
+    /**
+     * Statistics of the snapping cache shared by all requests, see
+     * EngineConfig::snapping_cache_size. All counters are zero if the cache is disabled.
+     *
+     * 
+eturn hits, misses and evictions since construction and the current number of entries
+     * \see CacheStatistics
+     */
+    CacheStatistics GetSnappingCacheStatistics() const;
+
   private:
     std::unique_ptr<engine::Engine> engine_;
 };
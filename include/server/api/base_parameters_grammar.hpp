@@ -27,16 +27,22 @@ namespace ph = boost::phoenix;
 namespace qi = boost::spirit::qi;
 }
 
-template <typename T, char... Fmt> struct no_trailing_dot_policy : qi::real_policies<T>
+template <typename T> struct no_trailing_dot_policy : qi::real_policies<T>
 {
     template <typename Iterator> static bool parse_dot(Iterator &first, Iterator const &last)
     {
         if (first == last || *first != '.')
             return false;
 
-        static const constexpr char fmt[sizeof...(Fmt)] = {Fmt...};
+        // the dot of a format suffix as in 1,2;3,4.json does not belong to the number
+        static const constexpr char json_fmt[] = {'j', 's', 'o', 'n'};
+        static const constexpr char pbf_fmt[] = {'p', 'b', 'f'};
 
-        if (first + sizeof(fmt) < last && std::equal(fmt, fmt + sizeof(fmt), first + 1u))
+        if (first + sizeof(json_fmt) < last &&
+            std::equal(json_fmt, json_fmt + sizeof(json_fmt), first + 1u))
+            return false;
+        if (first + sizeof(pbf_fmt) < last &&
+            std::equal(pbf_fmt, pbf_fmt + sizeof(pbf_fmt), first + 1u))
             return false;
 
         ++first;
@@ -70,7 +76,7 @@ template <typename T, char... Fmt> struct no_trailing_dot_policy : qi::real_poli
 template <typename Iterator, typename Signature>
 struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
 {
-    using json_policy = no_trailing_dot_policy<double, 'j', 's', 'o', 'n'>;
+    using json_policy = no_trailing_dot_policy<double>;
 
     BaseParametersGrammar(qi::rule<Iterator, Signature> &root_rule)
         : BaseParametersGrammar::base_type(root_rule)
@@ -146,11 +152,20 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
             (-(qi::short_ > ',' > qi::short_))[ph::bind(add_bearing, qi::_r1, qi::_1)] % ';';
 
         base_rule = radiuses_rule(qi::_r1) | hints_rule(qi::_r1) | bearings_rule(qi::_r1);
+
+        format_type.add("json", engine::api::BaseParameters::FormatType::JSON)(
+            "pbf", engine::api::BaseParameters::FormatType::Protobuf);
+
+        format_rule =
+            qi::lit('.') >>
+            format_type[ph::bind(&engine::api::BaseParameters::format, qi::_r1) = qi::_1];
     }
 
   protected:
     qi::rule<Iterator, Signature> base_rule;
     qi::rule<Iterator, Signature> query_rule;
+    // response format suffix, for services that support more than `.json`
+    qi::rule<Iterator, Signature> format_rule;
 
   private:
     qi::rule<Iterator, Signature> bearings_rule;
@@ -165,6 +180,7 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
     qi::rule<Iterator, std::string()> polyline_chars;
     qi::rule<Iterator, double()> unlimited_rule;
     qi::real_parser<double, json_policy> double_;
+    qi::symbols<char, engine::api::BaseParameters::FormatType> format_type;
 };
 }
 }
@@ -30,13 +30,18 @@ struct RouteParametersGrammar : public BaseParametersGrammar<Iterator, Signature
     {
         route_rule =
             (qi::lit("alternatives=") >
-             qi::bool_[ph::bind(&engine::api::RouteParameters::alternatives, qi::_r1) = qi::_1]) |
+             (qi::uint_[(ph::bind(&engine::api::RouteParameters::alternatives, qi::_r1) =
+                             qi::_1 > 0u,
+                         ph::bind(&engine::api::RouteParameters::number_of_alternatives,
+                                  qi::_r1) = qi::_1)] |
+              qi::bool_[ph::bind(&engine::api::RouteParameters::alternatives, qi::_r1) =
+                            qi::_1])) |
             (qi::lit("continue_straight=") >
              (qi::lit("default") |
               qi::bool_[ph::bind(&engine::api::RouteParameters::continue_straight, qi::_r1) =
                             qi::_1]));
 
-        root_rule = query_rule(qi::_r1) > -qi::lit(".json") >
+        root_rule = query_rule(qi::_r1) > -BaseGrammar::format_rule(qi::_r1) >
                     -('?' > (route_rule(qi::_r1) | base_rule(qi::_r1)) % '&');
     }
 
@@ -48,9 +48,26 @@ struct TableParametersGrammar final : public BaseParametersGrammar<Iterator, Sig
             (qi::lit("all") |
              (size_t_ % ';')[ph::bind(&engine::api::TableParameters::sources, qi::_r1) = qi::_1]);
 
-        table_rule = destinations_rule(qi::_r1) | sources_rule(qi::_r1);
+        const auto set_annotations =
+            [](engine::api::TableParameters &table_parameters,
+               const std::vector<engine::api::TableParameters::AnnotationsType> &types) {
+                table_parameters.annotations = engine::api::TableParameters::AnnotationsType::None;
+                for (const auto type : types)
+                {
+                    table_parameters.annotations |= type;
+                }
+            };
 
-        root_rule = BaseGrammar::query_rule(qi::_r1) > -qi::lit(".json") >
+        annotations_type.add("duration", engine::api::TableParameters::AnnotationsType::Duration)(
+            "distance", engine::api::TableParameters::AnnotationsType::Distance);
+
+        annotations_rule =
+            qi::lit("annotations=") >
+            (annotations_type % ',')[ph::bind(set_annotations, qi::_r1, qi::_1)];
+
+        table_rule = destinations_rule(qi::_r1) | sources_rule(qi::_r1) | annotations_rule(qi::_r1);
+
+        root_rule = BaseGrammar::query_rule(qi::_r1) > -BaseGrammar::format_rule(qi::_r1) >
                     -('?' > (table_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1)) % '&');
     }
 
@@ -59,7 +76,10 @@ struct TableParametersGrammar final : public BaseParametersGrammar<Iterator, Sig
     qi::rule<Iterator, Signature> table_rule;
     qi::rule<Iterator, Signature> sources_rule;
     qi::rule<Iterator, Signature> destinations_rule;
+    qi::rule<Iterator, Signature> annotations_rule;
     qi::rule<Iterator, std::size_t()> size_t_;
+
+    qi::symbols<char, engine::api::TableParameters::AnnotationsType> annotations_type;
 };
 }
 }
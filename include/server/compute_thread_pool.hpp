@@ -0,0 +1,93 @@
+#ifndef COMPUTE_THREAD_POOL_HPP
+#define COMPUTE_THREAD_POOL_HPP
+
+#include <boost/asio.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace osrm
+{
+namespace server
+{
+
+/// Runs queries on threads of their own so long running requests do not block the threads
+/// handling socket I/O. The queue is bounded in size and in the time a job may wait in it,
+/// which lets the server reject requests when it is overloaded instead of piling them up.
+class ComputeThreadPool
+{
+  public:
+    ComputeThreadPool(const unsigned num_threads,
+                      const unsigned max_queue_size,
+                      const std::chrono::milliseconds max_queue_wait)
+        : num_threads(num_threads), max_queue_size(max_queue_size),
+          max_queue_wait(max_queue_wait), queued_jobs(0)
+    {
+    }
+
+    ComputeThreadPool(const ComputeThreadPool &) = delete;
+    ComputeThreadPool &operator=(const ComputeThreadPool &) = delete;
+
+    /// Queues the job, returns false if the queue is full. The job is called with `true` if it
+    /// waited longer than allowed and should not do any work anymore.
+    template <typename JobT> bool Post(JobT job)
+    {
+        if (queued_jobs.fetch_add(1) >= max_queue_size)
+        {
+            --queued_jobs;
+            return false;
+        }
+
+        const auto enqueued = std::chrono::steady_clock::now();
+        io_service.post([this, job, enqueued]() mutable {
+            --queued_jobs;
+            const bool expired = max_queue_wait.count() > 0 &&
+                                 std::chrono::steady_clock::now() - enqueued > max_queue_wait;
+            job(expired);
+        });
+        return true;
+    }
+
+    /// Number of jobs waiting for a thread.
+    unsigned QueueSize() const { return queued_jobs; }
+
+    void Start()
+    {
+        work = std::make_unique<boost::asio::io_service::work>(io_service);
+        for (unsigned i = 0; i < num_threads; ++i)
+        {
+            threads.emplace_back([this] { io_service.run(); });
+        }
+    }
+
+    void Stop()
+    {
+        work.reset();
+        io_service.stop();
+    }
+
+    void Join()
+    {
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        threads.clear();
+    }
+
+  private:
+    const unsigned num_threads;
+    const unsigned max_queue_size;
+    const std::chrono::milliseconds max_queue_wait;
+    std::atomic<unsigned> queued_jobs;
+    boost::asio::io_service io_service;
+    std::unique_ptr<boost::asio::io_service::work> work;
+    std::vector<std::thread> threads;
+};
+}
+}
+
+#endif // COMPUTE_THREAD_POOL_HPP
@@ -31,13 +31,21 @@ namespace osrm
 namespace server
 {
 
+class ComputeThreadPool;
 class RequestHandler;
 
 /// Represents a single connection from a client.
+/// Connections are kept open for further (possibly pipelined) requests as long as the client
+/// supports it, until they were idle for keepalive_timeout seconds or served
+/// keepalive_max_requests requests. Queries are answered on the compute thread pool.
 class Connection : public std::enable_shared_from_this<Connection>
 {
   public:
-    explicit Connection(boost::asio::io_service &io_service, RequestHandler &handler);
+    explicit Connection(boost::asio::io_service &io_service,
+                        RequestHandler &handler,
+                        ComputeThreadPool &compute_pool,
+                        const unsigned keepalive_timeout,
+                        const unsigned keepalive_max_requests);
     Connection(const Connection &) = delete;
     Connection &operator=(const Connection &) = delete;
 
@@ -47,19 +55,43 @@ class Connection : public std::enable_shared_from_this<Connection>
     void start();
 
   private:
+    /// Read more data. After a response was written, closes the connection if none arrives
+    /// within keepalive_timeout seconds.
+    void read_request();
+
     void handle_read(const boost::system::error_code &e, std::size_t bytes_transferred);
 
+    /// Parse and answer the request contained in the buffered data.
+    void process_request(char *begin, char *end);
+
+    /// Send the reply to the current request, back on the connection's strand.
+    void write_reply(const http::compression_type compression_type);
+
     /// Handle completion of a write operation.
     void handle_write(const boost::system::error_code &e);
 
+    /// Handle expiry of the idle timer.
+    void handle_timeout(const boost::system::error_code &e);
+
+    void shutdown();
+
     std::vector<char> compress_buffers(const std::vector<char> &uncompressed_data,
                                        const http::compression_type compression_type);
 
     boost::asio::io_service::strand strand;
     boost::asio::ip::tcp::socket TCP_socket;
+    boost::asio::deadline_timer timer;
     RequestHandler &request_handler;
+    ComputeThreadPool &compute_pool;
     RequestParser request_parser;
     boost::array<char, 8192> incoming_data_buffer;
+    // buffered data of pipelined requests that was not parsed yet
+    char *pending_data_begin;
+    char *pending_data_end;
+    const unsigned keepalive_timeout;
+    const unsigned keepalive_max_requests;
+    unsigned processed_requests;
+    bool keep_alive;
     http::request current_request;
     http::reply current_reply;
     std::vector<char> compressed_output;
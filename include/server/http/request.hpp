@@ -14,10 +14,16 @@ namespace http
 
 struct request
 {
+    std::string method;
     std::string uri;
     std::string referrer;
     std::string agent;
     boost::asio::ip::address endpoint;
+    // HTTP/1.1 connections persist unless the client asks for `Connection: close`,
+    // HTTP/1.0 ones only when it asks for `Connection: keep-alive`
+    bool keep_alive = false;
+    // sent with a Content-Length header, only accepted on POST requests e.g. the traces of a batch
+    std::string body;
 };
 }
 }
@@ -4,6 +4,7 @@
 #include "server/http/compression_type.hpp"
 #include "server/http/header.hpp"
 
+#include <cstddef>
 #include <tuple>
 
 namespace osrm
@@ -21,6 +22,9 @@ class RequestParser
   public:
     RequestParser();
 
+    // Larger request bodies are rejected as invalid
+    static const constexpr std::size_t MAX_CONTENT_LENGTH = 64 * 1024 * 1024;
+
     enum class RequestStatus : char
     {
         valid,
@@ -28,7 +32,9 @@ class RequestParser
         indeterminate
     };
 
-    std::tuple<RequestStatus, http::compression_type>
+    // Consumes input until a request is complete or invalid. The returned pointer is the first
+    // unconsumed character, following input belongs to pipelined requests.
+    std::tuple<RequestStatus, http::compression_type, char *>
     parse(http::request &current_request, char *begin, char *end);
 
   private:
@@ -64,11 +70,17 @@ class RequestParser
         space_before_header_value,
         header_value,
         expecting_newline_2,
-        expecting_newline_3
+        expecting_newline_3,
+        content
     } state;
 
     http::header current_header;
     http::compression_type selected_compression;
+    unsigned http_version_major;
+    unsigned http_version_minor;
+    std::size_t content_length;
+    bool connection_close;
+    bool connection_keep_alive;
 };
 }
 }
@@ -1,6 +1,7 @@
 #ifndef SERVER_HPP
 #define SERVER_HPP
 
+#include "server/compute_thread_pool.hpp"
 #include "server/connection.hpp"
 #include "server/request_handler.hpp"
 #include "server/service_handler.hpp"
@@ -18,6 +19,7 @@
 #include <sys/types.h>
 #endif
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
@@ -33,19 +35,47 @@ class Server
 {
   public:
     // Note: returns a shared instead of a unique ptr as it is captured in a lambda somewhere else
-    static std::shared_ptr<Server>
-    CreateServer(std::string &ip_address, int ip_port, unsigned requested_num_threads)
+    static std::shared_ptr<Server> CreateServer(std::string &ip_address,
+                                                int ip_port,
+                                                unsigned requested_num_threads,
+                                                unsigned requested_num_io_threads,
+                                                unsigned max_queue_size,
+                                                unsigned max_queue_wait_ms,
+                                                unsigned keepalive_timeout,
+                                                unsigned keepalive_max_requests)
     {
         util::SimpleLogger().Write() << "http 1.1 compression handled by zlib version "
                                      << zlibVersion();
         const unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
         const unsigned real_num_threads = std::min(hardware_threads, requested_num_threads);
-        return std::make_shared<Server>(ip_address, ip_port, real_num_threads);
+        const unsigned real_num_io_threads =
+            std::max(1u, std::min(hardware_threads, requested_num_io_threads));
+        return std::make_shared<Server>(ip_address,
+                                        ip_port,
+                                        real_num_threads,
+                                        real_num_io_threads,
+                                        max_queue_size,
+                                        std::chrono::milliseconds(max_queue_wait_ms),
+                                        keepalive_timeout,
+                                        keepalive_max_requests);
     }
 
-    explicit Server(const std::string &address, const int port, const unsigned thread_pool_size)
-        : thread_pool_size(thread_pool_size), acceptor(io_service),
-          new_connection(std::make_shared<Connection>(io_service, request_handler))
+    explicit Server(const std::string &address,
+                    const int port,
+                    const unsigned compute_pool_size,
+                    const unsigned thread_pool_size,
+                    const unsigned max_queue_size,
+                    const std::chrono::milliseconds max_queue_wait,
+                    const unsigned keepalive_timeout,
+                    const unsigned keepalive_max_requests)
+        : thread_pool_size(thread_pool_size), keepalive_timeout(keepalive_timeout),
+          keepalive_max_requests(keepalive_max_requests), acceptor(io_service),
+          compute_pool(compute_pool_size, max_queue_size, max_queue_wait),
+          new_connection(std::make_shared<Connection>(io_service,
+                                                      request_handler,
+                                                      compute_pool,
+                                                      keepalive_timeout,
+                                                      keepalive_max_requests))
     {
         const auto port_string = std::to_string(port);
 
@@ -69,8 +99,11 @@ class Server
             boost::bind(&Server::HandleAccept, this, boost::asio::placeholders::error));
     }
 
+    // Runs the I/O threads until the server is stopped, queries are answered on the compute pool.
     void Run()
     {
+        compute_pool.Start();
+
         std::vector<std::shared_ptr<std::thread>> threads;
         for (unsigned i = 0; i < thread_pool_size; ++i)
         {
@@ -82,9 +115,14 @@ class Server
         {
             thread->join();
         }
+        compute_pool.Join();
     }
 
-    void Stop() { io_service.stop(); }
+    void Stop()
+    {
+        io_service.stop();
+        compute_pool.Stop();
+    }
 
     void RegisterServiceHandler(std::unique_ptr<ServiceHandlerInterface> service_handler_)
     {
@@ -97,7 +135,11 @@ class Server
         if (!e)
         {
             new_connection->start();
-            new_connection = std::make_shared<Connection>(io_service, request_handler);
+            new_connection = std::make_shared<Connection>(io_service,
+                                                          request_handler,
+                                                          compute_pool,
+                                                          keepalive_timeout,
+                                                          keepalive_max_requests);
             acceptor.async_accept(
                 new_connection->socket(),
                 boost::bind(&Server::HandleAccept, this, boost::asio::placeholders::error));
@@ -105,10 +147,13 @@ class Server
     }
 
     unsigned thread_pool_size;
+    unsigned keepalive_timeout;
+    unsigned keepalive_max_requests;
     boost::asio::io_service io_service;
     boost::asio::ip::tcp::acceptor acceptor;
-    std::shared_ptr<Connection> new_connection;
+    ComputeThreadPool compute_pool;
     RequestHandler request_handler;
+    std::shared_ptr<Connection> new_connection;
 };
 }
 }
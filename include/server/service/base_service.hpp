@@ -4,6 +4,7 @@
 #include "engine/status.hpp"
 #include "osrm/osrm.hpp"
 #include "util/coordinate.hpp"
+#include "util/json_container.hpp"
 
 #include <variant/variant.hpp>
 
@@ -20,7 +21,9 @@ namespace service
 class BaseService
 {
   public:
-    using ResultT = mapbox::util::variant<util::json::Object, std::string>;
+    // json::Object for JSON responses, std::string for protobuf ones, std::vector<char> for JSON
+    // responses that are already rendered
+    using ResultT = mapbox::util::variant<util::json::Object, std::string, std::vector<char>>;
 
     BaseService(OSRM &routing_machine) : routing_machine(routing_machine) {}
     virtual ~BaseService() = default;
@@ -28,6 +31,17 @@ class BaseService
     virtual engine::Status
     RunQuery(std::size_t prefix_length, std::string &query, ResultT &result) = 0;
 
+    // Runs the queries sent in the body of a `/{service}/v1/{profile}/batch` request, one per line
+    virtual engine::Status RunBatchQuery(const std::string &queries, ResultT &result)
+    {
+        (void)queries;
+        result = util::json::Object();
+        auto &json_result = result.get<util::json::Object>();
+        json_result.values["code"] = "InvalidService";
+        json_result.values["message"] = "Service does not support batch requests";
+        return engine::Status::Error;
+    }
+
     virtual unsigned GetVersion() = 0;
 
   protected:
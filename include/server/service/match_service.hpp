@@ -25,6 +25,8 @@ class MatchService final : public BaseService
     engine::Status
     RunQuery(std::size_t prefix_length, std::string &query, ResultT &result) final override;
 
+    engine::Status RunBatchQuery(const std::string &queries, ResultT &result) final override;
+
     unsigned GetVersion() final override { return 1; }
 };
 }
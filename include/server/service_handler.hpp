@@ -28,6 +28,8 @@ class ServiceHandlerInterface
   public:
     virtual ~ServiceHandlerInterface() {}
     virtual engine::Status RunQuery(api::ParsedURL parsed_url,
+                                    const std::string &method,
+                                    const std::string &body,
                                     service::BaseService::ResultT &result) = 0;
 };
 
@@ -37,7 +39,10 @@ class ServiceHandler final : public ServiceHandlerInterface
     ServiceHandler(osrm::EngineConfig &config);
     using ResultT = service::BaseService::ResultT;
 
-    virtual engine::Status RunQuery(api::ParsedURL parsed_url, ResultT &result) override;
+    virtual engine::Status RunQuery(api::ParsedURL parsed_url,
+                                    const std::string &method,
+                                    const std::string &body,
+                                    ResultT &result) override;
 
   private:
     std::unordered_map<std::string, std::unique_ptr<service::BaseService>> service_map;
@@ -0,0 +1,221 @@
+#ifndef OSRM_STORAGE_HUGE_PAGES_HPP
+#define OSRM_STORAGE_HUGE_PAGES_HPP
+
+#include "util/exception.hpp"
+#include "util/simple_logger.hpp"
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace osrm
+{
+namespace storage
+{
+
+// Pages backing the large data blocks. The search graph, coordinates and geometries are read in
+// random order, on 4 KiB pages most of these reads miss the TLB.
+//  - Transparent asks the kernel to use huge pages if it can, this needs
+//    /sys/kernel/mm/transparent_hugepage/{enabled,shmem_enabled} set to `advise` or `always`.
+//  - Explicit uses the huge pages reserved in vm.nr_hugepages and falls back to normal pages
+//    if not enough are free.
+enum class HugePages
+{
+    None,
+    Transparent,
+    Explicit
+};
+
+// Size of explicit huge pages, all allocations are rounded up to a multiple of it
+const constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+inline HugePages parseHugePages(const std::string &value)
+{
+    if (value == "none")
+        return HugePages::None;
+    if (value == "transparent")
+        return HugePages::Transparent;
+    if (value == "explicit")
+        return HugePages::Explicit;
+    throw util::exception("Invalid huge pages setting " + value +
+                          ", expected none, transparent or explicit");
+}
+
+inline std::string toString(const HugePages huge_pages)
+{
+    switch (huge_pages)
+    {
+    case HugePages::Transparent:
+        return "transparent";
+    case HugePages::Explicit:
+        return "explicit";
+    default:
+        return "none";
+    }
+}
+
+inline std::size_t roundToHugePages(const std::size_t size)
+{
+    return (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
+
+// Marks the memory as candidate for transparent huge pages
+inline void adviseHugePages(void *ptr, const std::size_t size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // madvise only accepts page aligned addresses
+    const std::uintptr_t page_size = boost::interprocess::mapped_region::get_page_size();
+    const auto begin = reinterpret_cast<std::uintptr_t>(ptr) / page_size * page_size;
+    const auto end = reinterpret_cast<std::uintptr_t>(ptr) + size;
+    if (-1 == madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE))
+    {
+        util::SimpleLogger().Write(logWARNING) << "could not advise huge pages: "
+                                               << std::strerror(errno);
+    }
+#else
+    (void)ptr;
+    (void)size;
+    util::SimpleLogger().Write(logWARNING) << "transparent huge pages are not supported";
+#endif
+}
+
+// Asks the kernel to read a file mapping ahead asynchronously
+inline void adviseWillNeed(const void *ptr, const std::size_t size)
+{
+#if defined(__linux__) && defined(MADV_WILLNEED)
+    const std::uintptr_t page_size = boost::interprocess::mapped_region::get_page_size();
+    const auto begin = reinterpret_cast<std::uintptr_t>(ptr) / page_size * page_size;
+    const auto end = reinterpret_cast<std::uintptr_t>(ptr) + size;
+    if (-1 == madvise(reinterpret_cast<void *>(begin), end - begin, MADV_WILLNEED))
+    {
+        util::SimpleLogger().Write(logWARNING) << "could not advise read ahead: "
+                                               << std::strerror(errno);
+    }
+#else
+    (void)ptr;
+    (void)size;
+#endif
+}
+
+// Reads one byte of every page so the page tables are filled before the first query runs,
+// instead of faulting pages in while answering it.
+inline void prefaultMemory(const void *ptr, const std::size_t size)
+{
+    const std::size_t page_size = boost::interprocess::mapped_region::get_page_size();
+    const auto memory = static_cast<const volatile char *>(ptr);
+
+    const auto checksum = tbb::parallel_reduce(
+        tbb::blocked_range<std::size_t>(0, (size + page_size - 1) / page_size),
+        char{0},
+        [&](const tbb::blocked_range<std::size_t> &pages, char value) {
+            for (auto page = pages.begin(); page != pages.end(); ++page)
+            {
+                value ^= memory[page * page_size];
+            }
+            return value;
+        },
+        [](const char lhs, const char rhs) { return static_cast<char>(lhs ^ rhs); });
+
+    util::SimpleLogger().Write(logDEBUG) << "prefaulted " << size << " bytes (" << +checksum
+                                         << ")";
+}
+
+/**
+ * Process-local memory block that can be backed by huge pages. Without huge pages support
+ * this is a plain heap allocation.
+ */
+class ProcessMemory
+{
+  public:
+    ProcessMemory(const std::size_t size, const HugePages huge_pages)
+    {
+#ifdef __linux__
+        if (huge_pages == HugePages::Explicit)
+        {
+#ifdef MAP_HUGETLB
+            mapped_size = roundToHugePages(size);
+            mapped_ptr = mmap(nullptr,
+                              mapped_size,
+                              PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                              -1,
+                              0);
+            if (mapped_ptr == MAP_FAILED)
+            {
+                util::SimpleLogger().Write(logWARNING)
+                    << "could not allocate " << mapped_size
+                    << " bytes on huge pages, is vm.nr_hugepages large enough? "
+                    << std::strerror(errno);
+                mapped_ptr = nullptr;
+            }
+#endif
+        }
+
+        if (mapped_ptr == nullptr && huge_pages != HugePages::None)
+        {
+            // aligning the block to huge pages lets the kernel back all of it with them
+            mapped_size = roundToHugePages(size);
+            mapped_ptr = mmap(nullptr,
+                              mapped_size,
+                              PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS,
+                              -1,
+                              0);
+            if (mapped_ptr == MAP_FAILED)
+            {
+                throw util::exception("could not allocate " + std::to_string(mapped_size) +
+                                      " bytes: " + std::strerror(errno));
+            }
+            adviseHugePages(mapped_ptr, mapped_size);
+        }
+#else
+        if (huge_pages != HugePages::None)
+        {
+            util::SimpleLogger().Write(logWARNING) << "huge pages are not supported";
+        }
+#endif
+
+        if (mapped_ptr == nullptr)
+        {
+            heap_memory = std::make_unique<char[]>(size);
+        }
+    }
+
+    ~ProcessMemory()
+    {
+#ifdef __linux__
+        if (mapped_ptr != nullptr)
+        {
+            munmap(mapped_ptr, mapped_size);
+        }
+#endif
+    }
+
+    ProcessMemory(const ProcessMemory &) = delete;
+    ProcessMemory &operator=(const ProcessMemory &) = delete;
+
+    char *Ptr() const
+    {
+        return mapped_ptr != nullptr ? static_cast<char *>(mapped_ptr) : heap_memory.get();
+    }
+
+  private:
+    void *mapped_ptr = nullptr;
+    std::size_t mapped_size = 0;
+    std::unique_ptr<char[]> heap_memory;
+};
+}
+}
+
+#endif // OSRM_STORAGE_HUGE_PAGES_HPP
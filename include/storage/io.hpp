@@ -13,10 +13,12 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/iostreams/seek.hpp>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 namespace osrm
 {
@@ -193,6 +195,40 @@ inline void readHSGR(io::FileReader &input_file,
     input_file.ReadInto(edge_buffer, number_of_edges);
 }
 
+// Reads the graph data of a `.hsgr` file into memory, splitting the edges into the part read by
+// the searches and the part needed for unpacking paths.
+// Needs to be called after readHSGRHeader() to get the correct offset in the stream
+using SearchNodeT = typename util::StaticGraph<contractor::QueryEdge::SearchData>::NodeArrayEntry;
+using SearchEdgeT = typename util::StaticGraph<contractor::QueryEdge::SearchData>::EdgeArrayEntry;
+using UnpackingDataT = contractor::QueryEdge::UnpackingData;
+inline void readHSGR(io::FileReader &input_file,
+                     SearchNodeT *node_buffer,
+                     const std::uint64_t number_of_nodes,
+                     SearchEdgeT *search_edge_buffer,
+                     UnpackingDataT *unpacking_buffer,
+                     const std::uint64_t number_of_edges)
+{
+    BOOST_ASSERT(node_buffer);
+    BOOST_ASSERT(search_edge_buffer);
+    BOOST_ASSERT(unpacking_buffer);
+    input_file.ReadInto(node_buffer, number_of_nodes);
+
+    // the edges are stored with their full data, read them in chunks to avoid a copy of all
+    const constexpr std::uint64_t CHUNK_SIZE = 64 * 1024;
+    std::vector<EdgeT> chunk(std::min(CHUNK_SIZE, number_of_edges));
+    for (std::uint64_t first = 0; first < number_of_edges; first += CHUNK_SIZE)
+    {
+        const auto count = std::min(CHUNK_SIZE, number_of_edges - first);
+        input_file.ReadInto(chunk.data(), count);
+        for (std::uint64_t index = 0; index < count; ++index)
+        {
+            search_edge_buffer[first + index].target = chunk[index].target;
+            search_edge_buffer[first + index].data = chunk[index].data;
+            unpacking_buffer[first + index] = chunk[index].data;
+        }
+    }
+}
+
 // Loads datasource_indexes from .datasource_indexes into memory
 // Needs to be called after readElementCount() to get the correct offset in the stream
 inline void readDatasourceIndexes(io::FileReader &datasource_indexes_file,
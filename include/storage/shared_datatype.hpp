@@ -2,9 +2,11 @@
 #define SHARED_DATA_TYPE_HPP
 
 #include "util/exception.hpp"
+#include "util/fingerprint.hpp"
 #include "util/simple_logger.hpp"
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace osrm
@@ -22,12 +24,14 @@ const constexpr char *block_id_to_name[] = {"NAME_OFFSETS",
                                             "VIA_NODE_LIST",
                                             "GRAPH_NODE_LIST",
                                             "GRAPH_EDGE_LIST",
+                                            "GRAPH_EDGE_UNPACKING_LIST",
                                             "COORDINATE_LIST",
                                             "OSM_NODE_ID_LIST",
                                             "TURN_INSTRUCTION",
                                             "TRAVEL_MODE",
                                             "ENTRY_CLASSID",
                                             "R_SEARCH_TREE",
+                                            "R_TREE_LEAVES",
                                             "GEOMETRIES_INDEX",
                                             "GEOMETRIES_NODE_LIST",
                                             "GEOMETRIES_FWD_WEIGHT_LIST",
@@ -64,12 +68,14 @@ struct DataLayout
         VIA_NODE_LIST,
         GRAPH_NODE_LIST,
         GRAPH_EDGE_LIST,
+        GRAPH_EDGE_UNPACKING_LIST,
         COORDINATE_LIST,
         OSM_NODE_ID_LIST,
         TURN_INSTRUCTION,
         TRAVEL_MODE,
         ENTRY_CLASSID,
         R_SEARCH_TREE,
+        R_TREE_LEAVES,
         GEOMETRIES_INDEX,
         GEOMETRIES_NODE_LIST,
         GEOMETRIES_FWD_WEIGHT_LIST,
@@ -189,6 +195,25 @@ struct DataLayout
     }
 };
 
+// Version of the DataLayout stored in memory images, has to be increased whenever the content
+// of a block changes. Added or removed blocks are detected by the number of blocks.
+const constexpr std::uint32_t MEMORY_IMAGE_LAYOUT_VERSION = 1;
+
+// Header of a memory image written by Storage::WriteMemoryImage. The data block follows at
+// data_offset, a multiple of the page size, so the file can be mapped and used in place.
+struct MemoryImageHeader
+{
+    util::FingerPrint fingerprint;
+    std::uint32_t layout_version;
+    std::uint32_t number_of_blocks;
+    std::uint64_t data_offset;
+    DataLayout layout;
+};
+// the header is read field by field, so there must not be any padding before the layout
+static_assert(offsetof(MemoryImageHeader, layout) ==
+                  sizeof(util::FingerPrint) + 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t),
+              "MemoryImageHeader is not packed");
+
 enum SharedDataType
 {
     CURRENT_REGIONS,
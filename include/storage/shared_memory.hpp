@@ -1,6 +1,7 @@
 #ifndef SHARED_MEMORY_HPP
 #define SHARED_MEMORY_HPP
 
+#include "storage/huge_pages.hpp"
 #include "util/exception.hpp"
 #include "util/simple_logger.hpp"
 
@@ -18,8 +19,8 @@
 #include <sys/shm.h>
 #endif
 
-// #include <cstring>
 #include <cstdint>
+#include <cstring>
 
 #include <algorithm>
 #include <exception>
@@ -52,7 +53,8 @@ class SharedMemory
     SharedMemory(const boost::filesystem::path &lock_file,
                  const IdentifierT id,
                  const uint64_t size = 0,
-                 bool read_write = false)
+                 bool read_write = false,
+                 const HugePages huge_pages = HugePages::None)
         : key(lock_file.string().c_str(), id)
     {
         const auto access =
@@ -70,6 +72,17 @@ class SharedMemory
         // open or create
         else
         {
+#ifdef __linux__
+            // the segment is created on huge pages up front, opening it below then finds it
+            if (huge_pages == HugePages::Explicit &&
+                -1 == shmget(key.get_key(), roundToHugePages(size), IPC_CREAT | 0644 | SHM_HUGETLB))
+            {
+                util::SimpleLogger().Write(logWARNING)
+                    << "could not create shared memory on huge pages, is vm.nr_hugepages large "
+                       "enough? "
+                    << std::strerror(errno);
+            }
+#endif
             shm = boost::interprocess::xsi_shared_memory(
                 boost::interprocess::open_or_create, key, size);
             util::SimpleLogger().Write(logDEBUG) << "opening/creating " << shm.get_shmid()
@@ -84,6 +97,10 @@ class SharedMemory
             }
 #endif
             region = boost::interprocess::mapped_region(shm, access);
+            if (huge_pages == HugePages::Transparent)
+            {
+                adviseHugePages(region.get_address(), region.get_size());
+            }
         }
     }
 
@@ -154,7 +171,8 @@ class SharedMemory
     SharedMemory(const boost::filesystem::path &lock_file,
                  const int id,
                  const uint64_t size = 0,
-                 bool read_write = false)
+                 bool read_write = false,
+                 const HugePages huge_pages = HugePages::None)
     {
         sprintf(key, "%s.%d", "osrm.lock", id);
         auto access = read_write ? boost::interprocess::read_write : boost::interprocess::read_only;
@@ -172,6 +190,10 @@ class SharedMemory
                 boost::interprocess::open_or_create, key, boost::interprocess::read_write);
             shm.truncate(size);
             region = boost::interprocess::mapped_region(shm, access);
+            if (huge_pages != HugePages::None)
+            {
+                util::SimpleLogger().Write(logWARNING) << "huge pages are not supported";
+            }
 
             util::SimpleLogger().Write(logDEBUG) << "writeable memory allocated " << size
                                                  << " bytes";
@@ -233,7 +255,10 @@ class SharedMemory
 
 template <typename IdentifierT, typename LockFileT = OSRMLockFile>
 std::unique_ptr<SharedMemory>
-makeSharedMemory(const IdentifierT &id, const uint64_t size = 0, bool read_write = false)
+makeSharedMemory(const IdentifierT &id,
+                 const uint64_t size = 0,
+                 bool read_write = false,
+                 const HugePages huge_pages = HugePages::None)
 {
     try
     {
@@ -249,7 +274,7 @@ makeSharedMemory(const IdentifierT &id, const uint64_t size = 0, bool read_write
                 boost::filesystem::ofstream ofs(lock_file());
             }
         }
-        return std::make_unique<SharedMemory>(lock_file(), id, size, read_write);
+        return std::make_unique<SharedMemory>(lock_file(), id, size, read_write, huge_pages);
     }
     catch (const boost::interprocess::interprocess_exception &e)
     {
@@ -28,6 +28,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef STORAGE_HPP
 #define STORAGE_HPP
 
+#include "storage/huge_pages.hpp"
 #include "storage/shared_datatype.hpp"
 #include "storage/storage_config.hpp"
 
@@ -42,7 +43,9 @@ namespace storage
 class Storage
 {
   public:
-    Storage(StorageConfig config);
+    // With load_rtree_leaves the r-tree leaves are copied into the data block instead of being
+    // mapped from the leaf node file by every process.
+    Storage(StorageConfig config, const bool load_rtree_leaves = false);
 
     enum ReturnCode
     {
@@ -51,13 +54,19 @@ class Storage
         Retry
     };
 
-    ReturnCode Run(int max_wait);
+    ReturnCode Run(int max_wait, const HugePages huge_pages);
 
     void PopulateLayout(DataLayout &layout);
     void PopulateData(const DataLayout &layout, char *memory_ptr);
 
+    // The memory image holds the layout and the populated data block in a single file that can
+    // be mapped read-only, see MemoryImageHeader. It is only valid if newer than all data files.
+    bool IsMemoryImageValid() const;
+    void WriteMemoryImage();
+
   private:
     StorageConfig config;
+    bool load_rtree_leaves;
 };
 }
 }
@@ -67,6 +67,8 @@ struct StorageConfig final
     boost::filesystem::path intersection_class_path;
     boost::filesystem::path turn_lane_data_path;
     boost::filesystem::path turn_lane_description_path;
+    // generated on demand from the files above, see Storage::WriteMemoryImage
+    boost::filesystem::path memory_image_path;
 };
 }
 }
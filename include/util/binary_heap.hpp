@@ -4,6 +4,7 @@
 #include <boost/assert.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <type_traits>
@@ -32,6 +33,45 @@ template <typename NodeID, typename Key> class ArrayStorage
     std::vector<Key> positions;
 };
 
+// Array storage that is cleared in constant time: every entry remembers the generation it was
+// written in and entries of older generations read as not inserted.
+template <typename NodeID, typename Key> class TimestampedArrayStorage
+{
+  public:
+    explicit TimestampedArrayStorage(size_t size) : positions(size, 0), timestamps(size, 0) {}
+
+    Key &operator[](NodeID node)
+    {
+        timestamps[node] = current_timestamp;
+        return positions[node];
+    }
+
+    Key peek_index(const NodeID node) const
+    {
+        if (timestamps[node] != current_timestamp)
+        {
+            return std::numeric_limits<Key>::max();
+        }
+        return positions[node];
+    }
+
+    void Clear()
+    {
+        ++current_timestamp;
+        // on overflow stale entries could alias the new generation, reset them explicitly
+        if (current_timestamp == 0)
+        {
+            std::fill(timestamps.begin(), timestamps.end(), 0);
+            current_timestamp = 1;
+        }
+    }
+
+  private:
+    std::vector<Key> positions;
+    std::vector<std::uint32_t> timestamps;
+    std::uint32_t current_timestamp = 1;
+};
+
 template <typename NodeID, typename Key> class MapStorage
 {
   public:
@@ -84,22 +124,29 @@ template <typename NodeID, typename Key> class UnorderedMapStorage
     std::unordered_map<NodeID, Key> nodes;
 };
 
+// Priority queue over node ids with an implicit d-ary tree of the given arity. The root is at
+// index 1, index 0 holds a sentinel with the smallest possible weight.
 template <typename NodeID,
           typename Key,
           typename Weight,
           typename Data,
-          typename IndexStorage = ArrayStorage<NodeID, NodeID>>
-class BinaryHeap
+          typename IndexStorage = ArrayStorage<NodeID, NodeID>,
+          unsigned Arity = 2>
+class DAryHeap
 {
+    static_assert(Arity >= 2, "a heap needs at least two children per node");
+
   private:
-    BinaryHeap(const BinaryHeap &right);
-    void operator=(const BinaryHeap &right);
+    DAryHeap(const DAryHeap &right);
+    void operator=(const DAryHeap &right);
 
   public:
     using WeightType = Weight;
     using DataType = Data;
 
-    explicit BinaryHeap(size_t maxID) : node_index(maxID) { Clear(); }
+    explicit DAryHeap(size_t maxID) : max_id(maxID), node_index(maxID) { Clear(); }
+
+    std::size_t MaxID() const { return max_id; }
 
     void Clear()
     {
@@ -144,6 +191,12 @@ class BinaryHeap
         return inserted_nodes[index].weight;
     }
 
+    Weight const &GetKey(NodeID node) const
+    {
+        const Key index = node_index.peek_index(node);
+        return inserted_nodes[index].weight;
+    }
+
     bool WasRemoved(const NodeID node) const
     {
         BOOST_ASSERT(WasInserted(node));
@@ -231,22 +284,31 @@ class BinaryHeap
         Weight weight;
     };
 
+    std::size_t max_id;
     std::vector<HeapNode> inserted_nodes;
     std::vector<HeapElement> heap;
     IndexStorage node_index;
 
+    static Key FirstChild(const Key key) { return Arity * key - Arity + 2; }
+
+    static Key Parent(const Key key) { return (key + Arity - 2) / Arity; }
+
     void Downheap(Key key)
     {
         const Key droppingIndex = heap[key].index;
         const Weight weight = heap[key].weight;
         const Key heap_size = static_cast<Key>(heap.size());
-        Key nextKey = key << 1;
+        Key nextKey = FirstChild(key);
         while (nextKey < heap_size)
         {
-            const Key nextKeyOther = nextKey + 1;
-            if ((nextKeyOther < heap_size) && (heap[nextKey].weight > heap[nextKeyOther].weight))
+            // pick the smallest of the children
+            const Key lastKey = std::min<Key>(nextKey + Arity, heap_size);
+            for (Key nextKeyOther = nextKey + 1; nextKeyOther < lastKey; ++nextKeyOther)
             {
-                nextKey = nextKeyOther;
+                if (heap[nextKey].weight > heap[nextKeyOther].weight)
+                {
+                    nextKey = nextKeyOther;
+                }
             }
             if (weight <= heap[nextKey].weight)
             {
@@ -255,7 +317,7 @@ class BinaryHeap
             heap[key] = heap[nextKey];
             inserted_nodes[heap[key].index].key = key;
             key = nextKey;
-            nextKey <<= 1;
+            nextKey = FirstChild(key);
         }
         heap[key].index = droppingIndex;
         heap[key].weight = weight;
@@ -266,14 +328,14 @@ class BinaryHeap
     {
         const Key risingIndex = heap[key].index;
         const Weight weight = heap[key].weight;
-        Key nextKey = key >> 1;
+        Key nextKey = Parent(key);
         while (heap[nextKey].weight > weight)
         {
             BOOST_ASSERT(nextKey != 0);
             heap[key] = heap[nextKey];
             inserted_nodes[heap[key].index].key = key;
             key = nextKey;
-            nextKey >>= 1;
+            nextKey = Parent(key);
         }
         heap[key].index = risingIndex;
         heap[key].weight = weight;
@@ -285,11 +347,18 @@ class BinaryHeap
 #ifndef NDEBUG
         for (std::size_t i = 2; i < heap.size(); ++i)
         {
-            BOOST_ASSERT(heap[i].weight >= heap[i >> 1].weight);
+            BOOST_ASSERT(heap[i].weight >= heap[Parent(i)].weight);
         }
 #endif
     }
 };
+
+template <typename NodeID,
+          typename Key,
+          typename Weight,
+          typename Data,
+          typename IndexStorage = ArrayStorage<NodeID, NodeID>>
+using BinaryHeap = DAryHeap<NodeID, Key, Weight, Data, IndexStorage, 2>;
 }
 }
 
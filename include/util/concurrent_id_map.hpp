@@ -0,0 +1,77 @@
+#ifndef CONCURRENT_ID_MAP_HPP
+#define CONCURRENT_ID_MAP_HPP
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#include <type_traits>
+#include <unordered_map>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * Assigns consecutive ids to keys in the order they are first seen, safe to be used from
+ * several threads. Lookups of known keys only take a shared lock so concurrent readers do not
+ * block each other once most keys are present.
+ *
+ * The underlying map is exposed for iteration once all threads are done.
+ */
+template <typename KeyType, typename ValueType, typename HashType = std::hash<KeyType>>
+struct ConcurrentIdMap
+{
+    static_assert(std::is_unsigned<ValueType>::value, "Only unsigned integer ids are supported.");
+
+    using ReaderLock = boost::shared_lock<boost::shared_mutex>;
+    using WriterLock = boost::unique_lock<boost::shared_mutex>;
+
+    ConcurrentIdMap() = default;
+
+    ConcurrentIdMap(ConcurrentIdMap &&other)
+    {
+        WriterLock other_lock(other.mutex);
+        data = std::move(other.data);
+    }
+
+    ConcurrentIdMap &operator=(ConcurrentIdMap &&other)
+    {
+        WriterLock lock(mutex);
+        WriterLock other_lock(other.mutex);
+        data = std::move(other.data);
+        return *this;
+    }
+
+    ValueType ConcurrentFindOrAdd(const KeyType &key)
+    {
+        {
+            ReaderLock lock(mutex);
+            const auto result = data.find(key);
+            if (result != data.end())
+            {
+                return result->second;
+            }
+        }
+
+        WriterLock lock(mutex);
+        // another thread could have added the key while we waited for the lock
+        const auto result = data.find(key);
+        if (result != data.end())
+        {
+            return result->second;
+        }
+        const auto id = static_cast<ValueType>(data.size());
+        data.emplace(key, id);
+        return id;
+    }
+
+    std::unordered_map<KeyType, ValueType, HashType> data;
+
+  private:
+    mutable boost::shared_mutex mutex;
+};
+}
+}
+
+#endif // CONCURRENT_ID_MAP_HPP
@@ -3,7 +3,9 @@
 
 #include "osrm/coordinate.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace osrm
 {
@@ -12,6 +14,10 @@ namespace util
 
 // Computes a 64 bit value that corresponds to the hilbert space filling curve
 std::uint64_t hilbertCode(const Coordinate coordinate);
+
+// Returns the indices of the coordinates ordered along the hilbert space filling curve, so
+// consecutive coordinates are close to each other
+std::vector<std::size_t> hilbertOrder(const std::vector<Coordinate> &coordinates);
 }
 }
 
@@ -9,6 +9,8 @@
 
 #include "osrm/json_container.hpp"
 
+#include <cmath>
+#include <cstdint>
 #include <iterator>
 #include <ostream>
 #include <string>
@@ -21,6 +23,56 @@ namespace util
 namespace json
 {
 
+// Appends the number as cast::to_string_with_precision formats it, i.e. with at most six decimals
+// and without trailing zeros, but without going through a string stream.
+inline void appendNumber(std::vector<char> &out, const double value)
+{
+    // beyond this the scaled value is not exact anymore, leave these to the stream
+    constexpr double MAX_FAST_VALUE = 1e9;
+    if (!std::isfinite(value) || std::abs(value) >= MAX_FAST_VALUE)
+    {
+        const std::string number_string = cast::to_string_with_precision(value);
+        out.insert(out.end(), number_string.begin(), number_string.end());
+        return;
+    }
+
+    const auto scaled = std::llround(value * 1e6);
+    auto magnitude = static_cast<std::uint64_t>(scaled < 0 ? -scaled : scaled);
+    auto integral = magnitude / 1000000;
+    auto fraction = magnitude % 1000000;
+
+    // digits are written back to front
+    char buffer[24];
+    char *const end = buffer + sizeof(buffer);
+    char *begin = end;
+    if (fraction != 0)
+    {
+        int digits = 6;
+        while (fraction % 10 == 0)
+        {
+            fraction /= 10;
+            --digits;
+        }
+        for (; digits > 0; --digits)
+        {
+            *--begin = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        *--begin = '.';
+    }
+    do
+    {
+        *--begin = static_cast<char>('0' + integral % 10);
+        integral /= 10;
+    } while (integral != 0);
+    // the stream keeps the sign of values that round to zero, e.g. -0.0 is written as -0
+    if (std::signbit(value))
+    {
+        *--begin = '-';
+    }
+    out.insert(out.end(), begin, end);
+}
+
 struct Renderer
 {
     explicit Renderer(std::ostream &_out) : out(_out) {}
@@ -89,11 +141,7 @@ struct ArrayRenderer
         out.push_back('\"');
     }
 
-    void operator()(const Number &number) const
-    {
-        const std::string number_string = cast::to_string_with_precision(number.value);
-        out.insert(out.end(), number_string.begin(), number_string.end());
-    }
+    void operator()(const Number &number) const { appendNumber(out, number.value); }
 
     void operator()(const Object &object) const
     {
@@ -0,0 +1,134 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include "util/json_renderer.hpp"
+#include "util/string_util.hpp"
+
+#include "osrm/json_container.hpp"
+
+#include <boost/assert.hpp>
+
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+namespace json
+{
+
+// Streams a JSON document into a buffer as it is produced, for responses that are too large to
+// be built as a json::Object first. Separators are inserted automatically:
+//
+//   Writer writer(buffer);
+//   writer.StartObject();
+//   writer.Key("durations");
+//   writer.StartArray();
+//   writer.Number(1.5);
+//   writer.EndArray();
+//   writer.EndObject();
+class Writer
+{
+  public:
+    explicit Writer(std::vector<char> &out_) : out(out_), after_key(false) {}
+
+    void StartObject()
+    {
+        Separate();
+        out.push_back('{');
+        first_in_scope.push_back(true);
+    }
+
+    void EndObject()
+    {
+        BOOST_ASSERT(!first_in_scope.empty());
+        first_in_scope.pop_back();
+        out.push_back('}');
+    }
+
+    void StartArray()
+    {
+        Separate();
+        out.push_back('[');
+        first_in_scope.push_back(true);
+    }
+
+    void EndArray()
+    {
+        BOOST_ASSERT(!first_in_scope.empty());
+        first_in_scope.pop_back();
+        out.push_back(']');
+    }
+
+    // Keys are not escaped, same as in the renderers.
+    void Key(const std::string &key)
+    {
+        Separate();
+        out.push_back('\"');
+        out.insert(out.end(), key.begin(), key.end());
+        out.push_back('\"');
+        out.push_back(':');
+        after_key = true;
+    }
+
+    void String(const std::string &string)
+    {
+        Separate();
+        out.push_back('\"');
+        const auto escaped = escape_JSON(string);
+        out.insert(out.end(), escaped.begin(), escaped.end());
+        out.push_back('\"');
+    }
+
+    void Number(const double number)
+    {
+        Separate();
+        appendNumber(out, number);
+    }
+
+    void Null()
+    {
+        Separate();
+        const std::string null("null");
+        out.insert(out.end(), null.begin(), null.end());
+    }
+
+    // Renders a value of the json container, for small parts of a response.
+    void Value(const json::Value &value)
+    {
+        Separate();
+        mapbox::util::apply_visitor(ArrayRenderer(out), value);
+    }
+
+    // Reserves space for the expected size of the document.
+    void Reserve(const std::size_t bytes) { out.reserve(out.size() + bytes); }
+
+  private:
+    void Separate()
+    {
+        if (after_key)
+        {
+            after_key = false;
+            return;
+        }
+        if (!first_in_scope.empty())
+        {
+            if (!first_in_scope.back())
+            {
+                out.push_back(',');
+            }
+            first_in_scope.back() = false;
+        }
+    }
+
+    std::vector<char> &out;
+    std::vector<bool> first_in_scope;
+    bool after_key;
+};
+
+} // namespace json
+} // namespace util
+} // namespace osrm
+
+#endif // JSON_WRITER_HPP
@@ -0,0 +1,64 @@
+#ifndef OSRM_UTIL_RTREE_KERNELS_HPP
+#define OSRM_UTIL_RTREE_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace osrm
+{
+namespace util
+{
+namespace rtree_kernels
+{
+
+// Instruction sets the kernels are implemented for. The best one supported by the CPU is picked
+// on first use, Scalar is used on other platforms.
+enum class SIMDLevel
+{
+    Scalar,
+    SSE,
+    AVX2
+};
+
+// The best level supported by the CPU
+SIMDLevel detectSIMDLevel();
+
+// The level the kernels currently use
+SIMDLevel getSIMDLevel();
+
+// Forces a level, for benchmarks and tests. Levels the CPU does not support fall back to the
+// best supported one, the level that is used is returned.
+SIMDLevel setSIMDLevel(const SIMDLevel level);
+
+std::string toString(const SIMDLevel level);
+
+// Computes the squared euclidean distances from the point (lon, lat) to `count` rectangles given
+// as structure of arrays, 0 for rectangles containing the point. The results are identical to
+// RectangleInt2D::GetMinSquaredDist.
+void minSquaredDistances(const std::int32_t *min_lon,
+                         const std::int32_t *max_lon,
+                         const std::int32_t *min_lat,
+                         const std::int32_t *max_lat,
+                         const std::size_t count,
+                         const std::int32_t lon,
+                         const std::int32_t lat,
+                         std::uint64_t *squared_distances);
+
+// Projects the point (lon, lat) onto `count` segments given as structure of arrays and stores the
+// nearest point on each segment. The results are identical to
+// coordinate_calculation::projectPointOnSegment.
+void projectOnSegments(const double *source_lon,
+                       const double *source_lat,
+                       const double *target_lon,
+                       const double *target_lat,
+                       const std::size_t count,
+                       const double lon,
+                       const double lat,
+                       double *nearest_lon,
+                       double *nearest_lat);
+}
+}
+}
+
+#endif // OSRM_UTIL_RTREE_KERNELS_HPP
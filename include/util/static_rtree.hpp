@@ -1,6 +1,7 @@
 #ifndef STATIC_RTREE_HPP
 #define STATIC_RTREE_HPP
 
+#include "storage/huge_pages.hpp"
 #include "storage/io.hpp"
 #include "util/bearing.hpp"
 #include "util/coordinate_calculation.hpp"
@@ -9,6 +10,7 @@
 #include "util/hilbert_value.hpp"
 #include "util/integer_range.hpp"
 #include "util/rectangle.hpp"
+#include "util/rtree_kernels.hpp"
 #include "util/shared_memory_vector_wrapper.hpp"
 #include "util/typedefs.hpp"
 #include "util/web_mercator.hpp"
@@ -83,10 +85,33 @@ class StaticRTree
 
     struct TreeNode
     {
-        TreeNode() : child_count(0) {}
+        TreeNode()
+            : child_count(0), children(), child_min_lon(), child_max_lon(), child_min_lat(),
+              child_max_lat()
+        {
+        }
+
+        void AddChild(const TreeIndex child, const Rectangle &child_rectangle)
+        {
+            BOOST_ASSERT(child_count < BRANCHING_FACTOR);
+            children[child_count] = child;
+            child_min_lon[child_count] = static_cast<std::int32_t>(child_rectangle.min_lon);
+            child_max_lon[child_count] = static_cast<std::int32_t>(child_rectangle.max_lon);
+            child_min_lat[child_count] = static_cast<std::int32_t>(child_rectangle.min_lat);
+            child_max_lat[child_count] = static_cast<std::int32_t>(child_rectangle.max_lat);
+            ++child_count;
+            minimum_bounding_rectangle.MergeBoundingBoxes(child_rectangle);
+        }
+
         std::uint32_t child_count;
         Rectangle minimum_bounding_rectangle;
         TreeIndex children[BRANCHING_FACTOR];
+        // bounding rectangles of the children as structure of arrays, so the distances to all of
+        // them are computed by one vectorized kernel without touching the children
+        std::int32_t child_min_lon[BRANCHING_FACTOR];
+        std::int32_t child_max_lon[BRANCHING_FACTOR];
+        std::int32_t child_min_lat[BRANCHING_FACTOR];
+        std::int32_t child_max_lat[BRANCHING_FACTOR];
     };
 
     struct ALIGNED(LEAF_PAGE_SIZE) LeafNode
@@ -255,11 +280,8 @@ class StaticRTree
                 }
 
                 // append the leaf node to the current tree node
-                current_node.child_count += 1;
-                current_node.children[leaf_index] =
-                    TreeIndex{node_index * BRANCHING_FACTOR + leaf_index, true};
-                current_node.minimum_bounding_rectangle.MergeBoundingBoxes(
-                    current_leaf.minimum_bounding_rectangle);
+                current_node.AddChild(TreeIndex{node_index * BRANCHING_FACTOR + leaf_index, true},
+                                      current_leaf.minimum_bounding_rectangle);
 
                 // write leaf_node to leaf node file
                 leaf_node_file.write((char *)&current_leaf, sizeof(current_leaf));
@@ -287,15 +309,10 @@ class StaticRTree
                     {
                         TreeNode &current_child_node =
                             tree_nodes_in_level[processed_tree_nodes_in_level];
-                        // add tree node to parent entry
-                        parent_node.children[current_child_node_index] =
-                            TreeIndex{m_search_tree.size(), false};
+                        // add tree node to parent entry and merge MBRs
+                        parent_node.AddChild(TreeIndex{m_search_tree.size(), false},
+                                             current_child_node.minimum_bounding_rectangle);
                         m_search_tree.emplace_back(current_child_node);
-                        // merge MBRs
-                        parent_node.minimum_bounding_rectangle.MergeBoundingBoxes(
-                            current_child_node.minimum_bounding_rectangle);
-                        // increase counters
-                        ++parent_node.child_count;
                         ++processed_tree_nodes_in_level;
                     }
                 }
@@ -366,6 +383,28 @@ class StaticRTree
         MapLeafNodesFile(leaf_file);
     }
 
+    // leaves that were loaded into memory, e.g. by osrm-datastore
+    explicit StaticRTree(TreeNode *tree_node_ptr,
+                         const uint64_t number_of_nodes,
+                         const LeafNode *leaf_node_ptr,
+                         const uint64_t number_of_leaves,
+                         const CoordinateListT &coordinate_list)
+        : m_search_tree(tree_node_ptr, number_of_nodes), m_coordinate_list(coordinate_list)
+    {
+        m_leaves.reset(leaf_node_ptr, number_of_leaves);
+    }
+
+    // Reads the mapped leaf node file ahead and touches all of its pages, so the first queries
+    // do not fault them in. Does nothing if the leaves are in memory.
+    void PrefetchLeaves() const
+    {
+        if (!m_leaves_region.is_open())
+            return;
+
+        storage::adviseWillNeed(m_leaves_region.data(), m_leaves_region.size());
+        storage::prefaultMemory(m_leaves_region.data(), m_leaves_region.size());
+    }
+
     void MapLeafNodesFile(const boost::filesystem::path &leaf_file)
     {
         // open leaf node file and return a pointer to the mapped leaves data
@@ -537,19 +576,37 @@ class StaticRTree
                          QueueT &traversal_queue) const
     {
         const LeafNode &current_leaf_node = m_leaves[leaf_id.index];
+        const auto object_count = current_leaf_node.object_count;
 
-        // current object represents a block on disk
-        for (const auto i : irange(0u, current_leaf_node.object_count))
+        // gather the projected segments as structure of arrays for the projection kernel
+        std::array<double, LEAF_NODE_SIZE> source_lon, source_lat, target_lon, target_lat;
+        for (const auto i : irange(0u, object_count))
         {
             const auto &current_edge = current_leaf_node.objects[i];
             const auto projected_u = web_mercator::fromWGS84(m_coordinate_list[current_edge.u]);
             const auto projected_v = web_mercator::fromWGS84(m_coordinate_list[current_edge.v]);
+            source_lon[i] = static_cast<double>(projected_u.lon);
+            source_lat[i] = static_cast<double>(projected_u.lat);
+            target_lon[i] = static_cast<double>(projected_v.lon);
+            target_lat[i] = static_cast<double>(projected_v.lat);
+        }
 
-            FloatCoordinate projected_nearest;
-            std::tie(std::ignore, projected_nearest) =
-                coordinate_calculation::projectPointOnSegment(
-                    projected_u, projected_v, projected_input_coordinate);
+        std::array<double, LEAF_NODE_SIZE> nearest_lon, nearest_lat;
+        rtree_kernels::projectOnSegments(source_lon.data(),
+                                         source_lat.data(),
+                                         target_lon.data(),
+                                         target_lat.data(),
+                                         object_count,
+                                         static_cast<double>(projected_input_coordinate.lon),
+                                         static_cast<double>(projected_input_coordinate.lat),
+                                         nearest_lon.data(),
+                                         nearest_lat.data());
 
+        // current object represents a block on disk
+        for (const auto i : irange(0u, object_count))
+        {
+            const FloatCoordinate projected_nearest{FloatLongitude{nearest_lon[i]},
+                                                    FloatLatitude{nearest_lat[i]}};
             const auto squared_distance = coordinate_calculation::squaredEuclideanDistance(
                 projected_input_coordinate_fixed, projected_nearest);
             // distance must be non-negative
@@ -565,15 +622,21 @@ class StaticRTree
                          QueueT &traversal_queue) const
     {
         const TreeNode &parent = m_search_tree[parent_id.index];
+
+        std::array<std::uint64_t, BRANCHING_FACTOR> squared_lower_bounds;
+        rtree_kernels::minSquaredDistances(
+            parent.child_min_lon,
+            parent.child_max_lon,
+            parent.child_min_lat,
+            parent.child_max_lat,
+            parent.child_count,
+            static_cast<std::int32_t>(fixed_projected_input_coordinate.lon),
+            static_cast<std::int32_t>(fixed_projected_input_coordinate.lat),
+            squared_lower_bounds.data());
+
         for (std::uint32_t i = 0; i < parent.child_count; ++i)
         {
-            const TreeIndex child_id = parent.children[i];
-            const auto &child_rectangle =
-                child_id.is_leaf ? m_leaves[child_id.index].minimum_bounding_rectangle
-                                 : m_search_tree[child_id.index].minimum_bounding_rectangle;
-            const auto squared_lower_bound_to_element =
-                child_rectangle.GetMinSquaredDist(fixed_projected_input_coordinate);
-            traversal_queue.push(QueryCandidate{squared_lower_bound_to_element, child_id});
+            traversal_queue.push(QueryCandidate{squared_lower_bounds[i], parent.children[i]});
         }
     }
 };
@@ -0,0 +1,34 @@
+#ifndef OSRM_BENCHMARKS_COORDINATES_HPP
+#define OSRM_BENCHMARKS_COORDINATES_HPP
+
+#include "extractor/query_node.hpp"
+#include "storage/io.hpp"
+#include "util/coordinate.hpp"
+
+#include <boost/filesystem/path.hpp>
+
+#include <vector>
+
+namespace osrm
+{
+namespace benchmarks
+{
+
+// Reads the coordinates of all nodes of a .osrm.nodes file to sample queries from
+inline std::vector<util::Coordinate> loadCoordinates(const boost::filesystem::path &nodes_file)
+{
+    storage::io::FileReader nodes_reader(nodes_file, storage::io::FileReader::HasNoFingerprint);
+
+    const auto coordinate_count = nodes_reader.ReadElementCount64();
+    std::vector<util::Coordinate> coords(coordinate_count);
+    for (auto &coordinate : coords)
+    {
+        const auto current_node = nodes_reader.ReadOne<extractor::QueryNode>();
+        coordinate = util::Coordinate(current_node.lon, current_node.lat);
+    }
+    return coords;
+}
+}
+}
+
+#endif
@@ -0,0 +1,238 @@
+#include "contractor/query_edge.hpp"
+#include "storage/io.hpp"
+#include "storage/storage_config.hpp"
+#include "util/binary_heap.hpp"
+#include "util/static_graph.hpp"
+#include "util/timing_util.hpp"
+#include "util/typedefs.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace benchmarks
+{
+
+// Choosen by a fair W20 dice roll (this value is completely arbitrary)
+constexpr unsigned RANDOM_SEED = 13;
+
+struct HeapData
+{
+    NodeID parent;
+    /* explicit */ HeapData(NodeID p) : parent(p) {}
+};
+
+// Implicit square grid graph with pseudo-random edge weights, large enough to have the id space
+// of a country-size dataset without needing to load one.
+class GridGraph
+{
+  public:
+    explicit GridGraph(std::uint32_t width) : width(width) {}
+
+    std::uint32_t GetNumberOfNodes() const { return width * width; }
+
+    template <typename Callback> void ForEachNeighbour(const NodeID node, Callback callback) const
+    {
+        const auto x = node % width;
+        const auto y = node / width;
+        if (x > 0)
+            callback(node - 1, Weight(node - 1, node));
+        if (x + 1 < width)
+            callback(node + 1, Weight(node, node + 1));
+        if (y > 0)
+            callback(node - width, Weight(node - width, node));
+        if (y + 1 < width)
+            callback(node + width, Weight(node, node + width));
+    }
+
+  private:
+    static int Weight(const NodeID from, const NodeID to)
+    {
+        return 1 + static_cast<int>((from * 2654435761u ^ to * 40503u) % 100);
+    }
+
+    std::uint32_t width;
+};
+
+// Forward edges of the contracted graph of a dataset, searches on it settle the upward search
+// space of a node like every CH query does.
+class QueryGraph
+{
+    using Graph = util::StaticGraph<contractor::QueryEdge::SearchData>;
+
+  public:
+    explicit QueryGraph(const storage::StorageConfig &config)
+    {
+        storage::io::FileReader hsgr_file(config.hsgr_data_path,
+                                          storage::io::FileReader::HasNoFingerprint);
+        const auto hsgr_header = storage::io::readHSGRHeader(hsgr_file);
+
+        std::vector<Graph::NodeArrayEntry> nodes(hsgr_header.number_of_nodes);
+        std::vector<Graph::EdgeArrayEntry> edges(hsgr_header.number_of_edges);
+        std::vector<contractor::QueryEdge::UnpackingData> unpacking_data(
+            hsgr_header.number_of_edges);
+        storage::io::readHSGR(hsgr_file,
+                              nodes.data(),
+                              hsgr_header.number_of_nodes,
+                              edges.data(),
+                              unpacking_data.data(),
+                              hsgr_header.number_of_edges);
+        graph = std::make_unique<Graph>(nodes, edges);
+    }
+
+    std::uint32_t GetNumberOfNodes() const { return graph->GetNumberOfNodes(); }
+
+    template <typename Callback> void ForEachNeighbour(const NodeID node, Callback callback) const
+    {
+        for (const auto edge : graph->GetAdjacentEdgeRange(node))
+        {
+            const auto &data = graph->GetEdgeData(edge);
+            if (data.forward)
+                callback(graph->GetTarget(edge), data.weight);
+        }
+    }
+
+  private:
+    std::unique_ptr<Graph> graph;
+};
+
+template <typename HeapT, typename GraphT>
+void benchmarkHeap(const GraphT &graph,
+                   const std::string &name,
+                   const unsigned num_searches,
+                   const unsigned settled_per_search)
+{
+    std::cout << "Running " << name << " with " << num_searches << " searches: " << std::flush;
+
+    std::mt19937 mt_rand(RANDOM_SEED);
+    std::uniform_int_distribution<NodeID> node_udist(0, graph.GetNumberOfNodes() - 1);
+
+    TIMER_START(construct);
+    HeapT heap(graph.GetNumberOfNodes());
+    TIMER_STOP(construct);
+
+    std::uint64_t checksum = 0;
+    TIMER_START(search);
+    for (unsigned search = 0; search < num_searches; ++search)
+    {
+        heap.Clear();
+        const auto source = node_udist(mt_rand);
+        heap.Insert(source, 0, source);
+
+        unsigned settled = 0;
+        while (!heap.Empty() && settled++ < settled_per_search)
+        {
+            const auto node = heap.DeleteMin();
+            const auto weight = heap.GetKey(node);
+            checksum += weight;
+            graph.ForEachNeighbour(node, [&](const NodeID to, const int edge_weight) {
+                const auto to_weight = weight + edge_weight;
+                if (!heap.WasInserted(to))
+                {
+                    heap.Insert(to, to_weight, node);
+                }
+                else if (to_weight < heap.GetKey(to))
+                {
+                    heap.GetData(to).parent = node;
+                    heap.DecreaseKey(to, to_weight);
+                }
+            });
+        }
+    }
+    TIMER_STOP(search);
+
+    std::cout << "construction " << TIMER_MSEC(construct) << "ms, "
+              << TIMER_MSEC(search) / num_searches << " ms/search (checksum " << checksum << ")"
+              << std::endl;
+}
+
+template <typename GraphT>
+void benchmark(const GraphT &graph, const unsigned num_searches, const unsigned settled_per_search)
+{
+    benchmarkHeap<
+        util::BinaryHeap<NodeID, NodeID, int, HeapData, util::UnorderedMapStorage<NodeID, int>>>(
+        graph, "binary heap, unordered map storage", num_searches, settled_per_search);
+    benchmarkHeap<util::BinaryHeap<NodeID,
+                                   NodeID,
+                                   int,
+                                   HeapData,
+                                   util::TimestampedArrayStorage<NodeID, int>>>(
+        graph, "binary heap, timestamped array storage", num_searches, settled_per_search);
+    benchmarkHeap<util::DAryHeap<NodeID,
+                                 NodeID,
+                                 int,
+                                 HeapData,
+                                 util::UnorderedMapStorage<NodeID, int>,
+                                 4>>(
+        graph, "4-ary heap, unordered map storage", num_searches, settled_per_search);
+    benchmarkHeap<util::DAryHeap<NodeID,
+                                 NodeID,
+                                 int,
+                                 HeapData,
+                                 util::TimestampedArrayStorage<NodeID, int>,
+                                 4>>(
+        graph, "4-ary heap, timestamped array storage", num_searches, settled_per_search);
+}
+}
+}
+
+// Runs Dijkstra searches with every heap variant, either on an implicit grid graph or on the
+// contracted graph of a dataset given by its .osrm base path.
+int main(int argc, char **argv) try
+{
+    if (argc > 4)
+    {
+        std::cout << "./heap-bench [grid width] [searches] [settled nodes per search]\n"
+                  << "./heap-bench data.osrm [searches]"
+                  << "\n";
+        return 1;
+    }
+
+    using namespace osrm;
+
+    const bool use_dataset =
+        argc > 1 && !std::all_of(argv[1], argv[1] + std::strlen(argv[1]), [](const char c) {
+            return std::isdigit(static_cast<unsigned char>(c));
+        });
+    if (use_dataset)
+    {
+        const unsigned num_searches = argc > 2 ? std::stoul(argv[2]) : 10000;
+
+        const benchmarks::QueryGraph graph{storage::StorageConfig{argv[1]}};
+        std::cout << "Query graph of " << argv[1] << " with " << graph.GetNumberOfNodes()
+                  << " nodes, settling the upward search spaces" << std::endl;
+
+        benchmarks::benchmark(graph, num_searches, std::numeric_limits<unsigned>::max());
+        return 0;
+    }
+
+    // defaults to 16M nodes, the size of the edge-based graph of a larger country
+    const std::uint32_t grid_width = argc > 1 ? std::stoul(argv[1]) : 4096;
+    const unsigned num_searches = argc > 2 ? std::stoul(argv[2]) : 1000;
+    const unsigned settled_per_search = argc > 3 ? std::stoul(argv[3]) : 20000;
+
+    const benchmarks::GridGraph graph(grid_width);
+    std::cout << "Grid graph with " << graph.GetNumberOfNodes() << " nodes, settling "
+              << settled_per_search << " nodes per search" << std::endl;
+
+    benchmarks::benchmark(graph, num_searches, settled_per_search);
+
+    return 0;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
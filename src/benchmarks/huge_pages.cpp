@@ -0,0 +1,243 @@
+#include "coordinates.hpp"
+#include "storage/huge_pages.hpp"
+#include "util/timing_util.hpp"
+
+#include "osrm/route_parameters.hpp"
+#include "osrm/table_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <tbb/task_scheduler_init.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstdlib>
+
+namespace
+{
+
+// Choosen by a fair W20 dice roll (this value is completely arbitrary)
+constexpr unsigned RANDOM_SEED = 13;
+
+// Counts the dTLB load misses of the calling thread, if the kernel allows it
+class TLBMissCounter
+{
+  public:
+    TLBMissCounter()
+    {
+#ifdef __linux__
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.type = PERF_TYPE_HW_CACHE;
+        attributes.size = sizeof(attributes);
+        attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        descriptor = static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+    }
+
+    ~TLBMissCounter()
+    {
+#ifdef __linux__
+        if (IsAvailable())
+            close(descriptor);
+#endif
+    }
+
+    bool IsAvailable() const { return descriptor != -1; }
+
+    void Start()
+    {
+#ifdef __linux__
+        if (!IsAvailable())
+            return;
+        ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    std::uint64_t Stop()
+    {
+        std::uint64_t count = 0;
+#ifdef __linux__
+        if (!IsAvailable())
+            return count;
+        ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(descriptor, &count, sizeof(count)) != sizeof(count))
+            count = 0;
+#endif
+        return count;
+    }
+
+  private:
+    int descriptor = -1;
+};
+
+// Failed queries (e.g. between disconnected components) are counted and reported, they still
+// touch the data and are part of the timings
+template <typename ParametersT, typename QueryT>
+void runWorkload(const std::string &name,
+                 const std::vector<ParametersT> &queries,
+                 TLBMissCounter &counter,
+                 QueryT query)
+{
+    std::size_t failed = 0;
+    counter.Start();
+    TIMER_START(workload);
+    for (const auto &params : queries)
+    {
+        osrm::json::Object result;
+        if (query(params, result) != osrm::Status::Ok)
+        {
+            ++failed;
+        }
+    }
+    TIMER_STOP(workload);
+    const auto misses = counter.Stop();
+
+    std::cout << "  " << name << ": " << (TIMER_MSEC(workload) / queries.size()) << "ms/req";
+    if (counter.IsAvailable())
+    {
+        std::cout << ", " << (misses / queries.size()) << " dTLB misses/req";
+    }
+    if (failed > 0)
+    {
+        std::cout << ", " << failed << "/" << queries.size() << " failed";
+    }
+    std::cout << std::endl;
+}
+
+void runWorkloads(osrm::EngineConfig &config,
+                  const std::vector<osrm::RouteParameters> &route_queries,
+                  const std::vector<osrm::TableParameters> &table_queries,
+                  TLBMissCounter &counter)
+{
+    using namespace osrm;
+
+    OSRM osrm{config};
+
+    runWorkload("route",
+                route_queries,
+                counter,
+                [&](const RouteParameters &params, json::Object &result) {
+                    return osrm.Route(params, result);
+                });
+    runWorkload("table 100x100",
+                table_queries,
+                counter,
+                [&](const TableParameters &params, json::Object &result) {
+                    return osrm.Table(params, result);
+                });
+}
+}
+
+// Compares /route and /table queries on data loaded into normal pages, transparent huge pages
+// and explicit huge pages. Queries run on a single thread so the dTLB misses of the whole query
+// are counted, this needs perf events to be allowed (kernel.perf_event_paranoid <= 2).
+//
+// With "shared" the queries run once on the data osrm-datastore loaded into shared memory
+// instead, run it after each of osrm-datastore --huge-pages none, transparent and explicit.
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [queries] [shared]\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    const auto number_of_queries = argc > 2 ? std::stoi(argv[2]) : 1000;
+    const auto use_shared_memory = argc > 3 && std::string(argv[3]) == "shared";
+
+    tbb::task_scheduler_init init(1);
+
+    const storage::StorageConfig storage_config{argv[1]};
+    const auto coordinates = benchmarks::loadCoordinates(storage_config.nodes_data_path);
+    if (coordinates.empty())
+    {
+        std::cerr << "No coordinates found in " << storage_config.nodes_data_path << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 mt_rand(RANDOM_SEED);
+    std::uniform_int_distribution<std::size_t> coordinate_udist(0, coordinates.size() - 1);
+
+    std::vector<RouteParameters> route_queries(number_of_queries);
+    for (auto &params : route_queries)
+    {
+        params.overview = RouteParameters::OverviewType::False;
+        params.coordinates.push_back(coordinates[coordinate_udist(mt_rand)]);
+        params.coordinates.push_back(coordinates[coordinate_udist(mt_rand)]);
+    }
+
+    std::vector<TableParameters> table_queries(std::max(1, number_of_queries / 100));
+    for (auto &params : table_queries)
+    {
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            params.coordinates.push_back(coordinates[coordinate_udist(mt_rand)]);
+        }
+    }
+
+    TLBMissCounter counter;
+    if (!counter.IsAvailable())
+    {
+        std::cerr << "dTLB counters are not available, only reporting timings\n";
+    }
+
+    if (use_shared_memory)
+    {
+        // Configure to use the datasets in shared mem from osrm-datastore
+        EngineConfig config;
+        config.storage_config = storage_config;
+        config.use_shared_memory = true;
+
+        std::cout << "shared memory (huge pages as set by osrm-datastore):" << std::endl;
+        runWorkloads(config, route_queries, table_queries, counter);
+        return EXIT_SUCCESS;
+    }
+
+    for (const auto huge_pages : {storage::HugePages::None,
+                                  storage::HugePages::Transparent,
+                                  storage::HugePages::Explicit})
+    {
+        // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+        EngineConfig config;
+        config.storage_config = storage_config;
+        config.use_shared_memory = false;
+        config.huge_pages = huge_pages;
+
+        std::cout << "huge pages " << storage::toString(huge_pages) << ":" << std::endl;
+        runWorkloads(config, route_queries, table_queries, counter);
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
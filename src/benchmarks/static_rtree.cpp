@@ -1,16 +1,15 @@
 #include "util/static_rtree.hpp"
+#include "coordinates.hpp"
 #include "extractor/edge_based_node.hpp"
-#include "extractor/query_node.hpp"
 #include "mocks/mock_datafacade.hpp"
 #include "engine/geospatial_query.hpp"
 #include "util/coordinate.hpp"
+#include "util/rtree_kernels.hpp"
 #include "util/timing_util.hpp"
 
 #include <iostream>
 #include <random>
 
-#include <boost/filesystem/fstream.hpp>
-
 namespace osrm
 {
 namespace benchmarks
@@ -29,22 +28,6 @@ using RTreeLeaf = extractor::EdgeBasedNode;
 using BenchStaticRTree =
     util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, false>::vector, false>;
 
-std::vector<util::Coordinate> loadCoordinates(const boost::filesystem::path &nodes_file)
-{
-    boost::filesystem::ifstream nodes_input_stream(nodes_file, std::ios::binary);
-
-    extractor::QueryNode current_node;
-    unsigned coordinate_count = 0;
-    nodes_input_stream.read((char *)&coordinate_count, sizeof(unsigned));
-    std::vector<util::Coordinate> coords(coordinate_count);
-    for (unsigned i = 0; i < coordinate_count; ++i)
-    {
-        nodes_input_stream.read((char *)&current_node, sizeof(extractor::QueryNode));
-        coords[i] = util::Coordinate(current_node.lon, current_node.lat);
-    }
-    return coords;
-}
-
 template <typename QueryT>
 void benchmarkQuery(const std::vector<util::Coordinate> &queries,
                     const std::string &name,
@@ -63,7 +46,7 @@ void benchmarkQuery(const std::vector<util::Coordinate> &queries,
     std::cout << "Took " << TIMER_SEC(query) << " seconds "
               << "(" << TIMER_MSEC(query) << "ms"
               << ")  ->  " << TIMER_MSEC(query) / queries.size() << " ms/query "
-              << "(" << TIMER_MSEC(query) << "ms"
+              << "(" << TIMER_NSEC(query) / queries.size() << "ns/query"
               << ")" << std::endl;
 }
 
@@ -79,12 +62,26 @@ void benchmark(BenchStaticRTree &rtree, unsigned num_queries)
                              util::FixedLatitude{lat_udist(mt_rand)});
     }
 
-    benchmarkQuery(queries, "raw RTree queries (1 result)", [&rtree](const util::Coordinate &q) {
-        return rtree.Nearest(q, 1);
-    });
-    benchmarkQuery(queries, "raw RTree queries (10 results)", [&rtree](const util::Coordinate &q) {
-        return rtree.Nearest(q, 10);
-    });
+    // the scalar kernels give the baseline for the vectorized ones
+    using util::rtree_kernels::SIMDLevel;
+    for (const auto level : {SIMDLevel::Scalar, SIMDLevel::SSE, SIMDLevel::AVX2})
+    {
+        if (util::rtree_kernels::setSIMDLevel(level) != level)
+        {
+            std::cout << "Skipping " << util::rtree_kernels::toString(level)
+                      << " kernels, not supported by this CPU" << std::endl;
+            continue;
+        }
+
+        const auto kernels = " with " + util::rtree_kernels::toString(level) + " kernels";
+        benchmarkQuery(queries,
+                       "raw RTree queries (1 result)" + kernels,
+                       [&rtree](const util::Coordinate &q) { return rtree.Nearest(q, 1); });
+        benchmarkQuery(queries,
+                       "raw RTree queries (10 results)" + kernels,
+                       [&rtree](const util::Coordinate &q) { return rtree.Nearest(q, 10); });
+    }
+    util::rtree_kernels::setSIMDLevel(util::rtree_kernels::detectSIMDLevel());
 }
 }
 }
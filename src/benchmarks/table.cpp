@@ -0,0 +1,170 @@
+#include "coordinates.hpp"
+#include "engine/datafacade/process_memory_datafacade.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/many_to_many_buckets.hpp"
+#include "engine/search_engine_data.hpp"
+#include "storage/storage_config.hpp"
+#include "util/timing_util.hpp"
+
+#include "osrm/table_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstdlib>
+
+namespace
+{
+
+// Choosen by a fair W20 dice roll (this value is completely arbitrary)
+constexpr unsigned RANDOM_SEED = 13;
+
+// 2x2 tables on a large extract show per-request costs that do not shrink with the table, like
+// building the bucket store over search spaces reaching the top of the hierarchy
+constexpr std::size_t TABLE_SIZES[] = {2, 10, 100, 250, 500, 1000};
+
+// Times the many-to-many search with the given bucket store on the snapped coordinates, all
+// locations are sources and targets
+template <typename BucketStoreT>
+std::vector<EdgeWeight>
+benchmarkBucketStore(const std::string &name,
+                     const osrm::engine::datafacade::BaseDataFacade &facade,
+                     const std::vector<osrm::engine::PhantomNode> &phantom_nodes,
+                     const int repetitions)
+{
+    using namespace osrm::engine;
+
+    SearchEngineData heaps;
+    routing_algorithms::ManyToManyRouting<datafacade::BaseDataFacade, BucketStoreT> many_to_many(
+        heaps);
+
+    std::vector<EdgeWeight> table;
+    TIMER_START(tables);
+    for (int i = 0; i < repetitions; ++i)
+    {
+        table = many_to_many(facade, phantom_nodes, {}, {});
+    }
+    TIMER_STOP(tables);
+
+    std::cout << "  " << name << ": " << (TIMER_MSEC(tables) / repetitions) << "ms/table"
+              << std::endl;
+    return table;
+}
+}
+
+// Times square /table requests of increasing size on coordinates sampled from the extract.
+// Run it against builds of two revisions to compare changes of the many-to-many search. The
+// bucket stores of the many-to-many search are also compared directly on the same locations, use
+// a large extract to see the cost of small tables.
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [repetitions]\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    const auto repetitions = argc > 2 ? std::stoi(argv[2]) : 10;
+
+    const storage::StorageConfig storage_config{argv[1]};
+    const auto coordinates = benchmarks::loadCoordinates(storage_config.nodes_data_path);
+    if (coordinates.empty())
+    {
+        std::cerr << "No coordinates found in " << storage_config.nodes_data_path << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 mt_rand(RANDOM_SEED);
+    std::uniform_int_distribution<std::size_t> coordinate_udist(0, coordinates.size() - 1);
+
+    std::vector<std::vector<util::Coordinate>> table_coordinates;
+    for (const std::size_t size : TABLE_SIZES)
+    {
+        table_coordinates.emplace_back();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            table_coordinates.back().push_back(coordinates[coordinate_udist(mt_rand)]);
+        }
+    }
+
+    // the scope releases the data of the engine before the facade loads it again
+    {
+        // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+        EngineConfig config;
+        config.storage_config = storage_config;
+        config.use_shared_memory = false;
+
+        OSRM osrm{config};
+
+        std::cout << "/table requests:" << std::endl;
+        for (const auto &locations : table_coordinates)
+        {
+            const auto size = locations.size();
+            TableParameters params;
+            params.coordinates = locations;
+
+            TIMER_START(tables);
+            for (int i = 0; i < repetitions; ++i)
+            {
+                json::Object result;
+                const auto rc = osrm.Table(params, result);
+                if (rc != Status::Ok)
+                {
+                    return EXIT_FAILURE;
+                }
+            }
+            TIMER_STOP(tables);
+
+            std::cout << "  " << size << "x" << size << ": " << (TIMER_MSEC(tables) / repetitions)
+                      << "ms/req, "
+                      << (TIMER_MSEC(tables) / repetitions / (size * size) * 1000.) << "us/entry"
+                      << std::endl;
+        }
+    }
+
+    // Compares the bucket stores of the many-to-many search on the same snapped locations
+    const engine::datafacade::ProcessMemoryDataFacade facade(storage_config);
+    for (const auto &locations : table_coordinates)
+    {
+        std::vector<engine::PhantomNode> phantom_nodes;
+        for (const auto &location : locations)
+        {
+            phantom_nodes.push_back(
+                facade.NearestPhantomNodeWithAlternativeFromBigComponent(location).first);
+        }
+
+        std::cout << "buckets " << locations.size() << "x" << locations.size() << ":"
+                  << std::endl;
+        const auto sorted_table =
+            benchmarkBucketStore<engine::routing_algorithms::SortedBucketStore>(
+                "sorted array", facade, phantom_nodes, repetitions);
+        const auto indexed_table =
+            benchmarkBucketStore<engine::routing_algorithms::IndexedBucketStore>(
+                "offset index", facade, phantom_nodes, repetitions);
+        if (sorted_table != indexed_table)
+        {
+            std::cerr << "The bucket stores computed different tables\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,130 @@
+#include "engine/trip/trip_farthest_insertion.hpp"
+#include "engine/trip/trip_held_karp.hpp"
+#include "engine/trip/trip_local_search.hpp"
+#include "util/dist_table_wrapper.hpp"
+#include "util/timing_util.hpp"
+#include "util/typedefs.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace benchmarks
+{
+
+// Choosen by a fair W20 dice roll (this value is completely arbitrary)
+constexpr unsigned RANDOM_SEED = 13;
+
+// Asymmetric durations between random locations in a city, one-way streets and turn costs make
+// the way back differ from the way there
+util::DistTableWrapper<EdgeWeight> makeTable(const std::size_t number_of_locations)
+{
+    std::mt19937 mt_rand(RANDOM_SEED);
+    std::uniform_int_distribution<int> position_udist(0, 20000);
+    std::uniform_int_distribution<int> detour_udist(0, 2000);
+
+    std::vector<std::pair<int, int>> locations(number_of_locations);
+    for (auto &location : locations)
+    {
+        location = std::make_pair(position_udist(mt_rand), position_udist(mt_rand));
+    }
+
+    std::vector<EdgeWeight> table;
+    table.reserve(number_of_locations * number_of_locations);
+    for (const auto &from : locations)
+    {
+        for (const auto &to : locations)
+        {
+            const auto duration = std::abs(from.first - to.first) +
+                                  std::abs(from.second - to.second);
+            table.push_back(duration == 0 ? 0 : duration + detour_udist(mt_rand));
+        }
+    }
+    return util::DistTableWrapper<EdgeWeight>(std::move(table), number_of_locations);
+}
+
+std::int64_t tripDuration(const std::vector<NodeID> &route,
+                          const util::DistTableWrapper<EdgeWeight> &table)
+{
+    std::int64_t duration = 0;
+    for (std::size_t position = 0; position < route.size(); ++position)
+    {
+        duration += table(route[position], route[(position + 1) % route.size()]);
+    }
+    return duration;
+}
+
+template <typename Solver>
+void benchmarkSolver(const std::string &name,
+                     const std::size_t number_of_locations,
+                     const util::DistTableWrapper<EdgeWeight> &table,
+                     Solver solver)
+{
+    std::vector<NodeID> locations(number_of_locations);
+    std::iota(locations.begin(), locations.end(), 0);
+
+    TIMER_START(solve);
+    const auto route = solver(locations);
+    TIMER_STOP(solve);
+
+    std::cout << "  " << name << ": " << TIMER_MSEC(solve) << "ms, trip duration "
+              << tripDuration(route, table) << std::endl;
+}
+
+void benchmark(const std::size_t number_of_locations)
+{
+    std::cout << number_of_locations << " locations" << std::endl;
+    const auto table = makeTable(number_of_locations);
+
+    if (number_of_locations <= engine::trip::HELD_KARP_MAX_FEASABLE)
+    {
+        benchmarkSolver(
+            "held-karp", number_of_locations, table, [&](const std::vector<NodeID> &locations) {
+                return engine::trip::HeldKarpTrip(
+                    locations.begin(), locations.end(), number_of_locations, table);
+            });
+    }
+    benchmarkSolver("farthest insertion",
+                    number_of_locations,
+                    table,
+                    [&](const std::vector<NodeID> &locations) {
+                        return engine::trip::FarthestInsertionTrip(
+                            locations.begin(), locations.end(), number_of_locations, table);
+                    });
+    benchmarkSolver("farthest insertion + local search",
+                    number_of_locations,
+                    table,
+                    [&](const std::vector<NodeID> &locations) {
+                        auto route = engine::trip::FarthestInsertionTrip(
+                            locations.begin(), locations.end(), number_of_locations, table);
+                        engine::trip::ImproveTrip(route, table, std::chrono::seconds(1));
+                        return route;
+                    });
+}
+}
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        std::cout << "./trip-bench"
+                  << "\n";
+        return 1;
+    }
+
+    for (const std::size_t number_of_locations : {8, 10, 12, 16, 20, 50, 100})
+    {
+        osrm::benchmarks::benchmark(number_of_locations);
+    }
+
+    return 0;
+}
@@ -1,6 +1,8 @@
 #include "contractor/contractor.hpp"
 #include "contractor/crc32_processor.hpp"
 #include "contractor/graph_contractor.hpp"
+#include "contractor/graph_customizer.hpp"
+#include "contractor/node_renumbering.hpp"
 
 #include "extractor/compressed_edge_container.hpp"
 #include "extractor/edge_based_graph_factory.hpp"
@@ -19,6 +21,7 @@
 #include "util/typedefs.hpp"
 
 #include <boost/assert.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/interprocess/file_mapping.hpp>
@@ -40,6 +43,7 @@
 #include <fstream>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <thread>
 #include <tuple>
 #include <vector>
@@ -152,6 +156,33 @@ int Contractor::Run()
                                                config.rtree_leaf_path,
                                                config.log_edge_updates_factor);
 
+    // renumbering of the node ids of the previous run, the r-tree leaves still use it
+    const auto node_permutation = ReadNodePermutation(max_edge_id + 1);
+
+    if (config.update_weights_only)
+    {
+        TIMER_START(customization);
+        util::DeallocatingVector<QueryEdge> contracted_edge_list;
+        CustomizeGraph(edge_based_edge_list, node_permutation, contracted_edge_list);
+        TIMER_STOP(customization);
+
+        util::SimpleLogger().Write() << "Customization took " << TIMER_SEC(customization)
+                                     << " sec";
+
+        // the core markers and r-tree leaves are not rewritten, keep their renumbering
+        if (!node_permutation.empty())
+        {
+            renumberEdges(contracted_edge_list, node_permutation);
+        }
+
+        WriteContractedGraph(max_edge_id, contracted_edge_list);
+
+        TIMER_STOP(preparing);
+        util::SimpleLogger().Write() << "Preprocessing : " << TIMER_SEC(preparing) << " seconds";
+        util::SimpleLogger().Write() << "finished preprocessing";
+        return 0;
+    }
+
     // Contracting the edge-expanded graph
 
     TIMER_START(contraction);
@@ -184,6 +215,8 @@ int Contractor::Run()
 
     util::SimpleLogger().Write() << "Contraction took " << TIMER_SEC(contraction) << " sec";
 
+    RenumberNodes(max_edge_id + 1, node_permutation, contracted_edge_list, is_core_node);
+
     std::size_t number_of_used_edges = WriteContractedGraph(max_edge_id, contracted_edge_list);
     WriteCoreNodeMarker(std::move(is_core_node));
     if (!config.use_cached_priority)
@@ -944,6 +977,171 @@ void Contractor::ReadNodeLevels(std::vector<float> &node_levels) const
     order_input_stream.read((char *)node_levels.data(), sizeof(float) * node_levels.size());
 }
 
+/**
+ \brief Updates the weights of the existing .hsgr for the edge weights of this run.
+
+ The shortcuts, core and levels of the previous contraction are kept.
+ */
+void Contractor::CustomizeGraph(
+    const util::DeallocatingVector<extractor::EdgeBasedEdge> &edge_based_edge_list,
+    const std::vector<NodeID> &node_permutation,
+    util::DeallocatingVector<QueryEdge> &contracted_edge_list) const
+{
+    if (!boost::filesystem::exists(config.graph_output_path))
+    {
+        throw util::exception("Updating weights needs the " + config.graph_output_path +
+                              " of a previous contraction.");
+    }
+
+    util::SimpleLogger().Write() << "Loading hierarchy from " << config.graph_output_path;
+    storage::io::FileReader hsgr_file(config.graph_output_path,
+                                      storage::io::FileReader::HasNoFingerprint);
+    const auto hsgr_header = storage::io::readHSGRHeader(hsgr_file);
+    std::vector<storage::io::NodeT> node_array(hsgr_header.number_of_nodes);
+    std::vector<storage::io::EdgeT> edge_array(hsgr_header.number_of_edges);
+    storage::io::readHSGR(hsgr_file,
+                          node_array.data(),
+                          hsgr_header.number_of_nodes,
+                          edge_array.data(),
+                          hsgr_header.number_of_edges);
+
+    // the node array ends with at least one sentinel
+    BOOST_ASSERT(!node_array.empty());
+    const NodeID number_of_nodes = node_array.size() - 1;
+
+    std::vector<QueryEdge> hierarchy;
+    hierarchy.reserve(edge_array.size());
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+    {
+        for (const auto edge :
+             util::irange(node_array[node].first_edge, node_array[node + 1].first_edge))
+        {
+            hierarchy.emplace_back(node, edge_array[edge].target, edge_array[edge].data);
+        }
+    }
+    node_array.clear();
+    edge_array.clear();
+
+    // the edge-based edges use the original node ids
+    if (!node_permutation.empty())
+    {
+        renumberEdges(hierarchy, invertPermutation(node_permutation));
+    }
+
+    GraphCustomizer customizer(number_of_nodes, std::move(hierarchy));
+    customizer.Customize(edge_based_edge_list, contracted_edge_list);
+}
+
+std::vector<NodeID> Contractor::ReadNodePermutation(const std::size_t number_of_nodes) const
+{
+    std::vector<NodeID> node_permutation;
+    if (!boost::filesystem::exists(config.node_permutation_path))
+    {
+        return node_permutation;
+    }
+
+    storage::io::FileReader permutation_file(config.node_permutation_path,
+                                             storage::io::FileReader::VerifyFingerprint);
+    permutation_file.DeserializeVector(node_permutation);
+    if (node_permutation.size() != number_of_nodes)
+    {
+        throw util::exception(config.node_permutation_path + " does not belong to this dataset, "
+                                                              "run osrm-extract again.");
+    }
+    return node_permutation;
+}
+
+/**
+ * Renumbers the nodes of the hierarchy and the core markers if configured, and brings the
+ * r-tree leaves from the numbering of the previous run to the new one. The applied renumbering
+ * is written next to the r-tree so later runs know which ids the leaves use.
+ */
+void Contractor::RenumberNodes(const NodeID number_of_nodes,
+                               const std::vector<NodeID> &previous_permutation,
+                               util::DeallocatingVector<QueryEdge> &contracted_edge_list,
+                               std::vector<bool> &is_core_node) const
+{
+    std::vector<NodeID> node_permutation;
+    if (config.renumber_nodes)
+    {
+        TIMER_START(renumbering);
+        node_permutation = computeLocalityPermutation(number_of_nodes, contracted_edge_list);
+        renumberEdges(contracted_edge_list, node_permutation);
+        is_core_node = renumberNodeMarkers(is_core_node, node_permutation);
+        TIMER_STOP(renumbering);
+        util::SimpleLogger().Write() << "Renumbering nodes took " << TIMER_SEC(renumbering)
+                                     << " sec";
+    }
+
+    if (!previous_permutation.empty() || !node_permutation.empty())
+    {
+        std::vector<NodeID> leaf_node_mapping;
+        if (previous_permutation.empty())
+        {
+            leaf_node_mapping.resize(number_of_nodes);
+            std::iota(leaf_node_mapping.begin(), leaf_node_mapping.end(), 0);
+        }
+        else
+        {
+            leaf_node_mapping = invertPermutation(previous_permutation);
+        }
+
+        if (!node_permutation.empty())
+        {
+            for (auto &node : leaf_node_mapping)
+            {
+                node = node_permutation[node];
+            }
+        }
+        RenumberRTreeLeaves(leaf_node_mapping);
+    }
+
+    if (node_permutation.empty())
+    {
+        boost::filesystem::remove(config.node_permutation_path);
+    }
+    else if (!util::serializeVector(config.node_permutation_path, node_permutation))
+    {
+        throw util::exception("Could not write " + config.node_permutation_path);
+    }
+}
+
+void Contractor::RenumberRTreeLeaves(const std::vector<NodeID> &leaf_node_mapping) const
+{
+    util::SimpleLogger().Write() << "Renumbering nodes in " << config.rtree_leaf_path;
+
+    using LeafNode = util::StaticRTree<extractor::EdgeBasedNode>::LeafNode;
+    using boost::interprocess::file_mapping;
+    using boost::interprocess::mapped_region;
+    using boost::interprocess::read_write;
+
+    const file_mapping mapping{config.rtree_leaf_path.c_str(), read_write};
+    mapped_region region{mapping, read_write};
+
+    const auto first = static_cast<LeafNode *>(region.get_address());
+    const auto last = first + (region.get_size() / sizeof(LeafNode));
+
+    const auto renumber = [&leaf_node_mapping](SegmentID &segment) {
+        if (segment.id < leaf_node_mapping.size())
+        {
+            segment.id = leaf_node_mapping[segment.id];
+        }
+    };
+
+    tbb::parallel_for_each(first, last, [&](LeafNode &current_node) {
+        for (const auto i : util::irange<std::uint32_t>(0, current_node.object_count))
+        {
+            renumber(current_node.objects[i].forward_segment_id);
+            renumber(current_node.objects[i].reverse_segment_id);
+        }
+    });
+
+    if (!region.flush())
+    {
+        throw util::exception("Could not write " + config.rtree_leaf_path);
+    }
+}
+
 void Contractor::WriteNodeLevels(std::vector<float> &&in_node_levels) const
 {
     std::vector<float> node_levels(std::move(in_node_levels));
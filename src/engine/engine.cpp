@@ -3,6 +3,7 @@
 #include "engine/engine_config.hpp"
 #include "engine/status.hpp"
 
+#include "engine/datafacade/mmap_memory_datafacade.hpp"
 #include "engine/datafacade/process_memory_datafacade.hpp"
 #include "engine/datafacade/shared_memory_datafacade.hpp"
 
@@ -15,6 +16,7 @@
 #include <boost/interprocess/sync/sharable_lock.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <memory>
 #include <utility>
@@ -55,12 +57,27 @@ namespace engine
 Engine::Engine(const EngineConfig &config)
     : lock(config.use_shared_memory ? std::make_unique<storage::SharedBarriers>()
                                     : std::unique_ptr<storage::SharedBarriers>()),
-      route_plugin(config.max_locations_viaroute),       //
-      table_plugin(config.max_locations_distance_table), //
-      nearest_plugin(config.max_results_nearest),        //
-      trip_plugin(config.max_locations_trip),            //
-      match_plugin(config.max_locations_map_matching),   //
-      tile_plugin()                                      //
+      snapping_cache(config.snapping_cache_size > 0
+                         ? std::make_shared<SnappingCache>(config.snapping_cache_size)
+                         : nullptr),
+      matching_sessions(config.max_matching_sessions > 0
+                            ? std::make_shared<MatchingSessions>(
+                                  config.max_matching_sessions,
+                                  std::chrono::seconds(config.matching_session_timeout))
+                            : nullptr),
+      tile_cache(config.tile_cache_size > 0 ? std::make_shared<TileCache>(config.tile_cache_size)
+                                            : nullptr),
+      tile_archive(!config.tile_archive_path.empty()
+                       ? std::make_shared<const TileArchive>(config.tile_archive_path)
+                       : nullptr),
+      route_plugin(config.max_locations_viaroute, config.max_alternatives, snapping_cache),       //
+      table_plugin(config.max_locations_distance_table, snapping_cache), //
+      nearest_plugin(config.max_results_nearest),                        //
+      trip_plugin(config.max_locations_trip, snapping_cache),            //
+      match_plugin(config.max_locations_map_matching,
+                   config.max_traces_map_matching,
+                   matching_sessions),      //
+      tile_plugin(tile_cache, tile_archive) //
 
 {
     if (config.use_shared_memory)
@@ -80,8 +97,23 @@ Engine::Engine(const EngineConfig &config)
         {
             throw util::exception("Invalid file paths given!");
         }
-        immutable_data_facade =
-            std::make_shared<datafacade::ProcessMemoryDataFacade>(config.storage_config);
+        if (config.use_mmap)
+        {
+            immutable_data_facade = std::make_shared<datafacade::MMapMemoryDataFacade>(
+                config.storage_config, config.prefault_memory);
+        }
+        else
+        {
+            immutable_data_facade = std::make_shared<datafacade::ProcessMemoryDataFacade>(
+                config.storage_config, config.huge_pages, config.prefault_memory);
+        }
+    }
+
+    if (tile_archive && immutable_data_facade &&
+        tile_archive->GetCheckSum() != immutable_data_facade->GetCheckSum())
+    {
+        util::SimpleLogger().Write(logWARNING) << config.tile_archive_path.string()
+                                               << " was rendered from other data and is not used";
     }
 }
 
@@ -90,11 +122,26 @@ Status Engine::Route(const api::RouteParameters &params, util::json::Object &res
     return RunQuery(watchdog, immutable_data_facade, params, route_plugin, result);
 }
 
+Status Engine::Route(const api::RouteParameters &params, std::string &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, route_plugin, result);
+}
+
 Status Engine::Table(const api::TableParameters &params, util::json::Object &result) const
 {
     return RunQuery(watchdog, immutable_data_facade, params, table_plugin, result);
 }
 
+Status Engine::Table(const api::TableParameters &params, std::vector<char> &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, table_plugin, result);
+}
+
+Status Engine::Table(const api::TableParameters &params, std::string &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, table_plugin, result);
+}
+
 Status Engine::Nearest(const api::NearestParameters &params, util::json::Object &result) const
 {
     return RunQuery(watchdog, immutable_data_facade, params, nearest_plugin, result);
@@ -110,10 +157,21 @@ Status Engine::Match(const api::MatchParameters &params, util::json::Object &res
     return RunQuery(watchdog, immutable_data_facade, params, match_plugin, result);
 }
 
+Status Engine::Match(const std::vector<api::MatchParameters> &params,
+                     util::json::Object &result) const
+{
+    return RunQuery(watchdog, immutable_data_facade, params, match_plugin, result);
+}
+
 Status Engine::Tile(const api::TileParameters &params, std::string &result) const
 {
     return RunQuery(watchdog, immutable_data_facade, params, tile_plugin, result);
 }
 
+CacheStatistics Engine::GetSnappingCacheStatistics() const
+{
+    return snapping_cache ? snapping_cache->GetStatistics() : CacheStatistics{};
+}
+
 } // engine ns
 } // osrm ns
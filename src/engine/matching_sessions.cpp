@@ -0,0 +1,114 @@
+#include "engine/matching_sessions.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace osrm
+{
+namespace engine
+{
+
+void MatchingSessions::Session::Reset(const unsigned new_dataset_timestamp)
+{
+    dataset_timestamp = new_dataset_timestamp;
+    coordinates.clear();
+    timestamps.clear();
+    gps_precisions.clear();
+    candidates.clear();
+    state = routing_algorithms::MatchingState{};
+}
+
+void MatchingSessions::Session::DropUnusedPoints()
+{
+    BOOST_ASSERT(state.NumberOfPoints() <= coordinates.size());
+    const auto number_of_dropped = coordinates.size() - state.NumberOfPoints();
+
+    coordinates.erase(coordinates.begin(), coordinates.begin() + number_of_dropped);
+    gps_precisions.erase(gps_precisions.begin(), gps_precisions.begin() + number_of_dropped);
+    candidates.erase(candidates.begin(), candidates.begin() + number_of_dropped);
+    if (!timestamps.empty())
+    {
+        timestamps.erase(timestamps.begin(), timestamps.begin() + number_of_dropped);
+    }
+}
+
+MatchingSessions::MatchingSessions(const std::size_t capacity, const std::chrono::seconds timeout)
+    : capacity(std::max<std::size_t>(1, capacity)), timeout(timeout)
+{
+}
+
+std::pair<std::string, std::shared_ptr<MatchingSessions::Session>>
+MatchingSessions::Open(const Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    DropExpired(now);
+    if (entries.size() >= capacity)
+    {
+        index.erase(entries.back().id);
+        entries.pop_back();
+    }
+
+    auto id = MakeId();
+    while (index.count(id) > 0)
+    {
+        id = MakeId();
+    }
+    entries.push_front(Entry{id, std::make_shared<Session>(), now});
+    index.emplace(id, entries.begin());
+    return std::make_pair(std::move(id), entries.front().session);
+}
+
+std::shared_ptr<MatchingSessions::Session> MatchingSessions::Find(const std::string &id,
+                                                                  const Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    DropExpired(now);
+    const auto entry = index.find(id);
+    if (entry == index.end())
+    {
+        return nullptr;
+    }
+    entries.splice(entries.begin(), entries, entry->second);
+    entry->second->last_used = now;
+    return entry->second->session;
+}
+
+std::size_t MatchingSessions::Size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void MatchingSessions::DropExpired(const Clock::time_point now)
+{
+    // the least recently used sessions are at the back
+    while (!entries.empty() && now - entries.back().last_used > timeout)
+    {
+        index.erase(entries.back().id);
+        entries.pop_back();
+    }
+}
+
+std::string MatchingSessions::MakeId()
+{
+    static const constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+    // 128 bits as 32 hex digits
+    std::string id;
+    id.reserve(32);
+    for (int word = 0; word < 4; ++word)
+    {
+        std::uint32_t bits = random_device();
+        for (int digit = 0; digit < 8; ++digit, bits >>= 4)
+        {
+            id.push_back(HEX_DIGITS[bits & 0xf]);
+        }
+    }
+    return id;
+}
+}
+}
@@ -10,13 +10,18 @@
 #include "util/json_util.hpp"
 #include "util/string_util.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <cstdlib>
 
 #include <algorithm>
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 
 static double search_radius_for_gps_radius(double gps_radius) {
@@ -33,11 +38,14 @@ namespace engine
 namespace plugins
 {
 
-// Filters PhantomNodes to obtain a set of viable candiates
+// Filters PhantomNodes to obtain a set of viable candiates, the candidates before
+// first_coordinate are filtered already
 void filterCandidates(const std::vector<util::Coordinate> &coordinates,
-                      MatchPlugin::CandidateLists &candidates_lists)
+                      MatchPlugin::CandidateLists &candidates_lists,
+                      const std::size_t first_coordinate = 0)
 {
-    for (const auto current_coordinate : util::irange<std::size_t>(0, coordinates.size()))
+    for (const auto current_coordinate :
+         util::irange<std::size_t>(first_coordinate, coordinates.size()))
     {
         bool allow_uturn = false;
 
@@ -165,6 +173,11 @@ Status MatchPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFaca
                        });
     }
 
+    if (!parameters.session.empty())
+    {
+        return HandleSessionRequest(*facade, parameters, search_radiuses, json_result);
+    }
+
     auto candidates_lists = GetPhantomNodesInRange(*facade, parameters, search_radiuses);
 
     filterCandidates(parameters.coordinates, candidates_lists);
@@ -191,6 +204,122 @@ Status MatchPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFaca
         return Error("NoMatch", "Could not match the trace.", json_result);
     }
 
+    return MakeResponse(*facade, parameters, sub_matchings, json_result);
+}
+
+Status MatchPlugin::HandleSessionRequest(const datafacade::BaseDataFacade &facade,
+                                         const api::MatchParameters &parameters,
+                                         const std::vector<double> &search_radiuses,
+                                         util::json::Object &json_result) const
+{
+    if (!sessions)
+    {
+        return Error("InvalidOptions", "Online matching sessions are disabled", json_result);
+    }
+
+    std::string session_id;
+    std::shared_ptr<MatchingSessions::Session> session;
+    if (parameters.OpensSession())
+    {
+        std::tie(session_id, session) = sessions->Open();
+    }
+    else
+    {
+        session_id = parameters.session;
+        session = sessions->Find(session_id);
+        if (!session)
+        {
+            return Error("NoSession", "Unknown or expired matching session", json_result);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(session->mutex);
+    const auto status = MatchSession(facade, parameters, search_radiuses, *session, json_result);
+    json_result.values["session"] = session_id;
+    return status;
+}
+
+Status MatchPlugin::MatchSession(const datafacade::BaseDataFacade &facade,
+                                 const api::MatchParameters &parameters,
+                                 const std::vector<double> &search_radiuses,
+                                 MatchingSessions::Session &session,
+                                 util::json::Object &json_result) const
+{
+    // candidates of a previous dataset are invalid, timestamps need to be given for all points
+    // of a session or for none
+    if (session.dataset_timestamp != facade.GetDatasetTimestamp() ||
+        (!session.coordinates.empty() &&
+         session.timestamps.empty() != parameters.timestamps.empty()))
+    {
+        session.Reset(facade.GetDatasetTimestamp());
+    }
+
+    if (!parameters.timestamps.empty() && !session.timestamps.empty() &&
+        parameters.timestamps.front() < session.timestamps.back())
+    {
+        return Error(
+            "InvalidValue", "Timestamps need to be monotonically increasing.", json_result);
+    }
+
+    auto candidates_lists = GetPhantomNodesInRange(facade, parameters, search_radiuses);
+
+    const auto first_new_coordinate = session.coordinates.size();
+    session.coordinates.insert(session.coordinates.end(),
+                               parameters.coordinates.begin(),
+                               parameters.coordinates.end());
+    session.timestamps.insert(
+        session.timestamps.end(), parameters.timestamps.begin(), parameters.timestamps.end());
+    if (parameters.radiuses.empty())
+    {
+        session.gps_precisions.resize(session.coordinates.size());
+    }
+    else
+    {
+        session.gps_precisions.insert(session.gps_precisions.end(),
+                                      parameters.radiuses.begin(),
+                                      parameters.radiuses.end());
+    }
+    std::move(
+        candidates_lists.begin(), candidates_lists.end(), std::back_inserter(session.candidates));
+    // the last point kept was filtered without knowing the next one, its candidates have to stay
+    // the same as the ones in the matching state
+    filterCandidates(session.coordinates, session.candidates, first_new_coordinate);
+
+    // a single point can only be matched together with the next ones
+    if (session.coordinates.size() < 2)
+    {
+        return Error("NoMatch", "Could not match the trace.", json_result);
+    }
+
+    // the response covers the points kept in the session followed by the new ones
+    api::MatchParameters session_parameters = parameters;
+    session_parameters.coordinates = session.coordinates;
+    session_parameters.timestamps = session.timestamps;
+    session_parameters.radiuses = session.gps_precisions;
+    session_parameters.hints.clear();
+    session_parameters.bearings.clear();
+
+    const auto sub_matchings = map_matching(facade,
+                                            session.candidates,
+                                            session.coordinates,
+                                            session.timestamps,
+                                            session.gps_precisions,
+                                            session.state);
+    session.DropUnusedPoints();
+
+    if (sub_matchings.size() == 0)
+    {
+        return Error("NoMatch", "Could not match the trace.", json_result);
+    }
+
+    return MakeResponse(facade, session_parameters, sub_matchings, json_result);
+}
+
+Status MatchPlugin::MakeResponse(const datafacade::BaseDataFacade &facade,
+                                 const api::MatchParameters &parameters,
+                                 const SubMatchingList &sub_matchings,
+                                 util::json::Object &json_result) const
+{
     std::vector<InternalRouteResult> sub_routes(sub_matchings.size());
     for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
     {
@@ -211,15 +340,54 @@ Status MatchPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFaca
         // bi-directional
         // phantom nodes for possible uturns
         shortest_path(
-            *facade, sub_routes[index].segment_end_coordinates, {false}, sub_routes[index]);
+            facade, sub_routes[index].segment_end_coordinates, {false}, sub_routes[index]);
         BOOST_ASSERT(sub_routes[index].shortest_path_length != INVALID_EDGE_WEIGHT);
     }
 
-    api::MatchAPI match_api{*facade, parameters};
+    api::MatchAPI match_api{facade, parameters};
     match_api.MakeResponse(sub_matchings, sub_routes, json_result);
 
     return Status::Ok;
 }
+
+Status MatchPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                  const std::vector<api::MatchParameters> &parameters,
+                                  util::json::Object &json_result) const
+{
+    if (parameters.empty())
+    {
+        return Error("InvalidOptions", "Number of traces needs to be at least one.", json_result);
+    }
+
+    if (max_traces_map_matching > 0 &&
+        static_cast<int>(parameters.size()) > max_traces_map_matching)
+    {
+        return Error("TooBig", "Too many traces", json_result);
+    }
+
+    // The search heaps are thread local, so every worker matches its traces on its own heaps.
+    // All traces are matched on the same facade, a dataset swap waits for the whole batch.
+    std::vector<util::json::Object> results(parameters.size());
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, parameters.size(), 1),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          for (auto index = range.begin(); index != range.end(); ++index)
+                          {
+                              HandleRequest(facade, parameters[index], results[index]);
+                          }
+                      });
+
+    util::json::Array json_results;
+    json_results.values.reserve(results.size());
+    for (auto &result : results)
+    {
+        json_results.values.push_back(std::move(result));
+    }
+
+    json_result.values["code"] = "Ok";
+    json_result.values["results"] = std::move(json_results);
+
+    return Status::Ok;
+}
 }
 }
 }
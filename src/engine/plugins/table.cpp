@@ -5,6 +5,8 @@
 #include "engine/routing_algorithms/many_to_many.hpp"
 #include "engine/search_engine_data.hpp"
 #include "util/json_container.hpp"
+#include "util/json_renderer.hpp"
+#include "util/json_writer.hpp"
 #include "util/string_util.hpp"
 
 #include <cstdlib>
@@ -23,26 +25,91 @@ namespace engine
 namespace plugins
 {
 
-TablePlugin::TablePlugin(const int max_locations_distance_table)
-    : distance_table(heaps), max_locations_distance_table(max_locations_distance_table)
+TablePlugin::TablePlugin(const int max_locations_distance_table,
+                         std::shared_ptr<SnappingCache> snapping_cache)
+    : BasePlugin(std::move(snapping_cache)), distance_table(heaps),
+      max_locations_distance_table(max_locations_distance_table)
 {
 }
 
 Status TablePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                                   const api::TableParameters &params,
                                   util::json::Object &result) const
+{
+    std::vector<PhantomNode> snapped_phantoms;
+    TablesT tables;
+    const auto status = ComputeTables(*facade, params, snapped_phantoms, tables, result);
+    if (status != Status::Ok)
+    {
+        return status;
+    }
+
+    api::TableAPI table_api{*facade, params};
+    table_api.MakeResponse(tables.first, tables.second, snapped_phantoms, result);
+
+    return Status::Ok;
+}
+
+Status TablePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                  const api::TableParameters &params,
+                                  std::vector<char> &result) const
+{
+    std::vector<PhantomNode> snapped_phantoms;
+    TablesT tables;
+    util::json::Object error_result;
+    const auto status = ComputeTables(*facade, params, snapped_phantoms, tables, error_result);
+    if (status != Status::Ok)
+    {
+        util::json::render(result, error_result);
+        return status;
+    }
+
+    api::TableAPI table_api{*facade, params};
+    util::json::Writer writer(result);
+    table_api.MakeResponse(tables.first, tables.second, snapped_phantoms, writer);
+
+    return Status::Ok;
+}
+
+Status TablePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                  const api::TableParameters &params,
+                                  std::string &result) const
+{
+    std::vector<PhantomNode> snapped_phantoms;
+    TablesT tables;
+    util::json::Object error_result;
+    const auto status = ComputeTables(*facade, params, snapped_phantoms, tables, error_result);
+    if (status != Status::Ok)
+    {
+        return Error(error_result.values["code"].get<util::json::String>().value,
+                     error_result.values["message"].get<util::json::String>().value,
+                     result);
+    }
+
+    api::TableAPI table_api{*facade, params};
+    table_api.MakeResponse(tables.first, tables.second, snapped_phantoms, result);
+
+    return Status::Ok;
+}
+
+Status TablePlugin::ComputeTables(const datafacade::BaseDataFacade &facade,
+                                  const api::TableParameters &params,
+                                  std::vector<PhantomNode> &snapped_phantoms,
+                                  TablesT &tables,
+                                  util::json::Object &error_result) const
 {
     BOOST_ASSERT(params.IsValid());
 
     if (!CheckAllCoordinates(params.coordinates))
     {
-        return Error("InvalidOptions", "Coordinates are invalid", result);
+        return Error("InvalidOptions", "Coordinates are invalid", error_result);
     }
 
     if (params.bearings.size() > 0 && params.coordinates.size() != params.bearings.size())
     {
-        return Error(
-            "InvalidOptions", "Number of bearings does not match number of coordinates", result);
+        return Error("InvalidOptions",
+                     "Number of bearings does not match number of coordinates",
+                     error_result);
     }
 
     // Empty sources or destinations means the user wants all of them included, respectively
@@ -56,21 +123,20 @@ Status TablePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFaca
         ((num_sources * num_destinations) >
          static_cast<std::size_t>(max_locations_distance_table * max_locations_distance_table)))
     {
-        return Error("TooBig", "Too many table coordinates", result);
+        return Error("TooBig", "Too many table coordinates", error_result);
     }
 
-    auto snapped_phantoms = SnapPhantomNodes(GetPhantomNodes(*facade, params));
-    auto result_table =
-        distance_table(*facade, snapped_phantoms, params.sources, params.destinations);
+    snapped_phantoms = SnapPhantomNodes(GetPhantomNodes(facade, params));
+    const bool calculate_distance =
+        params.annotations & api::TableParameters::AnnotationsType::Distance;
+    tables = distance_table(
+        facade, snapped_phantoms, params.sources, params.destinations, calculate_distance);
 
-    if (result_table.empty())
+    if (tables.first.empty())
     {
-        return Error("NoTable", "No table found", result);
+        return Error("NoTable", "No table found", error_result);
     }
 
-    api::TableAPI table_api{*facade, params};
-    table_api.MakeResponse(result_table, snapped_phantoms, result);
-
     return Status::Ok;
 }
 }
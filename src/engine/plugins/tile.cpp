@@ -248,12 +248,46 @@ FixedPoint coordinatesToTilePoint(const util::Coordinate point, const BBox &tile
 
 } // namespace
 
+TilePlugin::TilePlugin(std::shared_ptr<TileCache> tile_cache,
+                       std::shared_ptr<const TileArchive> tile_archive)
+    : tile_cache(std::move(tile_cache)), tile_archive(std::move(tile_archive))
+{
+}
+
 Status TilePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                                  const api::TileParameters &parameters,
                                  std::string &pbf_buffer) const
 {
     BOOST_ASSERT(parameters.IsValid());
 
+    // the archive only holds tiles of the data it was rendered from
+    if (tile_archive && tile_archive->GetCheckSum() == facade->GetCheckSum() &&
+        tile_archive->Find(parameters.z, parameters.x, parameters.y, pbf_buffer))
+    {
+        return Status::Ok;
+    }
+
+    const auto dataset_timestamp = facade->GetDatasetTimestamp();
+    if (tile_cache &&
+        tile_cache->Find(
+            dataset_timestamp, parameters.z, parameters.x, parameters.y, pbf_buffer))
+    {
+        return Status::Ok;
+    }
+
+    const auto status = RenderTile(facade, parameters, pbf_buffer);
+    if (tile_cache && status == Status::Ok)
+    {
+        tile_cache->Insert(
+            dataset_timestamp, parameters.z, parameters.x, parameters.y, pbf_buffer);
+    }
+    return status;
+}
+
+Status TilePlugin::RenderTile(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                              const api::TileParameters &parameters,
+                              std::string &pbf_buffer) const
+{
     double min_lon, min_lat, max_lon, max_lat;
 
     // Convert the z,x,y mercator tile coordinates into WGS84 lon/lat values
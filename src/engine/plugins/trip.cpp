@@ -4,8 +4,9 @@
 
 #include "engine/api/trip_api.hpp"
 #include "engine/api/trip_parameters.hpp"
-#include "engine/trip/trip_brute_force.hpp"
 #include "engine/trip/trip_farthest_insertion.hpp"
+#include "engine/trip/trip_held_karp.hpp"
+#include "engine/trip/trip_local_search.hpp"
 #include "engine/trip/trip_nearest_neighbour.hpp"
 #include "util/dist_table_wrapper.hpp" // to access the dist table more easily
 #include "util/json_container.hpp"
@@ -14,6 +15,7 @@
 #include <boost/assert.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <iterator>
 #include <memory>
@@ -182,7 +184,8 @@ Status TripPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacad
         return Status::Error;
     }
 
-    const constexpr std::size_t BF_MAX_FEASABLE = 10;
+    // time spent improving a heuristic trip through a component too large to solve exactly
+    const constexpr auto LOCAL_SEARCH_TIME_BUDGET = std::chrono::milliseconds(100);
     BOOST_ASSERT_MSG(result_table.size() == number_of_locations * number_of_locations,
                      "Distance Table has wrong size");
 
@@ -205,15 +208,16 @@ Status TripPlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacad
         if (component_size > 1)
         {
 
-            if (component_size < BF_MAX_FEASABLE)
+            if (component_size <= trip::HELD_KARP_MAX_FEASABLE)
             {
                 scc_route =
-                    trip::BruteForceTrip(route_begin, route_end, number_of_locations, result_table);
+                    trip::HeldKarpTrip(route_begin, route_end, number_of_locations, result_table);
             }
             else
             {
                 scc_route = trip::FarthestInsertionTrip(
                     route_begin, route_end, number_of_locations, result_table);
+                trip::ImproveTrip(scc_route, result_table, LOCAL_SEARCH_TIME_BUDGET);
             }
         }
         else
@@ -21,15 +21,34 @@ namespace engine
 namespace plugins
 {
 
-ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute)
-    : shortest_path(heaps), alternative_path(heaps), direct_shortest_path(heaps),
-      max_locations_viaroute(max_locations_viaroute)
+ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute,
+                               int max_alternatives,
+                               std::shared_ptr<SnappingCache> snapping_cache)
+    : BasePlugin(std::move(snapping_cache)), shortest_path(heaps), alternative_path(heaps),
+      direct_shortest_path(heaps), max_locations_viaroute(max_locations_viaroute),
+      max_alternatives(max_alternatives)
 {
 }
 
 Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                                      const api::RouteParameters &route_parameters,
                                      util::json::Object &json_result) const
+{
+    return HandleRequestImpl(facade, route_parameters, json_result);
+}
+
+Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                     const api::RouteParameters &route_parameters,
+                                     std::string &pbf_result) const
+{
+    return HandleRequestImpl(facade, route_parameters, pbf_result);
+}
+
+template <typename ResultT>
+Status
+ViaRoutePlugin::HandleRequestImpl(const std::shared_ptr<datafacade::BaseDataFacade> facade,
+                                  const api::RouteParameters &route_parameters,
+                                  ResultT &result) const
 {
     BOOST_ASSERT(route_parameters.IsValid());
 
@@ -40,12 +59,23 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataF
                      "Number of entries " + std::to_string(route_parameters.coordinates.size()) +
                          " is higher than current maximum (" +
                          std::to_string(max_locations_viaroute) + ")",
-                     json_result);
+                     result);
+    }
+
+    const auto number_of_alternatives =
+        route_parameters.alternatives ? route_parameters.number_of_alternatives : 0u;
+    if (max_alternatives >= 0 && number_of_alternatives > static_cast<unsigned>(max_alternatives))
+    {
+        return Error("TooBig",
+                     "Number of alternatives " + std::to_string(number_of_alternatives) +
+                         " is higher than current maximum (" + std::to_string(max_alternatives) +
+                         ")",
+                     result);
     }
 
     if (!CheckAllCoordinates(route_parameters.coordinates))
     {
-        return Error("InvalidValue", "Invalid coordinate value.", json_result);
+        return Error("InvalidValue", "Invalid coordinate value.", result);
     }
 
     auto phantom_node_pairs = GetPhantomNodes(*facade, route_parameters);
@@ -54,7 +84,7 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataF
         return Error("NoSegment",
                      std::string("Could not find a matching segment for coordinate ") +
                          std::to_string(phantom_node_pairs.size()),
-                     json_result);
+                     result);
     }
     BOOST_ASSERT(phantom_node_pairs.size() == route_parameters.coordinates.size());
 
@@ -86,9 +116,12 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataF
 
     if (1 == raw_route.segment_end_coordinates.size())
     {
-        if (route_parameters.alternatives && facade->GetCoreSize() == 0)
+        if (number_of_alternatives > 0 && facade->GetCoreSize() == 0)
         {
-            alternative_path(*facade, raw_route.segment_end_coordinates.front(), raw_route);
+            alternative_path(*facade,
+                             raw_route.segment_end_coordinates.front(),
+                             number_of_alternatives,
+                             raw_route);
         }
         else
         {
@@ -108,7 +141,7 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataF
     if (raw_route.is_valid())
     {
         api::RouteAPI route_api{*facade, route_parameters};
-        route_api.MakeResponse(raw_route, json_result);
+        route_api.MakeResponse(raw_route, result);
     }
     else
     {
@@ -121,11 +154,11 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataF
 
         if (not_in_same_component)
         {
-            return Error("NoRoute", "Impossible route between points", json_result);
+            return Error("NoRoute", "Impossible route between points", result);
         }
         else
         {
-            return Error("NoRoute", "No route found between points", json_result);
+            return Error("NoRoute", "No route found between points", result);
         }
     }
 
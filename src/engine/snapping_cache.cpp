@@ -0,0 +1,31 @@
+#include "engine/snapping_cache.hpp"
+
+#include "util/std_hash.hpp"
+
+namespace osrm
+{
+namespace engine
+{
+
+SnappingCacheKey::SnappingCacheKey(const util::Coordinate coordinate,
+                                   const boost::optional<double> &radius,
+                                   const boost::optional<Bearing> &bearing)
+    : lon(static_cast<std::int32_t>(coordinate.lon)),
+      lat(static_cast<std::int32_t>(coordinate.lat)), radius(radius ? *radius : -1.),
+      bearing(bearing ? bearing->bearing : -1), bearing_range(bearing ? bearing->range : -1)
+{
+}
+
+std::size_t SnappingCacheKeyHash::operator()(const SnappingCacheKey &key) const
+{
+    return hash_val(key.lon, key.lat, key.radius, key.bearing, key.bearing_range);
+}
+
+bool SnappingCacheKeyEqual::operator()(const SnappingCacheKey &lhs,
+                                       const SnappingCacheKey &rhs) const
+{
+    return lhs.lon == rhs.lon && lhs.lat == rhs.lat && lhs.radius == rhs.radius &&
+           lhs.bearing == rhs.bearing && lhs.bearing_range == rhs.bearing_range;
+}
+}
+}
@@ -0,0 +1,152 @@
+#include "engine/tile_archive.hpp"
+
+#include "util/exception.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace osrm
+{
+namespace engine
+{
+
+namespace
+{
+const constexpr char TILE_ARCHIVE_MAGIC[8] = {'O', 'S', 'R', 'M', 'T', 'I', 'L', 'E'};
+const constexpr std::uint32_t TILE_ARCHIVE_VERSION = 1;
+
+bool byKey(const tile_archive::IndexEntry &lhs, const tile_archive::IndexEntry &rhs)
+{
+    return lhs.key < rhs.key;
+}
+}
+
+TileArchive::TileArchive(const boost::filesystem::path &path)
+{
+    try
+    {
+        region.open(path);
+    }
+    catch (const std::exception &)
+    {
+        throw util::exception("Could not open tile archive " + path.string());
+    }
+
+    const auto file_size = region.size();
+    if (file_size < sizeof(tile_archive::Header))
+    {
+        throw util::exception(path.string() + " is not a tile archive");
+    }
+
+    header = reinterpret_cast<const tile_archive::Header *>(region.data());
+    if (std::memcmp(header->magic, TILE_ARCHIVE_MAGIC, sizeof(TILE_ARCHIVE_MAGIC)) != 0)
+    {
+        throw util::exception(path.string() + " is not a tile archive");
+    }
+    if (header->version != TILE_ARCHIVE_VERSION)
+    {
+        throw util::exception(path.string() + " has an unsupported version, render it again");
+    }
+    if (header->index_offset % alignof(tile_archive::IndexEntry) != 0 ||
+        header->index_offset > file_size ||
+        header->number_of_tiles >
+            (file_size - header->index_offset) / sizeof(tile_archive::IndexEntry))
+    {
+        throw util::exception(path.string() + " is truncated");
+    }
+
+    index_begin =
+        reinterpret_cast<const tile_archive::IndexEntry *>(region.data() + header->index_offset);
+    index_end = index_begin + header->number_of_tiles;
+
+    // Find reads the tiles in place, so every entry has to point into the tile data
+    for (auto entry = index_begin; entry != index_end; ++entry)
+    {
+        if (entry->offset < sizeof(tile_archive::Header) || entry->offset > header->index_offset ||
+            entry->size > header->index_offset - entry->offset ||
+            (entry != index_begin && !byKey(*std::prev(entry), *entry)))
+        {
+            throw util::exception(path.string() + " is corrupt, render it again");
+        }
+    }
+}
+
+bool TileArchive::Find(const unsigned z,
+                       const unsigned x,
+                       const unsigned y,
+                       std::string &tile) const
+{
+    const tile_archive::IndexEntry key{tile_archive::MakeKey(z, x, y), 0, 0};
+    const auto entry = std::lower_bound(index_begin, index_end, key, byKey);
+    if (entry == index_end || entry->key != key.key)
+    {
+        return false;
+    }
+
+    BOOST_ASSERT(entry->offset + entry->size <= header->index_offset);
+    tile.assign(region.data() + entry->offset, entry->size);
+    return true;
+}
+
+TileArchiveWriter::TileArchiveWriter(const boost::filesystem::path &path,
+                                     const unsigned checksum)
+    : output(path, std::ios::binary), checksum(checksum), offset(sizeof(tile_archive::Header))
+{
+    if (!output)
+    {
+        throw util::exception("Could not open " + path.string() + " for writing");
+    }
+
+    // the header is written on Finish once the index is known
+    const tile_archive::Header header{};
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+void TileArchiveWriter::Write(const unsigned z,
+                              const unsigned x,
+                              const unsigned y,
+                              const std::string &tile)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    output.write(tile.data(), tile.size());
+    index.push_back(tile_archive::IndexEntry{
+        tile_archive::MakeKey(z, x, y), offset, static_cast<std::uint64_t>(tile.size())});
+    offset += tile.size();
+}
+
+void TileArchiveWriter::Finish()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // the index is read in place from the mapped file, align it
+    const auto padding = (alignof(tile_archive::IndexEntry) -
+                          offset % alignof(tile_archive::IndexEntry)) %
+                         alignof(tile_archive::IndexEntry);
+    const char zeros[alignof(tile_archive::IndexEntry)] = {};
+    output.write(zeros, padding);
+    offset += padding;
+
+    std::sort(index.begin(), index.end(), byKey);
+    output.write(reinterpret_cast<const char *>(index.data()),
+                 index.size() * sizeof(tile_archive::IndexEntry));
+
+    tile_archive::Header header{};
+    std::copy(std::begin(TILE_ARCHIVE_MAGIC), std::end(TILE_ARCHIVE_MAGIC), header.magic);
+    header.version = TILE_ARCHIVE_VERSION;
+    header.checksum = checksum;
+    header.number_of_tiles = index.size();
+    header.index_offset = offset;
+    output.seekp(0);
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    output.close();
+    if (!output)
+    {
+        throw util::exception("Could not write the tile archive");
+    }
+}
+}
+}
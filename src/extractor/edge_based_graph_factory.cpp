@@ -19,11 +19,16 @@
 #include <boost/assert.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/pipeline.h>
+#include <tbb/task_scheduler_init.h>
+
 #include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -363,225 +368,384 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
     bearing_class_by_node_based_node.resize(m_node_based_graph->GetNumberOfNodes(),
                                             std::numeric_limits<std::uint32_t>::max());
 
-    for (const auto node_u : util::irange(0u, m_node_based_graph->GetNumberOfNodes()))
-    {
-        progress.PrintStatus(node_u);
-        for (const EdgeID edge_from_u : m_node_based_graph->GetAdjacentEdgeRange(node_u))
-        {
-            if (m_node_based_graph->GetEdgeData(edge_from_u).reversed)
-            {
-                continue;
-            }
-
-            const NodeID node_v = m_node_based_graph->GetTarget(edge_from_u);
-            ++node_based_edge_counter;
-            auto intersection = turn_analysis(node_u, edge_from_u);
-            BOOST_ASSERT(intersection.valid());
+    // The intersections are analysed in parallel on blocks of nodes. Everything that needs
+    // global ids (entry/bearing classes, edge ids) and all file output is done by a serial stage
+    // that consumes the blocks in node order, so the output does not depend on the thread count.
+    // Lua turn penalties run on the scripting context of the calling thread.
+    const constexpr NodeID GRAINSIZE = 100;
 
-            intersection =
-                turn_lane_handler.assignTurnLanes(node_u, edge_from_u, std::move(intersection));
-
-            const auto possible_turns = turn_analysis.transformIntersectionIntoTurns(intersection);
+    struct IntersectionData
+    {
+        NodeID node_v;
+        util::guidance::EntryClass entry_class;
+        util::guidance::BearingClass bearing_class;
+        // one past the last turn of this intersection in the buffer
+        std::size_t turns_end;
+    };
 
-            // the entry class depends on the turn, so we have to classify the interesction for
-            // every edge
-            const auto turn_classification = classifyIntersection(intersection);
+    struct EdgesBuffer
+    {
+        NodeID nodes_end = 0;
+        std::vector<IntersectionData> intersections;
+        // entry class ids and edge ids are assigned by the serial stage
+        std::vector<EdgeBasedEdge> edges;
+        std::vector<OriginalEdgeData> original_edges;
+        std::vector<char> segment_lookup;
+        std::vector<lookup::PenaltyBlock> penalties;
+    };
 
-            const auto entry_class_id = [&](const util::guidance::EntryClass entry_class) {
-                if (0 == entry_class_hash.count(entry_class))
-                {
-                    const auto id = static_cast<std::uint16_t>(entry_class_hash.size());
-                    entry_class_hash[entry_class] = id;
-                    return id;
-                }
-                else
-                {
-                    return entry_class_hash.find(entry_class)->second;
-                }
-            }(turn_classification.first);
+    // Lane data ids, and the ids of lane descriptions combined at sliproads, are handed out by the
+    // parallel workers in the order they get to them. They are renumbered by their first use in
+    // edge order so the output is the same on every run.
+    const auto number_of_extracted_lane_descriptions =
+        static_cast<LaneDescriptionID>(lane_description_map.data.size());
+    std::vector<LaneDataID> lane_data_renumbering;
+    std::vector<LaneDataID> lane_data_by_renumbered_id;
+    const auto renumber_lane_data = [&](const LaneDataID lane_data_id) {
+        if (lane_data_id == INVALID_LANE_DATAID)
+        {
+            return lane_data_id;
+        }
+        if (lane_data_id >= lane_data_renumbering.size())
+        {
+            lane_data_renumbering.resize(lane_data_id + 1, INVALID_LANE_DATAID);
+        }
+        auto &renumbered_id = lane_data_renumbering[lane_data_id];
+        if (renumbered_id == INVALID_LANE_DATAID)
+        {
+            renumbered_id = static_cast<LaneDataID>(lane_data_by_renumbered_id.size());
+            lane_data_by_renumbered_id.push_back(lane_data_id);
+        }
+        return renumbered_id;
+    };
 
-            const auto bearing_class_id = [&](const util::guidance::BearingClass bearing_class) {
-                if (0 == bearing_class_hash.count(bearing_class))
-                {
-                    const auto id = static_cast<std::uint32_t>(bearing_class_hash.size());
-                    bearing_class_hash[bearing_class] = id;
-                    return id;
-                }
-                else
-                {
-                    return bearing_class_hash.find(bearing_class)->second;
-                }
-            }(turn_classification.second);
-            bearing_class_by_node_based_node[node_v] = bearing_class_id;
+    const NodeID number_of_nodes = m_node_based_graph->GetNumberOfNodes();
+    NodeID current_node = 0;
 
-            for (const auto turn : possible_turns)
+    const auto generate_blocks = tbb::make_filter<void, tbb::blocked_range<NodeID>>(
+        tbb::filter::serial_in_order, [&](tbb::flow_control &control) {
+            if (current_node >= number_of_nodes)
             {
-                // only add an edge if turn is not prohibited
-                const EdgeData &edge_data1 = m_node_based_graph->GetEdgeData(edge_from_u);
-                const EdgeData &edge_data2 = m_node_based_graph->GetEdgeData(turn.eid);
-
-                BOOST_ASSERT(edge_data1.edge_id != edge_data2.edge_id);
-                BOOST_ASSERT(!edge_data1.reversed);
-                BOOST_ASSERT(!edge_data2.reversed);
-
-                // the following is the core of the loop.
-                unsigned distance = edge_data1.distance;
-                if (m_traffic_lights.find(node_v) != m_traffic_lights.end())
+                control.stop();
+                return tbb::blocked_range<NodeID>(number_of_nodes, number_of_nodes);
+            }
+            const auto begin = current_node;
+            current_node = std::min(number_of_nodes, current_node + GRAINSIZE);
+            return tbb::blocked_range<NodeID>(begin, current_node);
+        });
+
+    const auto process_block = tbb::make_filter<tbb::blocked_range<NodeID>,
+                                                std::shared_ptr<EdgesBuffer>>(
+        tbb::filter::parallel, [&](const tbb::blocked_range<NodeID> &block) {
+            auto buffer = std::make_shared<EdgesBuffer>();
+            buffer->nodes_end = block.end();
+
+            const auto append_lookup = [&buffer](const auto &lookup_block) {
+                const auto data = reinterpret_cast<const char *>(&lookup_block);
+                buffer->segment_lookup.insert(
+                    buffer->segment_lookup.end(), data, data + sizeof(lookup_block));
+            };
+
+            for (const auto node_u : util::irange(block.begin(), block.end()))
+            {
+                for (const EdgeID edge_from_u : m_node_based_graph->GetAdjacentEdgeRange(node_u))
                 {
-                    distance += profile_properties.traffic_signal_penalty;
-                }
+                    if (m_node_based_graph->GetEdgeData(edge_from_u).reversed)
+                    {
+                        continue;
+                    }
 
-                const int32_t turn_penalty =
-                    scripting_environment.GetTurnPenalty(180. - turn.angle);
+                    const NodeID node_v = m_node_based_graph->GetTarget(edge_from_u);
+                    auto intersection = turn_analysis(node_u, edge_from_u);
+                    BOOST_ASSERT(intersection.valid());
 
-                const auto turn_instruction = turn.instruction;
+                    intersection = turn_lane_handler.assignTurnLanes(
+                        node_u, edge_from_u, std::move(intersection));
 
-                if (turn_instruction.direction_modifier == guidance::DirectionModifier::UTurn)
-                {
-                    distance += profile_properties.u_turn_penalty;
-                }
+                    const auto possible_turns =
+                        turn_analysis.transformIntersectionIntoTurns(intersection);
 
-                // don't add turn penalty if it is not an actual turn. This heuristic is necessary
-                // since OSRM cannot handle looping roads/parallel roads
-                if (turn_instruction.type != guidance::TurnType::NoTurn)
-                    distance += turn_penalty;
-
-                const bool is_encoded_forwards =
-                    m_compressed_edge_container.HasZippedEntryForForwardID(edge_from_u);
-                const bool is_encoded_backwards =
-                    m_compressed_edge_container.HasZippedEntryForReverseID(edge_from_u);
-                BOOST_ASSERT(is_encoded_forwards || is_encoded_backwards);
-                if (is_encoded_forwards)
-                {
-                    original_edge_data_vector.emplace_back(
-                        GeometryID{
-                            m_compressed_edge_container.GetZippedPositionForForwardID(edge_from_u),
-                            true},
-                        edge_data1.name_id,
-                        turn.lane_data_id,
-                        turn_instruction,
-                        entry_class_id,
-                        edge_data1.travel_mode,
-                        util::guidance::TurnBearing(intersection[0].bearing),
-                        util::guidance::TurnBearing(turn.bearing));
-                }
-                else if (is_encoded_backwards)
-                {
-                    original_edge_data_vector.emplace_back(
-                        GeometryID{
-                            m_compressed_edge_container.GetZippedPositionForReverseID(edge_from_u),
-                            false},
-                        edge_data1.name_id,
-                        turn.lane_data_id,
-                        turn_instruction,
-                        entry_class_id,
-                        edge_data1.travel_mode,
-                        util::guidance::TurnBearing(intersection[0].bearing),
-                        util::guidance::TurnBearing(turn.bearing));
-                }
+                    // the entry class depends on the turn, so we have to classify the
+                    // interesction for every edge
+                    const auto turn_classification = classifyIntersection(intersection);
 
-                ++original_edges_counter;
+                    for (const auto turn : possible_turns)
+                    {
+                        // only add an edge if turn is not prohibited
+                        const EdgeData &edge_data1 = m_node_based_graph->GetEdgeData(edge_from_u);
+                        const EdgeData &edge_data2 = m_node_based_graph->GetEdgeData(turn.eid);
+
+                        BOOST_ASSERT(edge_data1.edge_id != edge_data2.edge_id);
+                        BOOST_ASSERT(!edge_data1.reversed);
+                        BOOST_ASSERT(!edge_data2.reversed);
+
+                        // the following is the core of the loop.
+                        unsigned distance = edge_data1.distance;
+                        if (m_traffic_lights.find(node_v) != m_traffic_lights.end())
+                        {
+                            distance += profile_properties.traffic_signal_penalty;
+                        }
+
+                        const int32_t turn_penalty =
+                            scripting_environment.GetTurnPenalty(180. - turn.angle);
+
+                        const auto turn_instruction = turn.instruction;
+
+                        if (turn_instruction.direction_modifier ==
+                            guidance::DirectionModifier::UTurn)
+                        {
+                            distance += profile_properties.u_turn_penalty;
+                        }
+
+                        // don't add turn penalty if it is not an actual turn. This heuristic is
+                        // necessary since OSRM cannot handle looping roads/parallel roads
+                        if (turn_instruction.type != guidance::TurnType::NoTurn)
+                            distance += turn_penalty;
+
+                        const bool is_encoded_forwards =
+                            m_compressed_edge_container.HasZippedEntryForForwardID(edge_from_u);
+                        const bool is_encoded_backwards =
+                            m_compressed_edge_container.HasZippedEntryForReverseID(edge_from_u);
+                        BOOST_ASSERT(is_encoded_forwards || is_encoded_backwards);
+                        if (is_encoded_forwards)
+                        {
+                            const auto position =
+                                m_compressed_edge_container.GetZippedPositionForForwardID(
+                                    edge_from_u);
+                            buffer->original_edges.emplace_back(
+                                GeometryID{position, true},
+                                edge_data1.name_id,
+                                turn.lane_data_id,
+                                turn_instruction,
+                                INVALID_ENTRY_CLASSID,
+                                edge_data1.travel_mode,
+                                util::guidance::TurnBearing(intersection[0].bearing),
+                                util::guidance::TurnBearing(turn.bearing));
+                        }
+                        else if (is_encoded_backwards)
+                        {
+                            const auto position =
+                                m_compressed_edge_container.GetZippedPositionForReverseID(
+                                    edge_from_u);
+                            buffer->original_edges.emplace_back(
+                                GeometryID{position, false},
+                                edge_data1.name_id,
+                                turn.lane_data_id,
+                                turn_instruction,
+                                INVALID_ENTRY_CLASSID,
+                                edge_data1.travel_mode,
+                                util::guidance::TurnBearing(intersection[0].bearing),
+                                util::guidance::TurnBearing(turn.bearing));
+                        }
+
+                        BOOST_ASSERT(SPECIAL_NODEID != edge_data1.edge_id);
+                        BOOST_ASSERT(SPECIAL_NODEID != edge_data2.edge_id);
+
+                        buffer->edges.emplace_back(edge_data1.edge_id,
+                                                   edge_data2.edge_id,
+                                                   SPECIAL_EDGEID,
+                                                   distance,
+                                                   true,
+                                                   false);
+
+                        // Here is where we write out the mapping between the edge-expanded edges,
+                        // and the node-based edges that are originally used to calculate the
+                        // `distance` for the edge-expanded edges.  About 40 lines back, there is:
+                        //
+                        //                 unsigned distance = edge_data1.distance;
+                        //
+                        // This tells us that the weight for an edge-expanded-edge is based on the
+                        // weight of the *source* node-based edge.  Therefore, we will look up the
+                        // individual segments of the source node-based edge, and write out a
+                        // mapping between those and the edge-based-edge ID.
+                        // External programs can then use this mapping to quickly perform
+                        // updates to the edge-expanded-edge based directly on its ID.
+                        if (generate_edge_lookup)
+                        {
+                            const auto node_based_edges =
+                                m_compressed_edge_container.GetBucketReference(edge_from_u);
+                            NodeID previous = node_u;
+
+                            const unsigned node_count = node_based_edges.size() + 1;
+                            const QueryNode &first_node = m_node_info_list[previous];
+
+                            append_lookup(
+                                lookup::SegmentHeaderBlock{node_count, first_node.node_id});
+
+                            for (auto target_node : node_based_edges)
+                            {
+                                const QueryNode &from = m_node_info_list[previous];
+                                const QueryNode &to = m_node_info_list[target_node.node_id];
+                                const double segment_length =
+                                    util::coordinate_calculation::greatCircleDistance(from, to);
+
+                                append_lookup(lookup::SegmentBlock{
+                                    to.node_id, segment_length, target_node.weight});
+                                previous = target_node.node_id;
+                            }
+
+                            // We also now write out the mapping between the edge-expanded edges
+                            // and the original nodes. Since each edge represents a possible
+                            // maneuver, external programs can use this to quickly perform updates
+                            // to edge weights in order to penalize certain turns.
+
+                            // If this edge is 'trivial' -- where the compressed edge corresponds
+                            // exactly to an original OSM segment -- we can pull the turn's
+                            // preceding node ID directly with `node_u`; otherwise, we need to
+                            // look up the node immediately preceding the turn from the compressed
+                            // edge container.
+                            const bool isTrivial =
+                                m_compressed_edge_container.IsTrivial(edge_from_u);
+
+                            const auto &from_node =
+                                isTrivial ? m_node_info_list[node_u]
+                                          : m_node_info_list[m_compressed_edge_container
+                                                                 .GetLastEdgeSourceID(edge_from_u)];
+                            const auto &via_node =
+                                m_node_info_list[m_compressed_edge_container.GetLastEdgeTargetID(
+                                    edge_from_u)];
+                            const auto &to_node =
+                                m_node_info_list[m_compressed_edge_container.GetFirstEdgeTargetID(
+                                    turn.eid)];
+
+                            const unsigned fixed_penalty = distance - edge_data1.distance;
+                            buffer->penalties.push_back({fixed_penalty,
+                                                         from_node.node_id,
+                                                         via_node.node_id,
+                                                         to_node.node_id});
+                        }
+                    }
 
-                if (original_edge_data_vector.size() > 1024 * 1024 * 10)
-                {
-                    FlushVectorToStream(edge_data_file, original_edge_data_vector);
+                    buffer->intersections.push_back({node_v,
+                                                     turn_classification.first,
+                                                     turn_classification.second,
+                                                     buffer->edges.size()});
                 }
+            }
 
-                BOOST_ASSERT(SPECIAL_NODEID != edge_data1.edge_id);
-                BOOST_ASSERT(SPECIAL_NODEID != edge_data2.edge_id);
-
-                // NOTE: potential overflow here if we hit 2^32 routable edges
-                BOOST_ASSERT(m_edge_based_edge_list.size() <= std::numeric_limits<NodeID>::max());
-                m_edge_based_edge_list.emplace_back(edge_data1.edge_id,
-                                                    edge_data2.edge_id,
-                                                    m_edge_based_edge_list.size(),
-                                                    distance,
-                                                    true,
-                                                    false);
-
-                // Here is where we write out the mapping between the edge-expanded edges, and
-                // the node-based edges that are originally used to calculate the `distance`
-                // for the edge-expanded edges.  About 40 lines back, there is:
-                //
-                //                 unsigned distance = edge_data1.distance;
-                //
-                // This tells us that the weight for an edge-expanded-edge is based on the weight
-                // of the *source* node-based edge.  Therefore, we will look up the individual
-                // segments of the source node-based edge, and write out a mapping between
-                // those and the edge-based-edge ID.
-                // External programs can then use this mapping to quickly perform
-                // updates to the edge-expanded-edge based directly on its ID.
-                if (generate_edge_lookup)
-                {
-                    const auto node_based_edges =
-                        m_compressed_edge_container.GetBucketReference(edge_from_u);
-                    NodeID previous = node_u;
-
-                    const unsigned node_count = node_based_edges.size() + 1;
-                    const QueryNode &first_node = m_node_info_list[previous];
+            BOOST_ASSERT(buffer->edges.size() == buffer->original_edges.size());
+            return buffer;
+        });
 
-                    lookup::SegmentHeaderBlock header = {node_count, first_node.node_id};
+    const auto output_block = tbb::make_filter<std::shared_ptr<EdgesBuffer>, void>(
+        tbb::filter::serial_in_order, [&](const std::shared_ptr<EdgesBuffer> buffer) {
+            progress.PrintStatus(buffer->nodes_end);
 
-                    edge_segment_file.write(reinterpret_cast<const char *>(&header),
-                                            sizeof(header));
+            std::size_t turn_index = 0;
+            for (const auto &intersection : buffer->intersections)
+            {
+                ++node_based_edge_counter;
 
-                    for (auto target_node : node_based_edges)
+                const auto entry_class_id = [&](const util::guidance::EntryClass entry_class) {
+                    if (0 == entry_class_hash.count(entry_class))
                     {
-                        const QueryNode &from = m_node_info_list[previous];
-                        const QueryNode &to = m_node_info_list[target_node.node_id];
-                        const double segment_length =
-                            util::coordinate_calculation::greatCircleDistance(from, to);
-
-                        lookup::SegmentBlock nodeblock = {
-                            to.node_id, segment_length, target_node.weight};
+                        const auto id = static_cast<std::uint16_t>(entry_class_hash.size());
+                        entry_class_hash[entry_class] = id;
+                        return id;
+                    }
+                    else
+                    {
+                        return entry_class_hash.find(entry_class)->second;
+                    }
+                }(intersection.entry_class);
+
+                const auto bearing_class_id =
+                    [&](const util::guidance::BearingClass bearing_class) {
+                        if (0 == bearing_class_hash.count(bearing_class))
+                        {
+                            const auto id = static_cast<std::uint32_t>(bearing_class_hash.size());
+                            bearing_class_hash[bearing_class] = id;
+                            return id;
+                        }
+                        else
+                        {
+                            return bearing_class_hash.find(bearing_class)->second;
+                        }
+                    }(intersection.bearing_class);
+                bearing_class_by_node_based_node[intersection.node_v] = bearing_class_id;
+
+                for (; turn_index < intersection.turns_end; ++turn_index)
+                {
+                    auto &original_edge = buffer->original_edges[turn_index];
+                    original_edge.entry_classid = entry_class_id;
+                    original_edge.lane_data_id = renumber_lane_data(original_edge.lane_data_id);
+                    original_edge_data_vector.push_back(original_edge);
+                    ++original_edges_counter;
 
-                        edge_segment_file.write(reinterpret_cast<const char *>(&nodeblock),
-                                                sizeof(nodeblock));
-                        previous = target_node.node_id;
+                    if (original_edge_data_vector.size() > 1024 * 1024 * 10)
+                    {
+                        FlushVectorToStream(edge_data_file, original_edge_data_vector);
                     }
 
-                    // We also now write out the mapping between the edge-expanded edges and the
-                    // original nodes. Since each edge represents a possible maneuver, external
-                    // programs can use this to quickly perform updates to edge weights in order
-                    // to penalize certain turns.
-
-                    // If this edge is 'trivial' -- where the compressed edge corresponds
-                    // exactly to an original OSM segment -- we can pull the turn's preceding
-                    // node ID directly with `node_u`; otherwise, we need to look up the node
-                    // immediately preceding the turn from the compressed edge container.
-                    const bool isTrivial = m_compressed_edge_container.IsTrivial(edge_from_u);
-
-                    const auto &from_node =
-                        isTrivial
-                            ? m_node_info_list[node_u]
-                            : m_node_info_list[m_compressed_edge_container.GetLastEdgeSourceID(
-                                  edge_from_u)];
-                    const auto &via_node =
-                        m_node_info_list[m_compressed_edge_container.GetLastEdgeTargetID(
-                            edge_from_u)];
-                    const auto &to_node =
-                        m_node_info_list[m_compressed_edge_container.GetFirstEdgeTargetID(
-                            turn.eid)];
-
-                    const unsigned fixed_penalty = distance - edge_data1.distance;
-                    lookup::PenaltyBlock penaltyblock = {
-                        fixed_penalty, from_node.node_id, via_node.node_id, to_node.node_id};
-                    edge_penalty_file.write(reinterpret_cast<const char *>(&penaltyblock),
-                                            sizeof(penaltyblock));
+                    // NOTE: potential overflow here if we hit 2^32 routable edges
+                    BOOST_ASSERT(m_edge_based_edge_list.size() <=
+                                 std::numeric_limits<NodeID>::max());
+                    auto &edge = buffer->edges[turn_index];
+                    edge.edge_id = m_edge_based_edge_list.size();
+                    m_edge_based_edge_list.push_back(edge);
                 }
             }
-        }
-    }
+
+            if (generate_edge_lookup)
+            {
+                edge_segment_file.write(buffer->segment_lookup.data(),
+                                        buffer->segment_lookup.size());
+                edge_penalty_file.write(reinterpret_cast<const char *>(buffer->penalties.data()),
+                                        buffer->penalties.size() * sizeof(lookup::PenaltyBlock));
+            }
+        });
+
+    // limit the number of blocks in flight to bound the memory used by the buffers
+    tbb::parallel_pipeline(tbb::task_scheduler_init::default_num_threads() * 4,
+                           generate_blocks & process_block & output_block);
 
     util::SimpleLogger().Write() << "Created " << entry_class_hash.size() << " entry classes and "
                                  << bearing_class_hash.size() << " Bearing Classes";
 
     util::SimpleLogger().Write() << "Writing Turn Lane Data to File...";
     std::ofstream turn_lane_data_file(turn_lane_data_filename.c_str(), std::ios::binary);
-    std::vector<util::guidance::LaneTupleIdPair> lane_data(lane_data_map.size());
-    // extract lane data sorted by ID
-    for (auto itr : lane_data_map)
-        lane_data[itr.second] = itr.first;
+    std::vector<util::guidance::LaneTupleIdPair> lane_data_by_id(lane_data_map.data.size());
+    for (const auto &entry : lane_data_map.data)
+        lane_data_by_id[entry.second] = entry.first;
+
+    // extract the used lane data sorted by the renumbered ID, lane data of prohibited turns is
+    // dropped
+    std::vector<util::guidance::LaneTupleIdPair> lane_data;
+    lane_data.reserve(lane_data_by_renumbered_id.size());
+    for (const auto lane_data_id : lane_data_by_renumbered_id)
+        lane_data.push_back(lane_data_by_id[lane_data_id]);
+
+    // renumber the combined lane descriptions in the order of the lane data, dropping the unused
+    std::vector<LaneDescriptionID> lane_description_renumbering(lane_description_map.data.size(),
+                                                                INVALID_LANE_DESCRIPTIONID);
+    auto next_lane_description_id = number_of_extracted_lane_descriptions;
+    for (auto &tuple_id_pair : lane_data)
+    {
+        if (tuple_id_pair.second == INVALID_LANE_DESCRIPTIONID ||
+            tuple_id_pair.second < number_of_extracted_lane_descriptions)
+            continue;
+
+        auto &renumbered_id = lane_description_renumbering[tuple_id_pair.second];
+        if (renumbered_id == INVALID_LANE_DESCRIPTIONID)
+            renumbered_id = next_lane_description_id++;
+        tuple_id_pair.second = renumbered_id;
+    }
+    for (auto entry = lane_description_map.data.begin(); entry != lane_description_map.data.end();)
+    {
+        if (entry->second < number_of_extracted_lane_descriptions)
+        {
+            ++entry;
+        }
+        else if (lane_description_renumbering[entry->second] == INVALID_LANE_DESCRIPTIONID)
+        {
+            entry = lane_description_map.data.erase(entry);
+        }
+        else
+        {
+            entry->second = lane_description_renumbering[entry->second];
+            ++entry;
+        }
+    }
 
     std::uint64_t size = lane_data.size();
     turn_lane_data_file.write(reinterpret_cast<const char *>(&size), sizeof(size));
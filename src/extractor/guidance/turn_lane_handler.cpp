@@ -10,7 +10,6 @@
 #include <cstdint>
 
 #include <boost/algorithm/string/predicate.hpp>
-#include <boost/numeric/conversion/cast.hpp>
 
 namespace osrm
 {
@@ -766,19 +765,7 @@ Intersection TurnLaneHandler::handleSliproadTurn(Intersection intersection,
         }
     }
 
-    const auto combined_id = [&]() {
-        auto itr = lane_description_map.find(combined_description);
-        if (lane_description_map.find(combined_description) == lane_description_map.end())
-        {
-            const auto new_id = boost::numeric_cast<LaneDescriptionID>(lane_description_map.size());
-            lane_description_map[combined_description] = new_id;
-            return new_id;
-        }
-        else
-        {
-            return itr->second;
-        }
-    }();
+    const auto combined_id = lane_description_map.ConcurrentFindOrAdd(combined_description);
     return simpleMatchTuplesToTurns(std::move(intersection), lane_data, combined_id);
 }
 
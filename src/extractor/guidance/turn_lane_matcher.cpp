@@ -3,7 +3,6 @@
 #include "util/guidance/toolkit.hpp"
 
 #include <boost/assert.hpp>
-#include <boost/numeric/conversion/cast.hpp>
 
 #include <functional>
 
@@ -207,16 +206,8 @@ Intersection triviallyMatchLanesToTurns(Intersection intersection,
     const auto matchRoad = [&](ConnectedRoad &road, const TurnLaneData &data) {
         LaneTupleIdPair key{{LaneID(data.to - data.from + 1), data.from}, lane_string_id};
 
-        auto lane_data_id = boost::numeric_cast<LaneDataID>(lane_data_to_id.size());
-        const auto it = lane_data_to_id.find(key);
-
-        if (it == lane_data_to_id.end())
-            lane_data_to_id.insert({key, lane_data_id});
-        else
-            lane_data_id = it->second;
-
         // set lane id instead after the switch:
-        road.lane_data_id = lane_data_id;
+        road.lane_data_id = lane_data_to_id.ConcurrentFindOrAdd(key);
     };
 
     if (!lane_data.empty() && lane_data.front().tag == TurnLaneType::uturn)
@@ -254,15 +254,16 @@ const ProfileProperties &LuaScriptingEnvironment::GetProfileProperties()
 
 LuaScriptingContext &LuaScriptingEnvironment::GetLuaContext()
 {
-    std::lock_guard<std::mutex> lock(init_mutex);
     bool initialized = false;
     auto &ref = script_contexts.local(initialized);
     if (!initialized)
     {
+        // only the setup of new contexts is serialized, this is called for every turn penalty
+        std::lock_guard<std::mutex> lock(init_mutex);
         ref = std::make_unique<LuaScriptingContext>();
         InitContext(*ref);
+        luabind::set_pcall_callback(&luaErrorCallback);
     }
-    luabind::set_pcall_callback(&luaErrorCallback);
 
     return *ref;
 }
@@ -9,6 +9,7 @@
 #include "engine/status.hpp"
 
 #include <memory>
+#include <vector>
 
 namespace osrm
 {
@@ -28,11 +29,28 @@ engine::Status OSRM::Route(const engine::api::RouteParameters &params,
     return engine_->Route(params, result);
 }
 
+engine::Status OSRM::Route(const engine::api::RouteParameters &params, std::string &result) const
+{
+    return engine_->Route(params, result);
+}
+
 engine::Status OSRM::Table(const engine::api::TableParameters &params, json::Object &result) const
 {
     return engine_->Table(params, result);
 }
 
+engine::Status OSRM::Table(const engine::api::TableParameters &params,
+                           std::vector<char> &result) const
+{
+    return engine_->Table(params, result);
+}
+
+engine::Status OSRM::Table(const engine::api::TableParameters &params,
+                           std::string &result) const
+{
+    return engine_->Table(params, result);
+}
+
 engine::Status OSRM::Nearest(const engine::api::NearestParameters &params,
                              json::Object &result) const
 {
@@ -49,9 +67,20 @@ engine::Status OSRM::Match(const engine::api::MatchParameters &params, json::Obj
     return engine_->Match(params, result);
 }
 
+engine::Status OSRM::Match(const std::vector<engine::api::MatchParameters> &params,
+                           json::Object &result) const
+{
+    return engine_->Match(params, result);
+}
+
 engine::Status OSRM::Tile(const engine::api::TileParameters &params, std::string &result) const
 {
     return engine_->Tile(params, result);
 }
 
+engine::CacheStatistics OSRM::GetSnappingCacheStatistics() const
+{
+    return engine_->GetSnappingCacheStatistics();
+}
+
 } // ns osrm
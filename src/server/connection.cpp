@@ -1,4 +1,5 @@
 #include "server/connection.hpp"
+#include "server/compute_thread_pool.hpp"
 #include "server/request_handler.hpp"
 #include "server/request_parser.hpp"
 
@@ -16,16 +17,35 @@ namespace osrm
 namespace server
 {
 
-Connection::Connection(boost::asio::io_service &io_service, RequestHandler &handler)
-    : strand(io_service), TCP_socket(io_service), request_handler(handler)
+Connection::Connection(boost::asio::io_service &io_service,
+                       RequestHandler &handler,
+                       ComputeThreadPool &compute_pool,
+                       const unsigned keepalive_timeout,
+                       const unsigned keepalive_max_requests)
+    : strand(io_service), TCP_socket(io_service), timer(io_service), request_handler(handler),
+      compute_pool(compute_pool), pending_data_begin(nullptr), pending_data_end(nullptr),
+      keepalive_timeout(keepalive_timeout), keepalive_max_requests(keepalive_max_requests),
+      processed_requests(0), keep_alive(false)
 {
 }
 
 boost::asio::ip::tcp::socket &Connection::socket() { return TCP_socket; }
 
 /// Start the first asynchronous operation for the connection.
-void Connection::start()
+void Connection::start() { read_request(); }
+
+void Connection::read_request()
 {
+    // only a kept-alive connection waits for its next request, before the first response the
+    // read is not limited as on connections without keep-alive
+    if (keepalive_timeout > 0 && processed_requests > 0)
+    {
+        timer.expires_from_now(boost::posix_time::seconds(keepalive_timeout));
+        timer.async_wait(strand.wrap(boost::bind(&Connection::handle_timeout,
+                                                 this->shared_from_this(),
+                                                 boost::asio::placeholders::error)));
+    }
+
     TCP_socket.async_read_some(
         boost::asio::buffer(incoming_data_buffer),
         strand.wrap(boost::bind(&Connection::handle_read,
@@ -36,62 +56,61 @@ void Connection::start()
 
 void Connection::handle_read(const boost::system::error_code &error, std::size_t bytes_transferred)
 {
+    // moving the deadline also cancels a pending wait
+    timer.expires_at(boost::posix_time::pos_infin);
+
     if (error)
     {
         return;
     }
 
+    process_request(incoming_data_buffer.data(), incoming_data_buffer.data() + bytes_transferred);
+}
+
+void Connection::process_request(char *begin, char *end)
+{
     // no error detected, let's parse the request
     http::compression_type compression_type(http::no_compression);
     RequestParser::RequestStatus result;
-    std::tie(result, compression_type) =
-        request_parser.parse(current_request,
-                             incoming_data_buffer.data(),
-                             incoming_data_buffer.data() + bytes_transferred);
+    std::tie(result, compression_type, pending_data_begin) =
+        request_parser.parse(current_request, begin, end);
+    pending_data_end = end;
 
     // the request has been parsed
     if (result == RequestParser::RequestStatus::valid)
     {
+        ++processed_requests;
+        keep_alive = current_request.keep_alive && keepalive_timeout > 0 &&
+                     processed_requests < keepalive_max_requests;
+
         current_request.endpoint = TCP_socket.remote_endpoint().address();
-        request_handler.HandleRequest(current_request, current_reply);
 
-        // compress the result w/ gzip/deflate if requested
-        switch (compression_type)
+        // the connection is idle until the job posts the reply back, nothing else touches the
+        // request or reply in the meantime
+        auto self = this->shared_from_this();
+        const bool queued = compute_pool.Post([this, self, compression_type](const bool expired) {
+            if (expired)
+            {
+                current_reply = http::reply::stock_reply(http::reply::service_unavailable);
+            }
+            else
+            {
+                request_handler.HandleRequest(current_request, current_reply);
+            }
+            strand.post(boost::bind(&Connection::write_reply, self, compression_type));
+        });
+
+        if (!queued)
         {
-        case http::deflate_rfc1951:
-            // use deflate for compression
-            current_reply.headers.insert(current_reply.headers.begin(),
-                                         {"Content-Encoding", "deflate"});
-            compressed_output = compress_buffers(current_reply.content, compression_type);
-            current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
-            output_buffer = current_reply.headers_to_buffers();
-            output_buffer.push_back(boost::asio::buffer(compressed_output));
-            break;
-        case http::gzip_rfc1952:
-            // use gzip for compression
-            current_reply.headers.insert(current_reply.headers.begin(),
-                                         {"Content-Encoding", "gzip"});
-            compressed_output = compress_buffers(current_reply.content, compression_type);
-            current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
-            output_buffer = current_reply.headers_to_buffers();
-            output_buffer.push_back(boost::asio::buffer(compressed_output));
-            break;
-        case http::no_compression:
-            // don't use any compression
-            current_reply.set_uncompressed_size();
-            output_buffer = current_reply.to_buffers();
-            break;
+            current_reply = http::reply::stock_reply(http::reply::service_unavailable);
+            write_reply(compression_type);
         }
-        // write result to stream
-        boost::asio::async_write(TCP_socket,
-                                 output_buffer,
-                                 strand.wrap(boost::bind(&Connection::handle_write,
-                                                         this->shared_from_this(),
-                                                         boost::asio::placeholders::error)));
     }
     else if (result == RequestParser::RequestStatus::invalid)
-    { // request is not parseable
+    { // request is not parseable, we can't know where a following request would start
+        keep_alive = false;
         current_reply = http::reply::stock_reply(http::reply::bad_request);
+        current_reply.headers.emplace_back("Connection", "close");
 
         boost::asio::async_write(TCP_socket,
                                  current_reply.to_buffers(),
@@ -102,24 +121,110 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
     else
     {
         // we don't have a result yet, so continue reading
-        TCP_socket.async_read_some(
-            boost::asio::buffer(incoming_data_buffer),
-            strand.wrap(boost::bind(&Connection::handle_read,
-                                    this->shared_from_this(),
-                                    boost::asio::placeholders::error,
-                                    boost::asio::placeholders::bytes_transferred)));
+        read_request();
+    }
+}
+
+void Connection::write_reply(const http::compression_type compression_type)
+{
+    if (keep_alive)
+    {
+        current_reply.headers.emplace_back("Connection", "keep-alive");
+        current_reply.headers.emplace_back(
+            "Keep-Alive",
+            "timeout=" + std::to_string(keepalive_timeout) + ", max=" +
+                std::to_string(keepalive_max_requests - processed_requests));
+    }
+    else
+    {
+        current_reply.headers.emplace_back("Connection", "close");
+    }
+
+    // compress the result w/ gzip/deflate if requested
+    switch (compression_type)
+    {
+    case http::deflate_rfc1951:
+        // use deflate for compression
+        current_reply.headers.insert(current_reply.headers.begin(),
+                                     {"Content-Encoding", "deflate"});
+        compressed_output = compress_buffers(current_reply.content, compression_type);
+        current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
+        output_buffer = current_reply.headers_to_buffers();
+        output_buffer.push_back(boost::asio::buffer(compressed_output));
+        break;
+    case http::gzip_rfc1952:
+        // use gzip for compression
+        current_reply.headers.insert(current_reply.headers.begin(),
+                                     {"Content-Encoding", "gzip"});
+        compressed_output = compress_buffers(current_reply.content, compression_type);
+        current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
+        output_buffer = current_reply.headers_to_buffers();
+        output_buffer.push_back(boost::asio::buffer(compressed_output));
+        break;
+    case http::no_compression:
+        // don't use any compression
+        current_reply.set_uncompressed_size();
+        output_buffer = current_reply.to_buffers();
+        break;
     }
+    // write result to stream
+    boost::asio::async_write(TCP_socket,
+                             output_buffer,
+                             strand.wrap(boost::bind(&Connection::handle_write,
+                                                     this->shared_from_this(),
+                                                     boost::asio::placeholders::error)));
 }
 
 /// Handle completion of a write operation.
 void Connection::handle_write(const boost::system::error_code &error)
 {
-    if (!error)
+    if (error)
+    {
+        return;
+    }
+
+    if (!keep_alive)
+    {
+        shutdown();
+        return;
+    }
+
+    // start over with a clean state for the next request on this connection
+    current_request = http::request();
+    current_reply = http::reply();
+    request_parser = RequestParser();
+    compressed_output.clear();
+    output_buffer.clear();
+
+    if (pending_data_begin != pending_data_end)
     {
-        // Initiate graceful connection closure.
-        boost::system::error_code ignore_error;
-        TCP_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_error);
+        // pipelined requests are answered in the order they arrived
+        process_request(pending_data_begin, pending_data_end);
     }
+    else
+    {
+        read_request();
+    }
+}
+
+void Connection::handle_timeout(const boost::system::error_code &error)
+{
+    // the timer was cancelled or moved because data arrived in the meantime
+    if (error == boost::asio::error::operation_aborted ||
+        timer.expires_at() > boost::asio::deadline_timer::traits_type::now())
+    {
+        return;
+    }
+
+    shutdown();
+}
+
+void Connection::shutdown()
+{
+    // Initiate graceful connection closure.
+    boost::system::error_code ignore_error;
+    TCP_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_error);
+    TCP_socket.close(ignore_error);
 }
 
 std::vector<char> Connection::compress_buffers(const std::vector<char> &uncompressed_data,
@@ -25,6 +25,7 @@
 #include <iostream>
 #include <iterator>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -62,8 +63,10 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         if (maybe_parsed_url && api_iterator == request_string.end())
         {
 
-            const engine::Status status =
-                service_handler->RunQuery(*std::move(maybe_parsed_url), result);
+            const engine::Status status = service_handler->RunQuery(*std::move(maybe_parsed_url),
+                                                                    current_request.method,
+                                                                    current_request.body,
+                                                                    result);
             if (status != engine::Status::Ok)
             {
                 // 4xx bad request return code
@@ -95,7 +98,7 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         }
 
         current_reply.headers.emplace_back("Access-Control-Allow-Origin", "*");
-        current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET");
+        current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET, POST");
         current_reply.headers.emplace_back("Access-Control-Allow-Headers",
                                            "X-Requested-With, Content-Type");
         if (result.is<util::json::Object>())
@@ -106,6 +109,14 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
 
             util::json::render(current_reply.content, result.get<util::json::Object>());
         }
+        else if (result.is<std::vector<char>>())
+        {
+            current_reply.headers.emplace_back("Content-Type", "application/json; charset=UTF-8");
+            current_reply.headers.emplace_back("Content-Disposition",
+                                               "inline; filename=\"response.json\"");
+
+            current_reply.content = std::move(result.get<std::vector<char>>());
+        }
         else
         {
             BOOST_ASSERT(result.is<std::string>());
@@ -6,6 +6,7 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <algorithm>
 #include <string>
 
 namespace osrm
@@ -15,24 +16,36 @@ namespace server
 
 RequestParser::RequestParser()
     : state(internal_state::method_start), current_header({"", ""}),
-      selected_compression(http::no_compression)
+      selected_compression(http::no_compression), http_version_major(0), http_version_minor(0),
+      content_length(0), connection_close(false), connection_keep_alive(false)
 {
 }
 
-std::tuple<RequestParser::RequestStatus, http::compression_type>
+std::tuple<RequestParser::RequestStatus, http::compression_type, char *>
 RequestParser::parse(http::request &current_request, char *begin, char *end)
 {
     while (begin != end)
     {
         RequestStatus result = consume(current_request, *begin++);
+        if (result == RequestStatus::valid)
+        {
+            if (http_version_major > 1 || (http_version_major == 1 && http_version_minor >= 1))
+            {
+                current_request.keep_alive = !connection_close;
+            }
+            else
+            {
+                current_request.keep_alive = connection_keep_alive;
+            }
+        }
         if (result != RequestStatus::indeterminate)
         {
-            return std::make_tuple(result, selected_compression);
+            return std::make_tuple(result, selected_compression, begin);
         }
     }
     RequestStatus result = RequestStatus::indeterminate;
 
-    return std::make_tuple(result, selected_compression);
+    return std::make_tuple(result, selected_compression, begin);
 }
 
 RequestParser::RequestStatus RequestParser::consume(http::request &current_request,
@@ -46,6 +59,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             return RequestStatus::invalid;
         }
         state = internal_state::method;
+        current_request.method.push_back(input);
         return RequestStatus::indeterminate;
     case internal_state::method:
         if (input == ' ')
@@ -57,6 +71,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         {
             return RequestStatus::invalid;
         }
+        current_request.method.push_back(input);
         return RequestStatus::indeterminate;
     case internal_state::uri_start:
         if (is_CTL(input))
@@ -116,6 +131,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
     case internal_state::http_version_major_start:
         if (is_digit(input))
         {
+            http_version_major = input - '0';
             state = internal_state::http_version_major;
             return RequestStatus::indeterminate;
         }
@@ -128,12 +144,14 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         }
         if (is_digit(input))
         {
+            http_version_major = http_version_major * 10 + input - '0';
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
     case internal_state::http_version_minor_start:
         if (is_digit(input))
         {
+            http_version_minor = input - '0';
             state = internal_state::http_version_minor;
             return RequestStatus::indeterminate;
         }
@@ -146,6 +164,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         }
         if (is_digit(input))
         {
+            http_version_minor = http_version_minor * 10 + input - '0';
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
@@ -180,6 +199,29 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             current_request.agent = current_header.value;
         }
 
+        if (boost::iequals(current_header.name, "Connection"))
+        {
+            connection_close = boost::icontains(current_header.value, "close");
+            connection_keep_alive = boost::icontains(current_header.value, "keep-alive");
+        }
+
+        if (boost::iequals(current_header.name, "Content-Length"))
+        {
+            if (current_header.value.empty() ||
+                !std::all_of(current_header.value.begin(),
+                             current_header.value.end(),
+                             [this](const char character) { return is_digit(character); }) ||
+                current_header.value.size() > 9)
+            {
+                return RequestStatus::invalid;
+            }
+            content_length = std::stoul(current_header.value);
+            if (content_length > MAX_CONTENT_LENGTH)
+            {
+                return RequestStatus::invalid;
+            }
+        }
+
         if (input == '\r')
         {
             state = internal_state::expecting_newline_3;
@@ -247,8 +289,27 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
-    default: // expecting_newline_3
-        return input == '\n' ? RequestStatus::valid : RequestStatus::invalid;
+    case internal_state::expecting_newline_3:
+        if (input != '\n')
+        {
+            return RequestStatus::invalid;
+        }
+        if (content_length > 0)
+        {
+            // only POST requests carry a body
+            if (current_request.method != "POST")
+            {
+                return RequestStatus::invalid;
+            }
+            // the body grows as it arrives instead of trusting Content-Length with an allocation
+            state = internal_state::content;
+            return RequestStatus::indeterminate;
+        }
+        return RequestStatus::valid;
+    default: // content
+        current_request.body.push_back(input);
+        return current_request.body.size() == content_length ? RequestStatus::valid
+                                                             : RequestStatus::indeterminate;
     }
 }
 
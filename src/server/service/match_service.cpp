@@ -5,9 +5,12 @@
 #include "engine/api/match_parameters.hpp"
 
 #include "util/json_container.hpp"
+#include "util/string_util.hpp"
 
 #include <boost/format.hpp>
 
+#include <sstream>
+
 namespace osrm
 {
 namespace server
@@ -32,7 +35,12 @@ std::string getWrongOptionHelp(const engine::api::MatchParameters &parameters)
         constrainParamSize(
             PARAMETER_SIZE_MISMATCH_MSG, "timestamps", parameters.timestamps, coord_size, help);
 
-    if (!param_size_mismatch && parameters.coordinates.size() < 2)
+    if (!param_size_mismatch && parameters.coordinates.empty())
+    {
+        help = "Number of coordinates needs to be at least one.";
+    }
+    else if (!param_size_mismatch && parameters.coordinates.size() < 2 &&
+             parameters.session.empty())
     {
         help = "Number of coordinates needs to be at least two.";
     }
@@ -70,6 +78,59 @@ MatchService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &r
 
     return BaseService::routing_machine.Match(*parameters, json_result);
 }
+
+engine::Status MatchService::RunBatchQuery(const std::string &queries, ResultT &result)
+{
+    result = util::json::Object();
+    auto &json_result = result.get<util::json::Object>();
+
+    // every line holds the url encoded query of one trace, as it would follow the profile in
+    // the url of a single request
+    std::vector<engine::api::MatchParameters> batch_parameters;
+    std::istringstream lines(queries);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (line.empty())
+        {
+            continue;
+        }
+
+        const auto trace = "trace " + std::to_string(batch_parameters.size());
+        std::string query;
+        util::URIDecode(line, query);
+
+        auto query_iterator = query.begin();
+        auto parameters =
+            api::parseParameters<engine::api::MatchParameters>(query_iterator, query.end());
+        if (!parameters || query_iterator != query.end())
+        {
+            const auto position = std::distance(query.begin(), query_iterator);
+            json_result.values["code"] = "InvalidQuery";
+            json_result.values["message"] = "Query string of " + trace +
+                                            " malformed close to position " +
+                                            std::to_string(position);
+            return engine::Status::Error;
+        }
+
+        BOOST_ASSERT(parameters);
+        if (!parameters->IsValid())
+        {
+            json_result.values["code"] = "InvalidOptions";
+            json_result.values["message"] = getWrongOptionHelp(*parameters) + " (" + trace + ")";
+            return engine::Status::Error;
+        }
+        BOOST_ASSERT(parameters->IsValid());
+
+        batch_parameters.push_back(std::move(*parameters));
+    }
+
+    return BaseService::routing_machine.Match(batch_parameters, json_result);
+}
 }
 }
 }
@@ -85,7 +85,15 @@ TableService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &r
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    return BaseService::routing_machine.Table(*parameters, json_result);
+    if (parameters->format == engine::api::TableParameters::FormatType::Protobuf)
+    {
+        result = std::string();
+        return BaseService::routing_machine.Table(*parameters, result.get<std::string>());
+    }
+
+    // large tables are much cheaper to stream than to build as a json::Object first
+    result = std::vector<char>();
+    return BaseService::routing_machine.Table(*parameters, result.get<std::vector<char>>());
 }
 }
 }
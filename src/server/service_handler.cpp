@@ -27,6 +27,8 @@ ServiceHandler::ServiceHandler(osrm::EngineConfig &config) : routing_machine(con
 }
 
 engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
+                                        const std::string &method,
+                                        const std::string &body,
                                         service::BaseService::ResultT &result)
 {
     const auto &service_iter = service_map.find(parsed_url.service);
@@ -49,6 +51,24 @@ engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
         return engine::Status::Error;
     }
 
+    // the queries of a batch are posted in the request body instead of the url, all other
+    // requests are sent without a body
+    const bool is_batch = parsed_url.query == "batch";
+    if (is_batch != (method == "POST"))
+    {
+        result = util::json::Object();
+        auto &json_result = result.get<util::json::Object>();
+        json_result.values["code"] = "InvalidUrl";
+        json_result.values["message"] = is_batch ? "Batch requests need to be sent with POST"
+                                                 : "Only batch requests can be sent with POST";
+        return engine::Status::Error;
+    }
+
+    if (is_batch)
+    {
+        return service->RunBatchQuery(body, result);
+    }
+
     return service->RunQuery(parsed_url.prefix_length, parsed_url.query, result);
 }
 }
@@ -21,6 +21,7 @@
 #include "util/simple_logger.hpp"
 #include "util/static_graph.hpp"
 #include "util/static_rtree.hpp"
+#include "util/timing_util.hpp"
 #include "util/typedefs.hpp"
 
 #ifdef __linux__
@@ -28,19 +29,28 @@
 #endif
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/sync/named_sharable_mutex.hpp>
 #include <boost/interprocess/sync/named_upgradable_mutex.hpp>
 #include <boost/interprocess/sync/scoped_lock.hpp>
 #include <boost/interprocess/sync/upgradable_lock.hpp>
 
+#include <tbb/parallel_for.h>
+
 #include <cstdint>
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <new>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace osrm
 {
@@ -48,11 +58,15 @@ namespace storage
 {
 
 using RTreeLeaf = engine::datafacade::BaseDataFacade::RTreeLeaf;
-using RTreeNode =
-    util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, true>::vector, true>::TreeNode;
-using QueryGraph = util::StaticGraph<contractor::QueryEdge::EdgeData>;
+using RTree = util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, true>::vector, true>;
+using RTreeNode = RTree::TreeNode;
+using RTreeLeafNode = RTree::LeafNode;
+using QueryGraph = util::StaticGraph<contractor::QueryEdge::SearchData>;
 
-Storage::Storage(StorageConfig config_) : config(std::move(config_)) {}
+Storage::Storage(StorageConfig config_, const bool load_rtree_leaves_)
+    : config(std::move(config_)), load_rtree_leaves(load_rtree_leaves_)
+{
+}
 
 struct RegionsLayout
 {
@@ -90,7 +104,7 @@ RegionsLayout getRegionsLayout(SharedBarriers &barriers)
         LAYOUT_2, DATA_2, barriers.regions_2_mutex, LAYOUT_1, DATA_1, barriers.regions_1_mutex};
 }
 
-Storage::ReturnCode Storage::Run(int max_wait)
+Storage::ReturnCode Storage::Run(int max_wait, const HugePages huge_pages)
 {
     BOOST_ASSERT_MSG(config.IsValid(), "Invalid storage config");
 
@@ -189,8 +203,10 @@ Storage::ReturnCode Storage::Run(int max_wait)
 
     // allocate shared memory block
     util::SimpleLogger().Write() << "allocating shared memory of "
-                                 << shared_layout_ptr->GetSizeOfLayout() << " bytes";
-    auto shared_memory = makeSharedMemory(data_region, shared_layout_ptr->GetSizeOfLayout(), true);
+                                 << shared_layout_ptr->GetSizeOfLayout() << " bytes, huge pages: "
+                                 << toString(huge_pages);
+    auto shared_memory =
+        makeSharedMemory(data_region, shared_layout_ptr->GetSizeOfLayout(), true, huge_pages);
     char *shared_memory_ptr = static_cast<char *>(shared_memory->Ptr());
 
     PopulateData(*shared_layout_ptr, shared_memory_ptr);
@@ -274,15 +290,16 @@ void Storage::PopulateLayout(DataLayout &layout)
     }
 
     {
-        std::vector<std::uint32_t> lane_description_offsets;
-        std::vector<extractor::guidance::TurnLaneType::Mask> lane_description_masks;
-        util::deserializeAdjacencyArray(config.turn_lane_description_path.string(),
-                                        lane_description_offsets,
-                                        lane_description_masks);
+        io::FileReader lane_description_file(config.turn_lane_description_path,
+                                             io::FileReader::HasNoFingerprint);
+        const auto lane_description_offsets_count = lane_description_file.ReadElementCount64();
+        lane_description_file.Skip<std::uint32_t>(lane_description_offsets_count);
+        const auto lane_description_masks_count = lane_description_file.ReadElementCount64();
+
         layout.SetBlockSize<std::uint32_t>(DataLayout::LANE_DESCRIPTION_OFFSETS,
-                                           lane_description_offsets.size());
+                                           lane_description_offsets_count);
         layout.SetBlockSize<extractor::guidance::TurnLaneType::Mask>(
-            DataLayout::LANE_DESCRIPTION_MASKS, lane_description_masks.size());
+            DataLayout::LANE_DESCRIPTION_MASKS, lane_description_masks_count);
     }
 
     // Loading information for original edges
@@ -314,6 +331,8 @@ void Storage::PopulateLayout(DataLayout &layout)
                                                         hsgr_header.number_of_nodes);
         layout.SetBlockSize<QueryGraph::EdgeArrayEntry>(DataLayout::GRAPH_EDGE_LIST,
                                                         hsgr_header.number_of_edges);
+        layout.SetBlockSize<contractor::QueryEdge::UnpackingData>(
+            DataLayout::GRAPH_EDGE_UNPACKING_LIST, hsgr_header.number_of_edges);
     }
 
     // load rsearch tree size
@@ -324,6 +343,18 @@ void Storage::PopulateLayout(DataLayout &layout)
         layout.SetBlockSize<RTreeNode>(DataLayout::R_SEARCH_TREE, tree_size);
     }
 
+    // the leaf node file is a plain array of leaves, without leaves it stays mapped from disk
+    if (load_rtree_leaves)
+    {
+        io::FileReader leaf_node_file(config.file_index_path, io::FileReader::HasNoFingerprint);
+        layout.SetBlockSize<RTreeLeafNode>(DataLayout::R_TREE_LEAVES,
+                                           leaf_node_file.Size() / sizeof(RTreeLeafNode));
+    }
+    else
+    {
+        layout.SetBlockSize<RTreeLeafNode>(DataLayout::R_TREE_LEAVES, 0);
+    }
+
     {
         // allocate space in shared memory for profile properties
         const auto properties_size = io::readPropertiesCount();
@@ -405,11 +436,10 @@ void Storage::PopulateLayout(DataLayout &layout)
         io::FileReader intersection_file(config.intersection_class_path,
                                          io::FileReader::VerifyFingerprint);
 
-        std::vector<BearingClassID> bearing_class_id_table;
-        intersection_file.DeserializeVector(bearing_class_id_table);
+        const auto bearing_class_id_count = intersection_file.ReadElementCount64();
+        intersection_file.Skip<BearingClassID>(bearing_class_id_count);
 
-        layout.SetBlockSize<BearingClassID>(DataLayout::BEARING_CLASSID,
-                                            bearing_class_id_table.size());
+        layout.SetBlockSize<BearingClassID>(DataLayout::BEARING_CLASSID, bearing_class_id_count);
 
         const auto bearing_blocks = intersection_file.ReadElementCount32();
         intersection_file.Skip<std::uint32_t>(1); // sum_lengths
@@ -429,11 +459,9 @@ void Storage::PopulateLayout(DataLayout &layout)
 
         layout.SetBlockSize<DiscreteBearing>(DataLayout::BEARING_VALUES, num_bearings);
 
-        std::vector<util::guidance::EntryClass> entry_class_table;
-        intersection_file.DeserializeVector(entry_class_table);
-
+        const auto entry_class_count = intersection_file.ReadElementCount64();
         layout.SetBlockSize<util::guidance::EntryClass>(DataLayout::ENTRY_CLASS,
-                                                        entry_class_table.size());
+                                                        entry_class_count);
     }
 
     {
@@ -445,6 +473,10 @@ void Storage::PopulateLayout(DataLayout &layout)
     }
 }
 
+/**
+ * Reads all data files into the memory block described by the layout. The files are loaded
+ * by one loader each, which run concurrently and report how long they took.
+ */
 void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
 {
     BOOST_ASSERT(memory_ptr != nullptr);
@@ -452,7 +484,7 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
     // read actual data into shared memory object //
 
     // Load the HSGR file
-    {
+    const auto load_graph = [&] {
         io::FileReader hsgr_file(config.hsgr_data_path, io::FileReader::HasNoFingerprint);
         auto hsgr_header = io::readHSGRHeader(hsgr_file);
         unsigned *checksum_ptr =
@@ -469,15 +501,21 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<QueryGraph::EdgeArrayEntry, true>(memory_ptr,
                                                                  DataLayout::GRAPH_EDGE_LIST);
 
+        // load the data for unpacking the edges
+        const auto graph_edge_unpacking_list_ptr =
+            layout.GetBlockPtr<contractor::QueryEdge::UnpackingData, true>(
+                memory_ptr, DataLayout::GRAPH_EDGE_UNPACKING_LIST);
+
         io::readHSGR(hsgr_file,
                      graph_node_list_ptr,
                      hsgr_header.number_of_nodes,
                      graph_edge_list_ptr,
+                     graph_edge_unpacking_list_ptr,
                      hsgr_header.number_of_edges);
-    }
+    };
 
     // store the filename of the on-disk portion of the RTree
-    {
+    const auto store_file_index_path = [&] {
         const auto file_index_path_ptr =
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::FILE_INDEX_PATH);
         // make sure we have 0 ending
@@ -490,10 +528,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                      absolute_file_index_path.size());
         std::copy(
             absolute_file_index_path.begin(), absolute_file_index_path.end(), file_index_path_ptr);
-    }
+    };
 
     // Name data
-    {
+    const auto load_names = [&] {
         io::FileReader name_file(config.names_data_path, io::FileReader::HasNoFingerprint);
         const auto name_blocks_count = name_file.ReadElementCount32();
         name_file.Skip<std::uint32_t>(1); // name_char_list_count
@@ -524,10 +562,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                          "Name file corrupted!");
 
         name_file.ReadInto(name_char_ptr, temp_count);
-    }
+    };
 
     // Turn lane data
-    {
+    const auto load_turn_lane_data = [&] {
         io::FileReader lane_data_file(config.turn_lane_data_path, io::FileReader::HasNoFingerprint);
 
         const auto lane_tuple_count = lane_data_file.ReadElementCount64();
@@ -539,10 +577,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
         BOOST_ASSERT(lane_tuple_count * sizeof(util::guidance::LaneTupleIdPair) ==
                      layout.GetBlockSize(DataLayout::TURN_LANE_DATA));
         lane_data_file.ReadInto(turn_lane_data_ptr, lane_tuple_count);
-    }
+    };
 
     // Turn lane descriptions
-    {
+    const auto load_turn_lane_descriptions = [&] {
         std::vector<std::uint32_t> lane_description_offsets;
         std::vector<extractor::guidance::TurnLaneType::Mask> lane_description_masks;
         util::deserializeAdjacencyArray(config.turn_lane_description_path.string(),
@@ -575,10 +613,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             std::copy(
                 lane_description_masks.begin(), lane_description_masks.end(), turn_lane_mask_ptr);
         }
-    }
+    };
 
     // Load original edge data
-    {
+    const auto load_edges = [&] {
         io::FileReader edges_input_file(config.edges_data_path, io::FileReader::HasNoFingerprint);
 
         const auto number_of_original_edges = edges_input_file.ReadElementCount64();
@@ -616,10 +654,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                       pre_turn_bearing_ptr,
                       post_turn_bearing_ptr,
                       number_of_original_edges);
-    }
+    };
 
     // load compressed geometry
-    {
+    const auto load_geometries = [&] {
         io::FileReader geometry_input_file(config.geometries_path,
                                            io::FileReader::HasNoFingerprint);
 
@@ -647,9 +685,9 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
         BOOST_ASSERT(geometry_node_lists_count ==
                      layout.num_entries[DataLayout::GEOMETRIES_REV_WEIGHT_LIST]);
         geometry_input_file.ReadInto(geometries_rev_weight_list_ptr, geometry_node_lists_count);
-    }
+    };
 
-    {
+    const auto load_datasource_indexes = [&] {
         io::FileReader geometry_datasource_file(config.datasource_indexes_path,
                                                 io::FileReader::HasNoFingerprint);
         const auto number_of_compressed_datasources = geometry_datasource_file.ReadElementCount64();
@@ -662,9 +700,9 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             io::readDatasourceIndexes(
                 geometry_datasource_file, datasources_list_ptr, number_of_compressed_datasources);
         }
-    }
+    };
 
-    {
+    const auto load_datasource_names = [&] {
         /* Load names */
         io::FileReader datasource_names_file(config.datasource_names_path,
                                              io::FileReader::HasNoFingerprint);
@@ -710,10 +748,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                       datasource_names_data.lengths.end(),
                       datasource_name_lengths_ptr);
         }
-    }
+    };
 
     // Loading list of coordinates
-    {
+    const auto load_nodes = [&] {
         io::FileReader nodes_file(config.nodes_data_path, io::FileReader::HasNoFingerprint);
         nodes_file.Skip<std::uint64_t>(1); // node_count
         const auto coordinates_ptr =
@@ -728,10 +766,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                       coordinates_ptr,
                       osmnodeid_list,
                       layout.num_entries[DataLayout::COORDINATE_LIST]);
-    }
+    };
 
     // store timestamp
-    {
+    const auto load_timestamp = [&] {
         io::FileReader timestamp_file(config.timestamp_path, io::FileReader::HasNoFingerprint);
         const auto timestamp_size = timestamp_file.Size();
 
@@ -739,10 +777,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::TIMESTAMP);
         BOOST_ASSERT(timestamp_size == layout.num_entries[DataLayout::TIMESTAMP]);
         timestamp_file.ReadInto(timestamp_ptr, timestamp_size);
-    }
+    };
 
     // store search tree portion of rtree
-    {
+    const auto load_rtree = [&] {
         io::FileReader tree_node_file(config.ram_index_path, io::FileReader::HasNoFingerprint);
         // perform this read so that we're at the right stream position for the next
         // read.
@@ -751,9 +789,21 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<RTreeNode, true>(memory_ptr, DataLayout::R_SEARCH_TREE);
 
         tree_node_file.ReadInto(rtree_ptr, layout.num_entries[DataLayout::R_SEARCH_TREE]);
-    }
+    };
 
-    {
+    // the leaves are only loaded if requested, see PopulateLayout
+    const auto load_rtree_leaf_nodes = [&] {
+        const auto number_of_leaves = layout.num_entries[DataLayout::R_TREE_LEAVES];
+        if (number_of_leaves == 0)
+            return;
+
+        io::FileReader leaf_node_file(config.file_index_path, io::FileReader::HasNoFingerprint);
+        const auto leaves_ptr =
+            layout.GetBlockPtr<RTreeLeafNode, true>(memory_ptr, DataLayout::R_TREE_LEAVES);
+        leaf_node_file.ReadInto(leaves_ptr, number_of_leaves);
+    };
+
+    const auto load_core_markers = [&] {
         io::FileReader core_marker_file(config.core_data_path, io::FileReader::HasNoFingerprint);
         const auto number_of_core_markers = core_marker_file.ReadElementCount32();
 
@@ -784,20 +834,20 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                 core_marker_ptr[bucket] = (value | (1u << offset));
             }
         }
-    }
+    };
 
     // load profile properties
-    {
+    const auto load_profile_properties = [&] {
         io::FileReader profile_properties_file(config.properties_path,
                                                io::FileReader::HasNoFingerprint);
         const auto profile_properties_ptr = layout.GetBlockPtr<extractor::ProfileProperties, true>(
             memory_ptr, DataLayout::PROPERTIES);
         profile_properties_file.ReadInto(profile_properties_ptr,
                                          layout.num_entries[DataLayout::PROPERTIES]);
-    }
+    };
 
     // Load intersection data
-    {
+    const auto load_intersection_classes = [&] {
         io::FileReader intersection_file(config.intersection_class_path,
                                          io::FileReader::VerifyFingerprint);
 
@@ -878,6 +928,162 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                              sizeof(decltype(entry_class_table)::value_type));
             std::copy(entry_class_table.begin(), entry_class_table.end(), entry_class_ptr);
         }
+    };
+
+    // Every loader reads its own files straight into its own blocks of the layout, so they can
+    // run concurrently without any locking.
+    const std::vector<std::pair<const char *, std::function<void()>>> loaders = {
+        {"search graph", load_graph},
+        {"original edges", load_edges},
+        {"geometries", load_geometries},
+        {"nodes", load_nodes},
+        {"r-tree", load_rtree},
+        {"r-tree leaves", load_rtree_leaf_nodes},
+        {"names", load_names},
+        {"datasource indexes", load_datasource_indexes},
+        {"intersection classes", load_intersection_classes},
+        {"turn lane data", load_turn_lane_data},
+        {"turn lane descriptions", load_turn_lane_descriptions},
+        {"core markers", load_core_markers},
+        {"datasource names", load_datasource_names},
+        {"profile properties", load_profile_properties},
+        {"timestamp", load_timestamp},
+        {"file index path", store_file_index_path}};
+
+    TIMER_START(populate_data);
+    tbb::parallel_for(std::size_t{0}, loaders.size(), [&](const std::size_t index) {
+        TIMER_START(load_block);
+        loaders[index].second();
+        TIMER_STOP(load_block);
+        util::SimpleLogger().Write() << "loaded " << loaders[index].first << " in "
+                                     << TIMER_MSEC(load_block) << "ms";
+    });
+    TIMER_STOP(populate_data);
+    util::SimpleLogger().Write() << "loaded all data blocks in " << TIMER_SEC(populate_data)
+                                 << "s";
+}
+
+bool Storage::IsMemoryImageValid() const
+{
+    const auto &image_path = config.memory_image_path;
+    if (image_path.empty() || !boost::filesystem::is_regular_file(image_path))
+    {
+        return false;
+    }
+
+    // any data file that was updated after the image was written makes it stale
+    const boost::filesystem::path data_paths[] = {config.ram_index_path,
+                                                  config.file_index_path,
+                                                  config.hsgr_data_path,
+                                                  config.nodes_data_path,
+                                                  config.edges_data_path,
+                                                  config.core_data_path,
+                                                  config.geometries_path,
+                                                  config.timestamp_path,
+                                                  config.datasource_names_path,
+                                                  config.datasource_indexes_path,
+                                                  config.names_data_path,
+                                                  config.properties_path,
+                                                  config.intersection_class_path,
+                                                  config.turn_lane_data_path,
+                                                  config.turn_lane_description_path};
+    const auto image_time = boost::filesystem::last_write_time(image_path);
+    for (const auto &path : data_paths)
+    {
+        if (boost::filesystem::exists(path) &&
+            boost::filesystem::last_write_time(path) > image_time)
+        {
+            util::SimpleLogger().Write() << path.string() << " is newer than "
+                                         << image_path.string();
+            return false;
+        }
+    }
+
+    io::FileReader image_file(image_path, io::FileReader::HasNoFingerprint);
+    if (!image_file.ReadAndCheckFingerprint())
+    {
+        util::SimpleLogger().Write(logWARNING) << image_path.string()
+                                               << " was written by another version";
+        return false;
+    }
+
+    const auto layout_version = image_file.ReadOne<std::uint32_t>();
+    const auto number_of_blocks = image_file.ReadOne<std::uint32_t>();
+    if (layout_version != MEMORY_IMAGE_LAYOUT_VERSION ||
+        number_of_blocks != static_cast<std::uint32_t>(DataLayout::NUM_BLOCKS))
+    {
+        util::SimpleLogger().Write(logWARNING) << image_path.string()
+                                               << " has a different data layout";
+        return false;
+    }
+
+    const auto data_offset = image_file.ReadOne<std::uint64_t>();
+    const auto layout = image_file.ReadOne<DataLayout>();
+    return image_file.Size() >= data_offset + layout.GetSizeOfLayout();
+}
+
+/**
+ * Writes the layout and the data block into the memory image. The image is written to a
+ * temporary file first and moved in place afterwards, so processes that map it concurrently
+ * never see a partially written image.
+ */
+void Storage::WriteMemoryImage()
+{
+    const auto &image_path = config.memory_image_path;
+    if (image_path.empty())
+    {
+        throw util::exception("No path for the memory image given");
+    }
+
+    const boost::filesystem::path temporary_path =
+        image_path.string() + boost::filesystem::unique_path(".%%%%-%%%%.tmp").string();
+
+    try
+    {
+        DataLayout layout;
+        PopulateLayout(layout);
+
+        const std::uint64_t page_size = boost::interprocess::mapped_region::get_page_size();
+        const std::uint64_t data_offset =
+            (sizeof(MemoryImageHeader) + page_size - 1) / page_size * page_size;
+        const auto image_size = data_offset + layout.GetSizeOfLayout();
+
+        util::SimpleLogger().Write() << "writing memory image of " << image_size << " bytes to "
+                                     << image_path.string();
+        {
+            boost::filesystem::ofstream image_file(temporary_path, std::ios::binary);
+            if (!image_file)
+            {
+                throw util::exception("Could not create " + temporary_path.string());
+            }
+        }
+        boost::filesystem::resize_file(temporary_path, image_size);
+
+        const boost::interprocess::file_mapping mapping(temporary_path.string().c_str(),
+                                                        boost::interprocess::read_write);
+        boost::interprocess::mapped_region region(mapping, boost::interprocess::read_write);
+        char *image_ptr = static_cast<char *>(region.get_address());
+
+        auto header = new (image_ptr) MemoryImageHeader();
+        header->fingerprint = util::FingerPrint::GetValid();
+        header->layout_version = MEMORY_IMAGE_LAYOUT_VERSION;
+        header->number_of_blocks = DataLayout::NUM_BLOCKS;
+        header->data_offset = data_offset;
+        header->layout = layout;
+
+        PopulateData(header->layout, image_ptr + data_offset);
+
+        if (!region.flush())
+        {
+            throw util::exception("Could not write " + temporary_path.string());
+        }
+        boost::filesystem::rename(temporary_path, image_path);
+    }
+    catch (...)
+    {
+        boost::system::error_code ignored;
+        boost::filesystem::remove(temporary_path, ignored);
+        throw;
     }
 }
 }
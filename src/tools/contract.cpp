@@ -53,6 +53,15 @@ return_code parseArguments(int argc, char *argv[], contractor::ContractorConfig
         boost::program_options::value<bool>(&contractor_config.use_cached_priority)
             ->default_value(false),
         "Use .level file to retain the contaction level for each node from the last run.")(
+        "update-weights-only",
+        boost::program_options::value<bool>(&contractor_config.update_weights_only)
+            ->default_value(false),
+        "Keep the shortcuts of the existing .hsgr and only recompute their weights for the "
+        "updated speeds instead of contracting again.")(
+        "renumber-nodes",
+        boost::program_options::value<bool>(&contractor_config.renumber_nodes)
+            ->default_value(false),
+        "Renumber the nodes by their level in the hierarchy so queries touch less memory.")(
         "edge-weight-updates-over-factor",
         boost::program_options::value<double>(&contractor_config.log_edge_updates_factor)
             ->default_value(0.0),
@@ -14,6 +14,7 @@
 #include <sys/mman.h>
 #endif
 
+#include <cstddef>
 #include <cstdlib>
 
 #include <signal.h>
@@ -58,12 +59,27 @@ inline unsigned generateServerProgramOptions(const int argc,
                                              std::string &ip_address,
                                              int &ip_port,
                                              int &requested_num_threads,
+                                             int &requested_num_io_threads,
+                                             unsigned &max_queue_size,
+                                             unsigned &max_queue_wait,
+                                             unsigned &keepalive_timeout,
+                                             unsigned &keepalive_max_requests,
                                              bool &use_shared_memory,
+                                             bool &use_mmap,
+                                             std::string &huge_pages,
+                                             bool &prefault_memory,
+                                             std::size_t &snapping_cache_size,
+                                             std::size_t &max_matching_sessions,
+                                             unsigned &matching_session_timeout,
+                                             std::size_t &tile_cache_size,
+                                             boost::filesystem::path &tile_archive_path,
                                              bool &trial,
                                              int &max_locations_trip,
                                              int &max_locations_viaroute,
+                                             int &max_alternatives,
                                              int &max_locations_distance_table,
                                              int &max_locations_map_matching,
+                                             int &max_traces_map_matching,
                                              int &max_results_nearest)
 {
     using boost::program_options::value;
@@ -86,13 +102,57 @@ inline unsigned generateServerProgramOptions(const int argc,
          "TCP/IP port") //
         ("threads,t",
          value<int>(&requested_num_threads)->default_value(8),
-         "Number of threads to use") //
+         "Number of threads answering queries") //
+        ("io-threads",
+         value<int>(&requested_num_io_threads)->default_value(2),
+         "Number of threads handling connections") //
+        ("max-queue-size",
+         value<unsigned>(&max_queue_size)->default_value(1024),
+         "Max. queries waiting for a thread before new ones are rejected with 503") //
+        ("max-queue-wait",
+         value<unsigned>(&max_queue_wait)->default_value(0),
+         "Milliseconds a query may wait for a thread before it is rejected with 503, 0 for "
+         "no limit") //
+        ("keepalive-timeout",
+         value<unsigned>(&keepalive_timeout)->default_value(5),
+         "Seconds an idle connection is kept open, 0 disables keep-alive") //
+        ("keepalive-requests",
+         value<unsigned>(&keepalive_max_requests)->default_value(512),
+         "Max. requests served over a single connection") //
         ("shared-memory,s",
          value<bool>(&use_shared_memory)->implicit_value(true)->default_value(false),
          "Load data from shared memory") //
+        ("mmap",
+         value<bool>(&use_mmap)->implicit_value(true)->default_value(false),
+         "Map the data files instead of loading them, writes <base.osrm>.mmap on first use") //
+        ("huge-pages",
+         value<std::string>(&huge_pages)->default_value("none"),
+         "Back the loaded data with huge pages: none, transparent or explicit") //
+        ("prefault",
+         value<bool>(&prefault_memory)->implicit_value(true)->default_value(false),
+         "Touch all mapped data on startup so the first queries do not fault it in") //
+        ("snapping-cache-size",
+         value<std::size_t>(&snapping_cache_size)->default_value(0),
+         "Number of snapped coordinates cached across route, table and trip requests, 0 "
+         "disables the cache") //
+        ("max-matching-sessions",
+         value<std::size_t>(&max_matching_sessions)->default_value(0),
+         "Number of online map matching sessions kept, 0 disables them") //
+        ("matching-session-timeout",
+         value<unsigned>(&matching_session_timeout)->default_value(60),
+         "Seconds an unused online map matching session is kept") //
+        ("tile-cache-size",
+         value<std::size_t>(&tile_cache_size)->default_value(0),
+         "Megabytes of rendered debug tiles cached across requests, 0 disables the cache") //
+        ("tile-archive",
+         value<boost::filesystem::path>(&tile_archive_path),
+         "Debug tiles rendered ahead of time by osrm-tiles") //
         ("max-viaroute-size",
          value<int>(&max_locations_viaroute)->default_value(500),
          "Max. locations supported in viaroute query") //
+        ("max-alternatives",
+         value<int>(&max_alternatives)->default_value(3),
+         "Max. number of alternatives supported in route query") //
         ("max-trip-size",
          value<int>(&max_locations_trip)->default_value(100),
          "Max. locations supported in trip query") //
@@ -102,6 +162,9 @@ inline unsigned generateServerProgramOptions(const int argc,
         ("max-matching-size",
          value<int>(&max_locations_map_matching)->default_value(100),
          "Max. locations supported in map matching query") //
+        ("max-matching-traces",
+         value<int>(&max_traces_map_matching)->default_value(1000),
+         "Max. traces supported in batch map matching query") //
         ("max-nearest-size",
          value<int>(&max_results_nearest)->default_value(100),
          "Max. results supported in nearest query");
@@ -154,7 +217,11 @@ inline unsigned generateServerProgramOptions(const int argc,
 
     boost::program_options::notify(option_variables);
 
-    if (!use_shared_memory && option_variables.count("base"))
+    if (use_shared_memory && use_mmap)
+    {
+        util::SimpleLogger().Write(logWARNING) << "Shared memory settings conflict with mmap.";
+    }
+    else if (!use_shared_memory && option_variables.count("base"))
     {
         return INIT_OK_START_ENGINE;
     }
@@ -167,6 +234,10 @@ inline unsigned generateServerProgramOptions(const int argc,
         util::SimpleLogger().Write(logWARNING)
             << "Shared memory settings conflict with path settings.";
     }
+    else if (use_mmap)
+    {
+        util::SimpleLogger().Write(logWARNING) << "Memory mapping needs a path to the data files.";
+    }
 
     util::SimpleLogger().Write() << visible_options;
     return INIT_OK_DO_NOT_START_ENGINE;
@@ -178,7 +249,10 @@ int main(int argc, const char *argv[]) try
 
     bool trial_run = false;
     std::string ip_address;
-    int ip_port, requested_thread_num;
+    int ip_port, requested_thread_num, requested_io_thread_num;
+    unsigned max_queue_size, max_queue_wait, keepalive_timeout, keepalive_max_requests;
+    std::string huge_pages;
+    std::size_t tile_cache_megabytes;
 
     EngineConfig config;
     boost::filesystem::path base_path;
@@ -188,12 +262,27 @@ int main(int argc, const char *argv[]) try
                                                               ip_address,
                                                               ip_port,
                                                               requested_thread_num,
+                                                              requested_io_thread_num,
+                                                              max_queue_size,
+                                                              max_queue_wait,
+                                                              keepalive_timeout,
+                                                              keepalive_max_requests,
                                                               config.use_shared_memory,
+                                                              config.use_mmap,
+                                                              huge_pages,
+                                                              config.prefault_memory,
+                                                              config.snapping_cache_size,
+                                                              config.max_matching_sessions,
+                                                              config.matching_session_timeout,
+                                                              tile_cache_megabytes,
+                                                              config.tile_archive_path,
                                                               trial_run,
                                                               config.max_locations_trip,
                                                               config.max_locations_viaroute,
+                                                              config.max_alternatives,
                                                               config.max_locations_distance_table,
                                                               config.max_locations_map_matching,
+                                                              config.max_traces_map_matching,
                                                               config.max_results_nearest);
     if (init_result == INIT_OK_DO_NOT_START_ENGINE)
     {
@@ -203,6 +292,8 @@ int main(int argc, const char *argv[]) try
     {
         return EXIT_FAILURE;
     }
+    config.huge_pages = storage::parseHugePages(huge_pages);
+    config.tile_cache_size = tile_cache_megabytes * 1024 * 1024;
     if (!base_path.empty())
     {
         config.storage_config = storage::StorageConfig(base_path);
@@ -304,10 +395,45 @@ int main(int argc, const char *argv[]) try
     {
         util::SimpleLogger().Write() << "Loading from shared memory";
     }
+    else if (config.use_mmap)
+    {
+        util::SimpleLogger().Write() << "Mapping data files into memory";
+    }
+    else
+    {
+        util::SimpleLogger().Write() << "Huge pages: " << storage::toString(config.huge_pages);
+    }
+
+    if (config.snapping_cache_size > 0)
+    {
+        util::SimpleLogger().Write() << "Snapping cache: " << config.snapping_cache_size
+                                     << " coordinates";
+    }
+
+    if (config.max_matching_sessions > 0)
+    {
+        util::SimpleLogger().Write() << "Matching sessions: " << config.max_matching_sessions
+                                     << ", timeout " << config.matching_session_timeout << "s";
+    }
+
+    if (config.tile_cache_size > 0)
+    {
+        util::SimpleLogger().Write() << "Tile cache: " << tile_cache_megabytes << " MB";
+    }
+
+    if (!config.tile_archive_path.empty())
+    {
+        util::SimpleLogger().Write() << "Tile archive: " << config.tile_archive_path.string();
+    }
 
     util::SimpleLogger().Write() << "Threads: " << requested_thread_num;
+    util::SimpleLogger().Write() << "I/O threads: " << requested_io_thread_num;
+    util::SimpleLogger().Write() << "Queue: " << max_queue_size << " queries, "
+                                 << max_queue_wait << "ms";
     util::SimpleLogger().Write() << "IP address: " << ip_address;
     util::SimpleLogger().Write() << "IP port: " << ip_port;
+    util::SimpleLogger().Write() << "Keep-alive: " << keepalive_timeout << "s, "
+                                 << keepalive_max_requests << " requests";
 
 #ifndef _WIN32
     int sig = 0;
@@ -317,7 +443,14 @@ int main(int argc, const char *argv[]) try
     pthread_sigmask(SIG_BLOCK, &new_mask, &old_mask);
 #endif
 
-    auto routing_server = server::Server::CreateServer(ip_address, ip_port, requested_thread_num);
+    auto routing_server = server::Server::CreateServer(ip_address,
+                                                       ip_port,
+                                                       requested_thread_num,
+                                                       requested_io_thread_num,
+                                                       max_queue_size,
+                                                       max_queue_wait,
+                                                       keepalive_timeout,
+                                                       keepalive_max_requests);
     auto service_handler = std::make_unique<server::ServiceHandler>(config);
 
     routing_server->RegisterServiceHandler(std::move(service_handler));
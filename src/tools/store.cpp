@@ -7,13 +7,17 @@
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <string>
+
 using namespace osrm;
 
 // generate boost::program_options object for the routing part
 bool generateDataStoreOptions(const int argc,
                               const char *argv[],
                               boost::filesystem::path &base_path,
-                              int &max_wait)
+                              int &max_wait,
+                              std::string &huge_pages,
+                              bool &load_rtree_leaves)
 {
     // declare a group of options that will be allowed only on command line
     boost::program_options::options_description generic_options("Options");
@@ -25,7 +29,16 @@ bool generateDataStoreOptions(const int argc,
     config_options.add_options()(
         "max-wait",
         boost::program_options::value<int>(&max_wait)->default_value(-1),
-        "Maximum number of seconds to wait on requests that use the old dataset.");
+        "Maximum number of seconds to wait on requests that use the old dataset.")(
+        "huge-pages",
+        boost::program_options::value<std::string>(&huge_pages)->default_value("none"),
+        "Back the data with huge pages: none, transparent or explicit (needs vm.nr_hugepages)")(
+        "load-rtree-leaves",
+        boost::program_options::value<bool>(&load_rtree_leaves)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Load the r-tree leaves into shared memory instead of mapping .fileIndex in every "
+        "process, so nearest queries do not depend on the page cache");
 
     // hidden options, will be allowed on command line but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -93,17 +106,21 @@ int main(const int argc, const char *argv[]) try
 
     boost::filesystem::path base_path;
     int max_wait = -1;
-    if (!generateDataStoreOptions(argc, argv, base_path, max_wait))
+    std::string huge_pages;
+    bool load_rtree_leaves = false;
+    if (!generateDataStoreOptions(
+            argc, argv, base_path, max_wait, huge_pages, load_rtree_leaves))
     {
         return EXIT_SUCCESS;
     }
+    const auto huge_pages_setting = storage::parseHugePages(huge_pages);
     storage::StorageConfig config(base_path);
     if (!config.IsValid())
     {
         util::SimpleLogger().Write(logWARNING) << "Config contains invalid file paths. Exiting!";
         return EXIT_FAILURE;
     }
-    storage::Storage storage(std::move(config));
+    storage::Storage storage(std::move(config), load_rtree_leaves);
 
     // We will attempt to load this dataset to memory several times if we encounter
     // an error we can recover from. This is needed when we need to clear mutexes
@@ -118,7 +135,7 @@ int main(const int argc, const char *argv[]) try
             util::SimpleLogger().Write(logWARNING) << "Try number " << (retry_counter + 1)
                                                    << " to load the dataset.";
         }
-        code = storage.Run(max_wait);
+        code = storage.Run(max_wait, huge_pages_setting);
         retry_counter++;
     }
 
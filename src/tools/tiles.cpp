@@ -0,0 +1,277 @@
+#include "engine/api/tile_parameters.hpp"
+#include "engine/datafacade/process_memory_datafacade.hpp"
+#include "engine/plugins/tile.hpp"
+#include "engine/tile_archive.hpp"
+#include "storage/storage_config.hpp"
+#include "util/simple_logger.hpp"
+#include "util/timing_util.hpp"
+#include "util/version.hpp"
+#include "util/web_mercator.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_scheduler_init.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+
+enum class return_code : unsigned
+{
+    ok,
+    fail,
+    exit
+};
+
+struct TilesConfig
+{
+    boost::filesystem::path base_path;
+    boost::filesystem::path output_path;
+    std::string bbox;
+    double min_lon;
+    double min_lat;
+    double max_lon;
+    double max_lat;
+    unsigned min_zoom;
+    unsigned max_zoom;
+    unsigned requested_num_threads;
+};
+
+return_code parseArguments(int argc, char *argv[], TilesConfig &config)
+{
+    // declare a group of options that will be allowed only on command line
+    boost::program_options::options_description generic_options("Options");
+    generic_options.add_options()("version,v", "Show version")("help,h", "Show this help message");
+
+    // declare a group of options that will be allowed on command line
+    boost::program_options::options_description config_options("Configuration");
+    config_options.add_options()(
+        "threads,t",
+        boost::program_options::value<unsigned int>(&config.requested_num_threads)
+            ->default_value(tbb::task_scheduler_init::default_num_threads()),
+        "Number of threads to use")(
+        "bbox,b",
+        boost::program_options::value<std::string>(&config.bbox),
+        "Area to render as min_lon,min_lat,max_lon,max_lat")(
+        "min-zoom",
+        boost::program_options::value<unsigned>(&config.min_zoom)->default_value(14),
+        "Lowest zoom level to render, at least 12")(
+        "max-zoom",
+        boost::program_options::value<unsigned>(&config.max_zoom)->default_value(16),
+        "Highest zoom level to render, at most 19")(
+        "output,o",
+        boost::program_options::value<boost::filesystem::path>(&config.output_path),
+        "Tile archive to write, <base.osrm>.tiles by default");
+
+    // hidden options, will be allowed on command line, but will not be shown to the user
+    boost::program_options::options_description hidden_options("Hidden options");
+    hidden_options.add_options()(
+        "input,i",
+        boost::program_options::value<boost::filesystem::path>(&config.base_path),
+        "Input file in .osrm format");
+
+    // positional option
+    boost::program_options::positional_options_description positional_options;
+    positional_options.add("input", 1);
+
+    // combine above options for parsing
+    boost::program_options::options_description cmdline_options;
+    cmdline_options.add(generic_options).add(config_options).add(hidden_options);
+
+    const auto *executable = argv[0];
+    boost::program_options::options_description visible_options(
+        "Usage: " + boost::filesystem::path(executable).filename().string() +
+        " <input.osrm> --bbox <min_lon,min_lat,max_lon,max_lat> [options]");
+    visible_options.add(generic_options).add(config_options);
+
+    // parse command line options
+    boost::program_options::variables_map option_variables;
+    try
+    {
+        boost::program_options::store(boost::program_options::command_line_parser(argc, argv)
+                                          .options(cmdline_options)
+                                          .positional(positional_options)
+                                          .run(),
+                                      option_variables);
+    }
+    catch (const boost::program_options::error &e)
+    {
+        util::SimpleLogger().Write(logWARNING) << "[error] " << e.what();
+        return return_code::fail;
+    }
+
+    if (option_variables.count("version"))
+    {
+        util::SimpleLogger().Write() << OSRM_VERSION;
+        return return_code::exit;
+    }
+
+    if (option_variables.count("help"))
+    {
+        util::SimpleLogger().Write() << visible_options;
+        return return_code::exit;
+    }
+
+    if (!option_variables.count("input") || !option_variables.count("bbox"))
+    {
+        util::SimpleLogger().Write() << visible_options;
+        return return_code::fail;
+    }
+
+    boost::program_options::notify(option_variables);
+
+    std::istringstream bbox_stream(config.bbox);
+    char separator[3];
+    if (!(bbox_stream >> config.min_lon >> separator[0] >> config.min_lat >> separator[1] >>
+          config.max_lon >> separator[2] >> config.max_lat) ||
+        std::count(separator, separator + 3, ',') != 3 || config.min_lon > config.max_lon ||
+        config.min_lat > config.max_lat)
+    {
+        util::SimpleLogger().Write(logWARNING) << "[error] invalid bounding box " << config.bbox;
+        return return_code::fail;
+    }
+
+    if (config.min_zoom < 12 || config.max_zoom > 19 || config.min_zoom > config.max_zoom)
+    {
+        util::SimpleLogger().Write(logWARNING)
+            << "[error] zoom levels have to be between 12 and 19";
+        return return_code::fail;
+    }
+
+    if (config.output_path.empty())
+    {
+        config.output_path = config.base_path.string() + ".tiles";
+    }
+
+    return return_code::ok;
+}
+
+// All tiles of the zoom level intersecting the bounding box
+std::vector<engine::api::TileParameters> getTiles(const TilesConfig &config, const unsigned z)
+{
+    const auto to_tile = [z](const double pixel) {
+        const auto last_tile = (1u << z) - 1;
+        const auto tile = std::floor(pixel / util::web_mercator::TILE_SIZE);
+        return static_cast<unsigned>(std::min<double>(std::max(tile, 0.), last_tile));
+    };
+
+    using util::web_mercator::clamp;
+    using util::web_mercator::degreeToPixel;
+    const auto min_x = to_tile(degreeToPixel(clamp(util::FloatLongitude{config.min_lon}), z));
+    const auto max_x = to_tile(degreeToPixel(clamp(util::FloatLongitude{config.max_lon}), z));
+    // tile rows count from north to south
+    const auto min_y = to_tile(degreeToPixel(clamp(util::FloatLatitude{config.max_lat}), z));
+    const auto max_y = to_tile(degreeToPixel(clamp(util::FloatLatitude{config.min_lat}), z));
+
+    std::vector<engine::api::TileParameters> tiles;
+    for (auto x = min_x; x <= max_x; ++x)
+    {
+        for (auto y = min_y; y <= max_y; ++y)
+        {
+            tiles.push_back(engine::api::TileParameters{x, y, z});
+        }
+    }
+    return tiles;
+}
+
+int main(int argc, char *argv[]) try
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    TilesConfig config;
+    const return_code result = parseArguments(argc, argv, config);
+
+    if (return_code::fail == result)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (return_code::exit == result)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    if (1 > config.requested_num_threads)
+    {
+        util::SimpleLogger().Write(logWARNING) << "Number of threads must be 1 or larger";
+        return EXIT_FAILURE;
+    }
+
+    const storage::StorageConfig storage_config(config.base_path);
+    if (!storage_config.IsValid())
+    {
+        util::SimpleLogger().Write(logWARNING) << "Could not find the data files of "
+                                               << config.base_path.string();
+        return EXIT_FAILURE;
+    }
+
+    tbb::task_scheduler_init init(config.requested_num_threads);
+
+    std::vector<engine::api::TileParameters> tiles;
+    for (auto z = config.min_zoom; z <= config.max_zoom; ++z)
+    {
+        const auto zoom_level_tiles = getTiles(config, z);
+        util::SimpleLogger().Write() << "Zoom level " << z << ": " << zoom_level_tiles.size()
+                                     << " tiles";
+        tiles.insert(tiles.end(), zoom_level_tiles.begin(), zoom_level_tiles.end());
+    }
+
+    util::SimpleLogger().Write() << "Loading " << config.base_path.string();
+    const std::shared_ptr<engine::datafacade::BaseDataFacade> facade =
+        std::make_shared<engine::datafacade::ProcessMemoryDataFacade>(storage_config);
+    const engine::plugins::TilePlugin tile_plugin;
+
+    util::SimpleLogger().Write() << "Rendering " << tiles.size() << " tiles into "
+                                 << config.output_path.string();
+    TIMER_START(render);
+    engine::TileArchiveWriter writer(config.output_path, facade->GetCheckSum());
+    std::atomic<std::size_t> number_of_bytes{0};
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, tiles.size()),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          std::string tile;
+                          for (auto index = range.begin(); index != range.end(); ++index)
+                          {
+                              const auto &parameters = tiles[index];
+                              tile.clear();
+                              if (tile_plugin.HandleRequest(facade, parameters, tile) !=
+                                  engine::Status::Ok)
+                              {
+                                  continue;
+                              }
+                              writer.Write(parameters.z, parameters.x, parameters.y, tile);
+                              number_of_bytes += tile.size();
+                          }
+                      });
+    writer.Finish();
+    TIMER_STOP(render);
+
+    util::SimpleLogger().Write() << "Rendered " << tiles.size() << " tiles ("
+                                 << number_of_bytes / (1024 * 1024) << " MB) in "
+                                 << TIMER_SEC(render) << "s";
+
+    return EXIT_SUCCESS;
+}
+catch (const std::bad_alloc &e)
+{
+    util::SimpleLogger().Write(logWARNING) << "[exception] " << e.what();
+    util::SimpleLogger().Write(logWARNING)
+        << "Please provide more memory or consider using a larger swapfile";
+    return EXIT_FAILURE;
+}
+catch (const std::exception &e)
+{
+    util::SimpleLogger().Write(logWARNING) << "[exception] " << e.what();
+    return EXIT_FAILURE;
+}
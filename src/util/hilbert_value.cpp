@@ -1,5 +1,8 @@
 #include "util/hilbert_value.hpp"
 
+#include <algorithm>
+#include <utility>
+
 namespace osrm
 {
 namespace util
@@ -80,5 +83,21 @@ std::uint64_t hilbertCode(const Coordinate coordinate)
     transposeCoordinate(location);
     return bitInterleaving(location[0], location[1]);
 }
+
+std::vector<std::size_t> hilbertOrder(const std::vector<Coordinate> &coordinates)
+{
+    std::vector<std::pair<std::uint64_t, std::size_t>> codes(coordinates.size());
+    for (std::size_t index = 0; index < coordinates.size(); ++index)
+    {
+        codes[index] = std::make_pair(hilbertCode(coordinates[index]), index);
+    }
+    std::sort(codes.begin(), codes.end());
+
+    std::vector<std::size_t> order(coordinates.size());
+    std::transform(codes.begin(), codes.end(), order.begin(), [](const auto &code) {
+        return code.second;
+    });
+    return order;
+}
 }
 }
@@ -0,0 +1,453 @@
+#include "util/rtree_kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define OSRM_RTREE_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace osrm
+{
+namespace util
+{
+namespace rtree_kernels
+{
+
+namespace
+{
+
+inline std::uint64_t minSquaredDistance(const std::int32_t min_lon,
+                                        const std::int32_t max_lon,
+                                        const std::int32_t min_lat,
+                                        const std::int32_t max_lat,
+                                        const std::int32_t lon,
+                                        const std::int32_t lat)
+{
+    // at most one of the two differences is positive
+    const std::uint64_t dx = std::max<std::int64_t>(0, std::int64_t{min_lon} - lon) +
+                             std::max<std::int64_t>(0, std::int64_t{lon} - max_lon);
+    const std::uint64_t dy = std::max<std::int64_t>(0, std::int64_t{min_lat} - lat) +
+                             std::max<std::int64_t>(0, std::int64_t{lat} - max_lat);
+    return dx * dx + dy * dy;
+}
+
+inline void projectOnSegment(const double source_lon,
+                             const double source_lat,
+                             const double target_lon,
+                             const double target_lat,
+                             const double lon,
+                             const double lat,
+                             double &nearest_lon,
+                             double &nearest_lat)
+{
+    const double slope_lon = target_lon - source_lon;
+    const double slope_lat = target_lat - source_lat;
+    const double unnormed_ratio = slope_lon * (lon - source_lon) + slope_lat * (lat - source_lat);
+    const double squared_length = slope_lon * slope_lon + slope_lat * slope_lat;
+
+    if (squared_length < std::numeric_limits<double>::epsilon())
+    {
+        nearest_lon = source_lon;
+        nearest_lat = source_lat;
+        return;
+    }
+
+    const double ratio = std::min(std::max(unnormed_ratio / squared_length, 0.), 1.);
+    nearest_lon = (1.0 - ratio) * source_lon + target_lon * ratio;
+    nearest_lat = (1.0 - ratio) * source_lat + target_lat * ratio;
+}
+
+void minSquaredDistancesScalar(const std::int32_t *min_lon,
+                               const std::int32_t *max_lon,
+                               const std::int32_t *min_lat,
+                               const std::int32_t *max_lat,
+                               const std::size_t first,
+                               const std::size_t count,
+                               const std::int32_t lon,
+                               const std::int32_t lat,
+                               std::uint64_t *squared_distances)
+{
+    for (std::size_t i = first; i < count; ++i)
+    {
+        squared_distances[i] =
+            minSquaredDistance(min_lon[i], max_lon[i], min_lat[i], max_lat[i], lon, lat);
+    }
+}
+
+void projectOnSegmentsScalar(const double *source_lon,
+                             const double *source_lat,
+                             const double *target_lon,
+                             const double *target_lat,
+                             const std::size_t first,
+                             const std::size_t count,
+                             const double lon,
+                             const double lat,
+                             double *nearest_lon,
+                             double *nearest_lat)
+{
+    for (std::size_t i = first; i < count; ++i)
+    {
+        projectOnSegment(source_lon[i],
+                         source_lat[i],
+                         target_lon[i],
+                         target_lat[i],
+                         lon,
+                         lat,
+                         nearest_lon[i],
+                         nearest_lat[i]);
+    }
+}
+
+#ifdef OSRM_RTREE_KERNELS_X86
+
+// The differences of coordinates fit into 31 bits, so their squares are computed by unsigned
+// 32x32 -> 64 bit multiplications of the even and odd lanes.
+__attribute__((target("sse4.1"))) void
+minSquaredDistancesSSE(const std::int32_t *min_lon,
+                       const std::int32_t *max_lon,
+                       const std::int32_t *min_lat,
+                       const std::int32_t *max_lat,
+                       const std::size_t count,
+                       const std::int32_t lon,
+                       const std::int32_t lat,
+                       std::uint64_t *squared_distances)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i query_lon = _mm_set1_epi32(lon);
+    const __m128i query_lat = _mm_set1_epi32(lat);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i rectangle_min_lon =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(min_lon + i));
+        const __m128i rectangle_max_lon =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(max_lon + i));
+        const __m128i rectangle_min_lat =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(min_lat + i));
+        const __m128i rectangle_max_lat =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(max_lat + i));
+
+        const __m128i dx =
+            _mm_add_epi32(_mm_max_epi32(_mm_sub_epi32(rectangle_min_lon, query_lon), zero),
+                          _mm_max_epi32(_mm_sub_epi32(query_lon, rectangle_max_lon), zero));
+        const __m128i dy =
+            _mm_add_epi32(_mm_max_epi32(_mm_sub_epi32(rectangle_min_lat, query_lat), zero),
+                          _mm_max_epi32(_mm_sub_epi32(query_lat, rectangle_max_lat), zero));
+
+        const __m128i even = _mm_add_epi64(_mm_mul_epu32(dx, dx), _mm_mul_epu32(dy, dy));
+        const __m128i dx_odd = _mm_srli_epi64(dx, 32);
+        const __m128i dy_odd = _mm_srli_epi64(dy, 32);
+        const __m128i odd =
+            _mm_add_epi64(_mm_mul_epu32(dx_odd, dx_odd), _mm_mul_epu32(dy_odd, dy_odd));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(squared_distances + i),
+                         _mm_unpacklo_epi64(even, odd));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(squared_distances + i + 2),
+                         _mm_unpackhi_epi64(even, odd));
+    }
+    minSquaredDistancesScalar(
+        min_lon, max_lon, min_lat, max_lat, i, count, lon, lat, squared_distances);
+}
+
+__attribute__((target("avx2"))) void minSquaredDistancesAVX2(const std::int32_t *min_lon,
+                                                             const std::int32_t *max_lon,
+                                                             const std::int32_t *min_lat,
+                                                             const std::int32_t *max_lat,
+                                                             const std::size_t count,
+                                                             const std::int32_t lon,
+                                                             const std::int32_t lat,
+                                                             std::uint64_t *squared_distances)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i query_lon = _mm256_set1_epi32(lon);
+    const __m256i query_lat = _mm256_set1_epi32(lat);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i rectangle_min_lon =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(min_lon + i));
+        const __m256i rectangle_max_lon =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(max_lon + i));
+        const __m256i rectangle_min_lat =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(min_lat + i));
+        const __m256i rectangle_max_lat =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(max_lat + i));
+
+        const __m256i dx = _mm256_add_epi32(
+            _mm256_max_epi32(_mm256_sub_epi32(rectangle_min_lon, query_lon), zero),
+            _mm256_max_epi32(_mm256_sub_epi32(query_lon, rectangle_max_lon), zero));
+        const __m256i dy = _mm256_add_epi32(
+            _mm256_max_epi32(_mm256_sub_epi32(rectangle_min_lat, query_lat), zero),
+            _mm256_max_epi32(_mm256_sub_epi32(query_lat, rectangle_max_lat), zero));
+
+        const __m256i even =
+            _mm256_add_epi64(_mm256_mul_epu32(dx, dx), _mm256_mul_epu32(dy, dy));
+        const __m256i dx_odd = _mm256_srli_epi64(dx, 32);
+        const __m256i dy_odd = _mm256_srli_epi64(dy, 32);
+        const __m256i odd =
+            _mm256_add_epi64(_mm256_mul_epu32(dx_odd, dx_odd), _mm256_mul_epu32(dy_odd, dy_odd));
+
+        // the unpacks interleave within 128 bit lanes: {0, 1, 4, 5} and {2, 3, 6, 7}
+        const __m256i low = _mm256_unpacklo_epi64(even, odd);
+        const __m256i high = _mm256_unpackhi_epi64(even, odd);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(squared_distances + i),
+                            _mm256_permute2x128_si256(low, high, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(squared_distances + i + 4),
+                            _mm256_permute2x128_si256(low, high, 0x31));
+    }
+    minSquaredDistancesScalar(
+        min_lon, max_lon, min_lat, max_lat, i, count, lon, lat, squared_distances);
+}
+
+// The vector kernels do the same operations in the same order as the scalar version, without
+// fused multiply-adds, so the results are bit-identical.
+__attribute__((target("sse2"))) void projectOnSegmentsSSE(const double *source_lon,
+                                                          const double *source_lat,
+                                                          const double *target_lon,
+                                                          const double *target_lat,
+                                                          const std::size_t count,
+                                                          const double lon,
+                                                          const double lat,
+                                                          double *nearest_lon,
+                                                          double *nearest_lat)
+{
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.);
+    const __m128d epsilon = _mm_set1_pd(std::numeric_limits<double>::epsilon());
+    const __m128d query_lon = _mm_set1_pd(lon);
+    const __m128d query_lat = _mm_set1_pd(lat);
+
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d s_lon = _mm_loadu_pd(source_lon + i);
+        const __m128d s_lat = _mm_loadu_pd(source_lat + i);
+        const __m128d t_lon = _mm_loadu_pd(target_lon + i);
+        const __m128d t_lat = _mm_loadu_pd(target_lat + i);
+
+        const __m128d slope_lon = _mm_sub_pd(t_lon, s_lon);
+        const __m128d slope_lat = _mm_sub_pd(t_lat, s_lat);
+        const __m128d unnormed_ratio =
+            _mm_add_pd(_mm_mul_pd(slope_lon, _mm_sub_pd(query_lon, s_lon)),
+                       _mm_mul_pd(slope_lat, _mm_sub_pd(query_lat, s_lat)));
+        const __m128d squared_length =
+            _mm_add_pd(_mm_mul_pd(slope_lon, slope_lon), _mm_mul_pd(slope_lat, slope_lat));
+
+        const __m128d ratio =
+            _mm_min_pd(_mm_max_pd(_mm_div_pd(unnormed_ratio, squared_length), zero), one);
+        const __m128d inverse_ratio = _mm_sub_pd(one, ratio);
+        const __m128d projected_lon =
+            _mm_add_pd(_mm_mul_pd(inverse_ratio, s_lon), _mm_mul_pd(t_lon, ratio));
+        const __m128d projected_lat =
+            _mm_add_pd(_mm_mul_pd(inverse_ratio, s_lat), _mm_mul_pd(t_lat, ratio));
+
+        // degenerated segments project to their source
+        const __m128d is_degenerated = _mm_cmplt_pd(squared_length, epsilon);
+        _mm_storeu_pd(nearest_lon + i,
+                      _mm_or_pd(_mm_and_pd(is_degenerated, s_lon),
+                                _mm_andnot_pd(is_degenerated, projected_lon)));
+        _mm_storeu_pd(nearest_lat + i,
+                      _mm_or_pd(_mm_and_pd(is_degenerated, s_lat),
+                                _mm_andnot_pd(is_degenerated, projected_lat)));
+    }
+    projectOnSegmentsScalar(source_lon,
+                            source_lat,
+                            target_lon,
+                            target_lat,
+                            i,
+                            count,
+                            lon,
+                            lat,
+                            nearest_lon,
+                            nearest_lat);
+}
+
+__attribute__((target("avx2"))) void projectOnSegmentsAVX2(const double *source_lon,
+                                                           const double *source_lat,
+                                                           const double *target_lon,
+                                                           const double *target_lat,
+                                                           const std::size_t count,
+                                                           const double lon,
+                                                           const double lat,
+                                                           double *nearest_lon,
+                                                           double *nearest_lat)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.);
+    const __m256d epsilon = _mm256_set1_pd(std::numeric_limits<double>::epsilon());
+    const __m256d query_lon = _mm256_set1_pd(lon);
+    const __m256d query_lat = _mm256_set1_pd(lat);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d s_lon = _mm256_loadu_pd(source_lon + i);
+        const __m256d s_lat = _mm256_loadu_pd(source_lat + i);
+        const __m256d t_lon = _mm256_loadu_pd(target_lon + i);
+        const __m256d t_lat = _mm256_loadu_pd(target_lat + i);
+
+        const __m256d slope_lon = _mm256_sub_pd(t_lon, s_lon);
+        const __m256d slope_lat = _mm256_sub_pd(t_lat, s_lat);
+        const __m256d unnormed_ratio =
+            _mm256_add_pd(_mm256_mul_pd(slope_lon, _mm256_sub_pd(query_lon, s_lon)),
+                          _mm256_mul_pd(slope_lat, _mm256_sub_pd(query_lat, s_lat)));
+        const __m256d squared_length = _mm256_add_pd(_mm256_mul_pd(slope_lon, slope_lon),
+                                                     _mm256_mul_pd(slope_lat, slope_lat));
+
+        const __m256d ratio = _mm256_min_pd(
+            _mm256_max_pd(_mm256_div_pd(unnormed_ratio, squared_length), zero), one);
+        const __m256d inverse_ratio = _mm256_sub_pd(one, ratio);
+        const __m256d projected_lon =
+            _mm256_add_pd(_mm256_mul_pd(inverse_ratio, s_lon), _mm256_mul_pd(t_lon, ratio));
+        const __m256d projected_lat =
+            _mm256_add_pd(_mm256_mul_pd(inverse_ratio, s_lat), _mm256_mul_pd(t_lat, ratio));
+
+        // degenerated segments project to their source
+        const __m256d is_degenerated = _mm256_cmp_pd(squared_length, epsilon, _CMP_LT_OQ);
+        _mm256_storeu_pd(nearest_lon + i,
+                         _mm256_blendv_pd(projected_lon, s_lon, is_degenerated));
+        _mm256_storeu_pd(nearest_lat + i,
+                         _mm256_blendv_pd(projected_lat, s_lat, is_degenerated));
+    }
+    projectOnSegmentsScalar(source_lon,
+                            source_lat,
+                            target_lon,
+                            target_lat,
+                            i,
+                            count,
+                            lon,
+                            lat,
+                            nearest_lon,
+                            nearest_lat);
+}
+#endif
+
+std::atomic<SIMDLevel> &currentLevel()
+{
+    static std::atomic<SIMDLevel> level{detectSIMDLevel()};
+    return level;
+}
+}
+
+SIMDLevel detectSIMDLevel()
+{
+#ifdef OSRM_RTREE_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SIMDLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        return SIMDLevel::SSE;
+    }
+#endif
+    return SIMDLevel::Scalar;
+}
+
+SIMDLevel getSIMDLevel() { return currentLevel().load(std::memory_order_relaxed); }
+
+SIMDLevel setSIMDLevel(const SIMDLevel level)
+{
+    const auto used_level = std::min(level, detectSIMDLevel());
+    currentLevel().store(used_level, std::memory_order_relaxed);
+    return used_level;
+}
+
+std::string toString(const SIMDLevel level)
+{
+    switch (level)
+    {
+    case SIMDLevel::AVX2:
+        return "avx2";
+    case SIMDLevel::SSE:
+        return "sse";
+    default:
+        return "scalar";
+    }
+}
+
+void minSquaredDistances(const std::int32_t *min_lon,
+                         const std::int32_t *max_lon,
+                         const std::int32_t *min_lat,
+                         const std::int32_t *max_lat,
+                         const std::size_t count,
+                         const std::int32_t lon,
+                         const std::int32_t lat,
+                         std::uint64_t *squared_distances)
+{
+    switch (getSIMDLevel())
+    {
+#ifdef OSRM_RTREE_KERNELS_X86
+    case SIMDLevel::AVX2:
+        minSquaredDistancesAVX2(
+            min_lon, max_lon, min_lat, max_lat, count, lon, lat, squared_distances);
+        break;
+    case SIMDLevel::SSE:
+        minSquaredDistancesSSE(
+            min_lon, max_lon, min_lat, max_lat, count, lon, lat, squared_distances);
+        break;
+#endif
+    default:
+        minSquaredDistancesScalar(
+            min_lon, max_lon, min_lat, max_lat, 0, count, lon, lat, squared_distances);
+    }
+}
+
+void projectOnSegments(const double *source_lon,
+                       const double *source_lat,
+                       const double *target_lon,
+                       const double *target_lat,
+                       const std::size_t count,
+                       const double lon,
+                       const double lat,
+                       double *nearest_lon,
+                       double *nearest_lat)
+{
+    switch (getSIMDLevel())
+    {
+#ifdef OSRM_RTREE_KERNELS_X86
+    case SIMDLevel::AVX2:
+        projectOnSegmentsAVX2(source_lon,
+                              source_lat,
+                              target_lon,
+                              target_lat,
+                              count,
+                              lon,
+                              lat,
+                              nearest_lon,
+                              nearest_lat);
+        break;
+    case SIMDLevel::SSE:
+        projectOnSegmentsSSE(source_lon,
+                             source_lat,
+                             target_lon,
+                             target_lat,
+                             count,
+                             lon,
+                             lat,
+                             nearest_lon,
+                             nearest_lat);
+        break;
+#endif
+    default:
+        projectOnSegmentsScalar(source_lon,
+                                source_lat,
+                                target_lon,
+                                target_lat,
+                                0,
+                                count,
+                                lon,
+                                lat,
+                                nearest_lon,
+                                nearest_lat);
+    }
+}
+}
+}
+}
@@ -0,0 +1,160 @@
+#include "helper.hpp"
+
+#include "contractor/graph_contractor.hpp"
+#include "contractor/graph_customizer.hpp"
+
+#include "extractor/edge_based_edge.hpp"
+#include "util/deallocating_vector.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(graph_customizer)
+
+using namespace osrm;
+using namespace osrm::contractor;
+using namespace osrm::test;
+
+namespace
+{
+std::vector<QueryEdge> contract(const NodeID number_of_nodes,
+                                const std::vector<extractor::EdgeBasedEdge> &edges)
+{
+    util::DeallocatingVector<extractor::EdgeBasedEdge> input_edges;
+    for (const auto &edge : edges)
+        input_edges.push_back(edge);
+
+    // node weights decide about self-loops for u-turns, as the weight of the u-turn in the
+    // edge-expanded graph does
+    std::vector<EdgeWeight> node_weights(number_of_nodes, 150);
+    GraphContractor graph_contractor(
+        number_of_nodes, input_edges, std::vector<float>{}, std::move(node_weights));
+    graph_contractor.Run();
+
+    util::DeallocatingVector<QueryEdge> contracted_edges;
+    graph_contractor.GetEdges(contracted_edges);
+    return std::vector<QueryEdge>(contracted_edges.begin(), contracted_edges.end());
+}
+
+std::vector<QueryEdge> customize(const NodeID number_of_nodes,
+                                 const std::vector<QueryEdge> &hierarchy,
+                                 const std::vector<extractor::EdgeBasedEdge> &edges)
+{
+    GraphCustomizer customizer(number_of_nodes, hierarchy);
+    util::DeallocatingVector<QueryEdge> customized_edges;
+    customizer.Customize(edges, customized_edges);
+    return std::vector<QueryEdge>(customized_edges.begin(), customized_edges.end());
+}
+
+// The contraction can add parallel shortcuts over the same middle node, the customization
+// gives them the same weight. Compare the smallest weight of each edge.
+std::map<std::tuple<NodeID, NodeID, NodeID, bool, bool, bool>, EdgeWeight>
+minimalWeights(const std::vector<QueryEdge> &edges)
+{
+    std::map<std::tuple<NodeID, NodeID, NodeID, bool, bool, bool>, EdgeWeight> weights;
+    for (const auto &edge : edges)
+    {
+        const auto key = std::make_tuple(edge.source,
+                                         edge.target,
+                                         edge.data.id,
+                                         edge.data.shortcut,
+                                         edge.data.forward,
+                                         edge.data.backward);
+        const auto iter = weights.find(key);
+        if (iter == weights.end())
+            weights.emplace(key, edge.data.weight);
+        else
+            iter->second = std::min<EdgeWeight>(iter->second, edge.data.weight);
+    }
+    return weights;
+}
+}
+
+BOOST_AUTO_TEST_CASE(same_weights_reproduce_hierarchy)
+{
+    const NodeID width = 20;
+    const auto edges = makeGridEdges(width, true);
+
+    const auto hierarchy = contract(width * width, edges);
+    const auto customized = customize(width * width, hierarchy, edges);
+
+    BOOST_CHECK_EQUAL(hierarchy.size(), customized.size());
+    const auto expected = minimalWeights(hierarchy);
+    const auto weights = minimalWeights(customized);
+    BOOST_REQUIRE_EQUAL(expected.size(), weights.size());
+    BOOST_CHECK(expected == weights);
+}
+
+BOOST_AUTO_TEST_CASE(scaled_weights_scale_hierarchy)
+{
+    const NodeID width = 20;
+    auto edges = makeGridEdges(width, true);
+
+    const auto hierarchy = contract(width * width, edges);
+    for (auto &edge : edges)
+        edge.weight = edge.weight * 3;
+    const auto customized = customize(width * width, hierarchy, edges);
+
+    const auto expected = minimalWeights(hierarchy);
+    const auto weights = minimalWeights(customized);
+    BOOST_REQUIRE_EQUAL(expected.size(), weights.size());
+    for (const auto &entry : expected)
+    {
+        BOOST_CHECK_EQUAL(entry.second * 3, weights.at(entry.first));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(changed_weights_update_shortcuts)
+{
+    const NodeID width = 20;
+    auto edges = makeGridEdges(width, true);
+    const auto hierarchy = contract(width * width, edges);
+
+    std::mt19937 generator(RANDOM_SEED);
+    std::uniform_int_distribution<EdgeWeight> weight_distribution(1, 100);
+    for (auto &edge : edges)
+        edge.weight = weight_distribution(generator);
+    const auto customized = customize(width * width, hierarchy, edges);
+
+    // every shortcut weighs as much as the cheapest edges it bridges
+    const auto find_weight = [&](const NodeID middle, const NodeID other, const bool into) {
+        EdgeWeight weight = INVALID_EDGE_WEIGHT;
+        for (const auto &edge : customized)
+        {
+            if (edge.source == middle && edge.target == other &&
+                (into ? edge.data.backward : edge.data.forward))
+                weight = std::min<EdgeWeight>(weight, edge.data.weight);
+        }
+        return weight;
+    };
+
+    std::size_t number_of_shortcuts = 0;
+    for (const auto &edge : customized)
+    {
+        if (!edge.data.shortcut)
+            continue;
+        ++number_of_shortcuts;
+        const NodeID middle = edge.data.id;
+        if (edge.data.forward)
+        {
+            BOOST_CHECK_EQUAL(edge.data.weight,
+                              find_weight(middle, edge.source, true) +
+                                  find_weight(middle, edge.target, false));
+        }
+        if (edge.data.backward)
+        {
+            BOOST_CHECK_EQUAL(edge.data.weight,
+                              find_weight(middle, edge.target, true) +
+                                  find_weight(middle, edge.source, false));
+        }
+    }
+    BOOST_CHECK_GT(number_of_shortcuts, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
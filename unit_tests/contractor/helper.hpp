@@ -0,0 +1,56 @@
+#ifndef UNIT_TESTS_CONTRACTOR_HELPER_HPP
+#define UNIT_TESTS_CONTRACTOR_HELPER_HPP
+
+#include "extractor/edge_based_edge.hpp"
+#include "util/typedefs.hpp"
+
+#include <random>
+#include <vector>
+
+namespace osrm
+{
+namespace test
+{
+
+// Choosen by a fair W20 dice roll (this value is completely arbitrary)
+constexpr unsigned RANDOM_SEED = 13;
+
+// Grid of width * width nodes with random edge weights. Edges are two-way, unless one-way edges
+// are requested, then a third of the edges goes in each direction only.
+inline std::vector<extractor::EdgeBasedEdge> makeGridEdges(const NodeID width,
+                                                           const bool with_one_way_edges)
+{
+    std::mt19937 generator(RANDOM_SEED);
+    std::uniform_int_distribution<EdgeWeight> weight_distribution(1, 100);
+    std::uniform_int_distribution<int> direction_distribution(0, 2);
+
+    std::vector<extractor::EdgeBasedEdge> edges;
+    NodeID edge_id = 0;
+    const auto add_edge = [&](const NodeID from, const NodeID to) {
+        // only draw a direction for one-way grids, to keep the weights of two-way grids
+        const auto direction = with_one_way_edges ? direction_distribution(generator) : 2;
+        edges.emplace_back(from,
+                           to,
+                           edge_id++,
+                           weight_distribution(generator),
+                           direction != 1,
+                           direction != 0);
+    };
+
+    for (NodeID y = 0; y < width; ++y)
+    {
+        for (NodeID x = 0; x < width; ++x)
+        {
+            const NodeID node = y * width + x;
+            if (x + 1 < width)
+                add_edge(node, node + 1);
+            if (y + 1 < width)
+                add_edge(node, node + width);
+        }
+    }
+    return edges;
+}
+}
+}
+
+#endif // UNIT_TESTS_CONTRACTOR_HELPER_HPP
@@ -0,0 +1,124 @@
+#include "helper.hpp"
+
+#include "contractor/graph_contractor.hpp"
+#include "contractor/node_renumbering.hpp"
+
+#include "extractor/edge_based_edge.hpp"
+#include "util/deallocating_vector.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(node_renumbering)
+
+using namespace osrm;
+using namespace osrm::contractor;
+using namespace osrm::test;
+
+namespace
+{
+std::vector<QueryEdge> contract(const NodeID number_of_nodes,
+                                const double core_factor,
+                                std::vector<bool> &is_core_node)
+{
+    util::DeallocatingVector<extractor::EdgeBasedEdge> input_edges;
+    for (const auto &edge : makeGridEdges(static_cast<NodeID>(std::sqrt(number_of_nodes)), false))
+        input_edges.push_back(edge);
+
+    std::vector<EdgeWeight> node_weights(number_of_nodes, 150);
+    GraphContractor graph_contractor(
+        number_of_nodes, input_edges, std::vector<float>{}, std::move(node_weights));
+    graph_contractor.Run(core_factor);
+
+    util::DeallocatingVector<QueryEdge> contracted_edges;
+    graph_contractor.GetEdges(contracted_edges);
+    graph_contractor.GetCoreMarker(is_core_node);
+    return std::vector<QueryEdge>(contracted_edges.begin(), contracted_edges.end());
+}
+
+void checkIsPermutation(const std::vector<NodeID> &permutation)
+{
+    std::vector<NodeID> sorted = permutation;
+    std::sort(sorted.begin(), sorted.end());
+    for (const auto node : util::irange<NodeID>(0, sorted.size()))
+    {
+        BOOST_REQUIRE_EQUAL(sorted[node], node);
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(higher_nodes_come_first)
+{
+    const NodeID number_of_nodes = 100;
+    std::vector<bool> is_core_node;
+    const auto edges = contract(number_of_nodes, 1.0, is_core_node);
+
+    const auto permutation = computeLocalityPermutation(number_of_nodes, edges);
+    BOOST_REQUIRE_EQUAL(permutation.size(), number_of_nodes);
+    checkIsPermutation(permutation);
+
+    // edges point to nodes contracted later, they are renumbered in front of the source
+    for (const auto &edge : edges)
+    {
+        if (edge.source != edge.target)
+        {
+            BOOST_CHECK_LT(permutation[edge.target], permutation[edge.source]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(core_nodes_come_first)
+{
+    const NodeID number_of_nodes = 100;
+    std::vector<bool> is_core_node;
+    const auto edges = contract(number_of_nodes, 0.5, is_core_node);
+    BOOST_REQUIRE_EQUAL(is_core_node.size(), number_of_nodes);
+
+    const auto permutation = computeLocalityPermutation(number_of_nodes, edges);
+    checkIsPermutation(permutation);
+
+    const auto renumbered_core = renumberNodeMarkers(is_core_node, permutation);
+    const auto number_of_core_nodes = std::count(is_core_node.begin(), is_core_node.end(), true);
+    BOOST_REQUIRE_GT(number_of_core_nodes, 0);
+    BOOST_CHECK_EQUAL(std::count(renumbered_core.begin(), renumbered_core.end(), true),
+                      number_of_core_nodes);
+    BOOST_CHECK(std::all_of(renumbered_core.begin(),
+                            renumbered_core.begin() + number_of_core_nodes,
+                            [](const bool is_core) { return is_core; }));
+}
+
+BOOST_AUTO_TEST_CASE(renumbering_round_trip)
+{
+    const NodeID number_of_nodes = 64;
+    std::vector<bool> is_core_node;
+    const auto edges = contract(number_of_nodes, 1.0, is_core_node);
+
+    const auto permutation = computeLocalityPermutation(number_of_nodes, edges);
+    const auto inverse = invertPermutation(permutation);
+    for (const auto node : util::irange<NodeID>(0, number_of_nodes))
+    {
+        BOOST_CHECK_EQUAL(inverse[permutation[node]], node);
+    }
+
+    auto renumbered_edges = edges;
+    renumberEdges(renumbered_edges, permutation);
+    for (const auto index : util::irange<std::size_t>(0, edges.size()))
+    {
+        BOOST_CHECK_EQUAL(renumbered_edges[index].source, permutation[edges[index].source]);
+        BOOST_CHECK_EQUAL(renumbered_edges[index].target, permutation[edges[index].target]);
+    }
+
+    renumberEdges(renumbered_edges, inverse);
+    for (const auto index : util::irange<std::size_t>(0, edges.size()))
+    {
+        BOOST_CHECK(renumbered_edges[index] == edges[index]);
+        BOOST_CHECK_EQUAL(renumbered_edges[index].data.id, edges[index].data.id);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
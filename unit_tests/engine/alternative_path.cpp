@@ -0,0 +1,95 @@
+#include "engine/routing_algorithms/alternative_path.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/integer_range.hpp"
+
+#include "mocks/grid_datafacade.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(alternative_path)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+// unpacked edges of a path and their weights, keyed by the segments they connect
+std::map<std::pair<NodeID, NodeID>, EdgeWeight> getEdges(const std::vector<PathData> &path,
+                                                         const NodeID target)
+{
+    std::map<std::pair<NodeID, NodeID>, EdgeWeight> edges;
+    for (const auto index : util::irange<std::size_t>(0UL, path.size()))
+    {
+        const auto next = index + 1 < path.size() ? path[index + 1].turn_via_node : target;
+        edges.emplace(std::make_pair(path[index].turn_via_node, next),
+                      path[index].duration_until_turn);
+    }
+    return edges;
+}
+}
+
+BOOST_AUTO_TEST_CASE(ranked_alternatives)
+{
+    const test::GridDataFacade facade(20, 13);
+    const NodeID source = 0;
+    const NodeID target = 20 * 20 - 1;
+    const PhantomNodes phantom_nodes{facade.GetPhantomNode(source), facade.GetPhantomNode(target)};
+
+    SearchEngineData heaps;
+    routing_algorithms::AlternativeRouting<datafacade::BaseDataFacade> alternative_routing(heaps);
+    InternalRouteResult result;
+    result.segment_end_coordinates.push_back(phantom_nodes);
+    alternative_routing(facade, phantom_nodes, 3, result);
+
+    // the shortest route comes first
+    const auto shortest_path_length = result.shortest_path_length;
+    BOOST_CHECK_EQUAL(shortest_path_length, facade.GetReferenceWeight(source, target));
+    BOOST_REQUIRE_EQUAL(result.unpacked_path_segments.size(), 1);
+
+    // more than one, but at most the requested number of alternatives
+    BOOST_CHECK_GT(result.number_of_alternatives(), 1);
+    BOOST_CHECK_LE(result.number_of_alternatives(), 3);
+    BOOST_REQUIRE_EQUAL(result.unpacked_alternatives.size(), result.number_of_alternatives());
+
+    std::vector<std::map<std::pair<NodeID, NodeID>, EdgeWeight>> route_edges = {
+        getEdges(result.unpacked_path_segments.front(), target)};
+    for (const auto index : util::irange<std::size_t>(0UL, result.number_of_alternatives()))
+    {
+        // alternatives are at most 15% longer and their length is the one of the unpacked path
+        const auto length = result.alternative_path_lengths[index];
+        BOOST_CHECK_GE(length, shortest_path_length);
+        BOOST_CHECK_LE(length, 1.15 * shortest_path_length);
+
+        route_edges.push_back(getEdges(result.unpacked_alternatives[index], target));
+        EdgeWeight unpacked_length = 0;
+        for (const auto &edge : route_edges.back())
+        {
+            unpacked_length += edge.second;
+        }
+        BOOST_CHECK_EQUAL(unpacked_length, length);
+    }
+
+    // no two routes share more than 75% of the length of the shortest route
+    const auto maximum_allowed_sharing = static_cast<EdgeWeight>(shortest_path_length * 0.75);
+    for (const auto first : util::irange<std::size_t>(0UL, route_edges.size()))
+    {
+        for (const auto second : util::irange<std::size_t>(first + 1, route_edges.size()))
+        {
+            EdgeWeight sharing = 0;
+            for (const auto &edge : route_edges[second])
+            {
+                if (route_edges[first].count(edge.first) > 0)
+                {
+                    sharing += edge.second;
+                }
+            }
+            BOOST_CHECK_LE(sharing, maximum_allowed_sharing);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
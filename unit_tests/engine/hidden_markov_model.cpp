@@ -0,0 +1,60 @@
+#include "engine/map_matching/hidden_markov_model.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(hidden_markov_model)
+
+using namespace osrm;
+using namespace osrm::engine::map_matching;
+
+namespace
+{
+// only the number of candidates per trace point matters to the model
+using CandidateLists = std::vector<std::vector<int>>;
+}
+
+BOOST_AUTO_TEST_CASE(save_and_restore_rows)
+{
+    const CandidateLists candidates = {{0, 1}, {0}, {0, 1, 2}, {0, 1}};
+    const std::vector<std::vector<double>> emissions = {{-1, -2}, {-1}, {-1, -2, -3}, {-1, -2}};
+
+    HiddenMarkovModel<CandidateLists> model(candidates, emissions);
+    BOOST_CHECK_EQUAL(model.initialize(0), 0);
+    model.viterbi[1][0] = -3;
+    model.parents[1][0] = std::make_pair(0u, 1u);
+    model.path_distances[1][0] = 10;
+    model.breakage[1] = false;
+    model.viterbi[2][1] = -5;
+    model.parents[2][1] = std::make_pair(1u, 0u);
+    model.path_distances[2][1] = 20;
+    model.breakage[2] = false;
+
+    HiddenMarkovModelState state;
+    model.Save(1, state);
+    BOOST_REQUIRE_EQUAL(state.NumberOfRows(), 3);
+    // the parent of the first row kept was dropped
+    BOOST_CHECK(state.parents[0][0] == std::make_pair(0u, 0u));
+    BOOST_CHECK_EQUAL(state.path_distances[0][0], 0);
+    // parents of the other rows are relative to the first row kept
+    BOOST_CHECK(state.parents[1][1] == std::make_pair(0u, 0u));
+    BOOST_CHECK_EQUAL(state.path_distances[1][1], 20);
+
+    // a model extended by a new trace point starts with the rows saved
+    const CandidateLists extended_candidates = {{0}, {0, 1, 2}, {0, 1}, {0}};
+    const std::vector<std::vector<double>> extended_emissions = {
+        {-1}, {-1, -2, -3}, {-1, -2}, {-1}};
+    HiddenMarkovModel<CandidateLists> extended_model(extended_candidates, extended_emissions);
+    extended_model.Restore(state);
+    BOOST_CHECK_EQUAL(extended_model.viterbi[0][0], -3);
+    BOOST_CHECK_EQUAL(extended_model.viterbi[1][1], -5);
+    BOOST_CHECK(!extended_model.breakage[0]);
+    BOOST_CHECK(!extended_model.breakage[1]);
+    BOOST_CHECK(extended_model.breakage[2]);
+    BOOST_CHECK(extended_model.breakage[3]);
+    BOOST_CHECK(extended_model.pruned[3][0]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+#include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/integer_range.hpp"
+
+#include "mocks/grid_datafacade.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(many_to_many)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+// Map matching computes the transitions between the candidates of two trace points with one
+// many-to-many search instead of a query per pair, bounded by the maximal plausible duration.
+BOOST_AUTO_TEST_CASE(transitions_equal_per_pair_queries)
+{
+    const test::GridDataFacade facade(10, 13);
+
+    // candidates of two trace points in opposite corners of the grid
+    std::vector<PhantomNode> phantom_nodes;
+    std::vector<std::size_t> source_indices, target_indices;
+    for (const NodeID node : {0, 1, 10, 11, 22})
+    {
+        source_indices.push_back(phantom_nodes.size());
+        phantom_nodes.push_back(facade.GetPhantomNode(node));
+    }
+    for (const NodeID node : {99, 98, 89, 88, 77, 35})
+    {
+        target_indices.push_back(phantom_nodes.size());
+        phantom_nodes.push_back(facade.GetPhantomNode(node));
+    }
+
+    SearchEngineData heaps;
+    routing_algorithms::ManyToManyRouting<datafacade::BaseDataFacade> many_to_many(heaps);
+    const auto unbounded_table =
+        many_to_many(facade, phantom_nodes, source_indices, target_indices, true);
+    const auto &durations = unbounded_table.first;
+    const auto &distances = unbounded_table.second;
+
+    // the many-to-many durations are the shortest ones and the distances are the ones of the
+    // per pair queries they replace
+    std::vector<EdgeWeight> sorted_durations;
+    for (const auto row_idx : util::irange<std::size_t>(0UL, source_indices.size()))
+    {
+        for (const auto column_idx : util::irange<std::size_t>(0UL, target_indices.size()))
+        {
+            const auto &source = phantom_nodes[source_indices[row_idx]];
+            const auto &target = phantom_nodes[target_indices[column_idx]];
+            heaps.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes());
+            const auto pair_distance = many_to_many.GetNetworkDistance(
+                facade, *heaps.forward_heap_1, *heaps.reverse_heap_1, source, target);
+
+            const auto entry_idx = row_idx * target_indices.size() + column_idx;
+            BOOST_CHECK_EQUAL(
+                durations[entry_idx],
+                facade.GetReferenceWeight(source.forward_segment_id.id,
+                                          target.forward_segment_id.id));
+            BOOST_CHECK_CLOSE(distances[entry_idx], pair_distance, 0.1);
+            sorted_durations.push_back(durations[entry_idx]);
+        }
+    }
+
+    // with a bound between the shortest and the longest transition some entries are pruned,
+    // all others stay the same
+    std::sort(sorted_durations.begin(), sorted_durations.end());
+    const auto duration_upper_bound = sorted_durations[sorted_durations.size() / 2] + 1;
+    const auto bounded_table = many_to_many(
+        facade, phantom_nodes, source_indices, target_indices, true, duration_upper_bound);
+
+    std::size_t number_of_pruned = 0;
+    for (const auto entry_idx : util::irange<std::size_t>(0UL, durations.size()))
+    {
+        if (durations[entry_idx] < duration_upper_bound)
+        {
+            BOOST_CHECK_EQUAL(bounded_table.first[entry_idx], durations[entry_idx]);
+            BOOST_CHECK_EQUAL(bounded_table.second[entry_idx], distances[entry_idx]);
+        }
+        else
+        {
+            BOOST_CHECK_EQUAL(bounded_table.first[entry_idx], INVALID_EDGE_WEIGHT);
+            BOOST_CHECK_EQUAL(bounded_table.second[entry_idx],
+                              std::numeric_limits<double>::max());
+            ++number_of_pruned;
+        }
+    }
+    BOOST_CHECK_GT(number_of_pruned, 0);
+    BOOST_CHECK_LT(number_of_pruned, durations.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
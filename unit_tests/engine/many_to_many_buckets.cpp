@@ -0,0 +1,71 @@
+#include "engine/routing_algorithms/many_to_many_buckets.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(many_to_many_buckets)
+
+using namespace osrm;
+using namespace osrm::engine::routing_algorithms;
+
+namespace
+{
+// search spaces of three columns, node 42 is settled by all of them
+std::vector<std::vector<NodeBucket>> makeSearchSpaces()
+{
+    return {{{40, 40, 0, 0}, {42, 40, 0, 5}, {45, 42, 0, 9}},
+            {{41, 41, 1, 0}, {42, 41, 1, 3}},
+            {{42, 42, 2, 0}, {50, 42, 2, 7}, {45, 50, 2, 12}}};
+}
+
+template <typename BucketStoreT> void checkBuckets()
+{
+    const auto search_spaces = makeSearchSpaces();
+    const BucketStoreT store(search_spaces);
+
+    const auto buckets_of_42 = store.GetBuckets(42);
+    BOOST_REQUIRE_EQUAL(buckets_of_42.size(), 3);
+    for (unsigned column_idx = 0; column_idx < 3; ++column_idx)
+    {
+        BOOST_CHECK_EQUAL(buckets_of_42[column_idx].middle_node, 42);
+        BOOST_CHECK_EQUAL(buckets_of_42[column_idx].column_idx, column_idx);
+    }
+
+    BOOST_CHECK_EQUAL(store.GetBuckets(45).size(), 2);
+    BOOST_CHECK_EQUAL(store.GetBuckets(50).size(), 1);
+
+    // nodes without buckets between and around the settled ones
+    BOOST_CHECK(store.GetBuckets(43).empty());
+    BOOST_CHECK(store.GetBuckets(0).empty());
+    BOOST_CHECK(store.GetBuckets(99).empty());
+
+    BOOST_CHECK_EQUAL(FindBucket(store, 45, 2).parent_node, 50);
+    BOOST_CHECK_EQUAL(FindBucket(store, 45, 2).weight, 12);
+    BOOST_CHECK_EQUAL(FindBucket(store, 42, 1).parent_node, 41);
+}
+}
+
+BOOST_AUTO_TEST_CASE(sorted_bucket_store)
+{
+    checkBuckets<SortedBucketStore>();
+}
+
+BOOST_AUTO_TEST_CASE(indexed_bucket_store)
+{
+    checkBuckets<IndexedBucketStore>();
+}
+
+BOOST_AUTO_TEST_CASE(empty_search_spaces)
+{
+    const std::vector<std::vector<NodeBucket>> search_spaces(2);
+
+    const IndexedBucketStore indexed_store(search_spaces);
+    BOOST_CHECK(indexed_store.GetBuckets(0).empty());
+    BOOST_CHECK(indexed_store.GetBuckets(99).empty());
+
+    const SortedBucketStore sorted_store(search_spaces);
+    BOOST_CHECK(sorted_store.GetBuckets(0).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,111 @@
+#include "engine/matching_sessions.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <set>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(matching_sessions)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+BOOST_AUTO_TEST_CASE(open_and_find_sessions)
+{
+    MatchingSessions sessions(10, std::chrono::seconds(60));
+    const auto now = MatchingSessions::Clock::now();
+
+    const auto first = sessions.Open(now);
+    const auto second = sessions.Open(now);
+    BOOST_CHECK(first.first != second.first);
+    BOOST_CHECK(first.second != second.second);
+    BOOST_CHECK(first.second == sessions.Find(first.first, now + std::chrono::seconds(30)));
+    BOOST_CHECK(second.second == sessions.Find(second.first, now + std::chrono::seconds(30)));
+    BOOST_CHECK_EQUAL(sessions.Size(), 2);
+
+    // ids are not chosen by the client, unknown ones do not open a session
+    BOOST_CHECK(!sessions.Find("vehicle-1", now));
+    BOOST_CHECK_EQUAL(sessions.Size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(random_session_ids)
+{
+    MatchingSessions sessions(1000, std::chrono::seconds(60));
+    const auto now = MatchingSessions::Clock::now();
+
+    std::set<std::string> ids;
+    for (int session = 0; session < 1000; ++session)
+    {
+        const auto id = sessions.Open(now).first;
+        BOOST_CHECK_EQUAL(id.size(), 32);
+        BOOST_CHECK(std::all_of(id.begin(), id.end(), [](const char digit) {
+            return std::isxdigit(static_cast<unsigned char>(digit));
+        }));
+        ids.insert(id);
+    }
+    BOOST_CHECK_EQUAL(ids.size(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(expire_unused_sessions)
+{
+    MatchingSessions sessions(10, std::chrono::seconds(60));
+    const auto now = MatchingSessions::Clock::now();
+
+    const auto first = sessions.Open(now);
+    const auto second = sessions.Open(now + std::chrono::seconds(40));
+
+    // using a session extends its lifetime
+    BOOST_CHECK(first.second == sessions.Find(first.first, now + std::chrono::seconds(50)));
+    BOOST_CHECK_EQUAL(sessions.Size(), 2);
+
+    // the second session was not used for more than 60 seconds
+    BOOST_CHECK(!sessions.Find(second.first, now + std::chrono::seconds(101)));
+    BOOST_CHECK_EQUAL(sessions.Size(), 1);
+    BOOST_CHECK(!sessions.Find(first.first, now + std::chrono::seconds(200)));
+    BOOST_CHECK_EQUAL(sessions.Size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(drop_least_recently_used_session)
+{
+    MatchingSessions sessions(2, std::chrono::seconds(60));
+    const auto now = MatchingSessions::Clock::now();
+
+    const auto first = sessions.Open(now);
+    const auto second = sessions.Open(now);
+    sessions.Find(first.first, now);
+    sessions.Open(now);
+
+    BOOST_CHECK_EQUAL(sessions.Size(), 2);
+    BOOST_CHECK(first.second == sessions.Find(first.first, now));
+    BOOST_CHECK(!sessions.Find(second.first, now));
+}
+
+BOOST_AUTO_TEST_CASE(drop_points_not_covered_by_state)
+{
+    MatchingSessions::Session session;
+    for (const auto index : {0, 1, 2, 3})
+    {
+        session.coordinates.emplace_back(util::FloatLongitude{1. * index}, util::FloatLatitude{0});
+        session.timestamps.push_back(index);
+        session.gps_precisions.push_back(boost::none);
+        session.candidates.emplace_back();
+    }
+    session.state.model.breakage = {false, true};
+
+    session.DropUnusedPoints();
+    BOOST_CHECK_EQUAL(session.coordinates.size(), 2);
+    BOOST_CHECK_EQUAL(session.timestamps.size(), 2);
+    BOOST_CHECK_EQUAL(session.timestamps.front(), 2);
+    BOOST_CHECK_EQUAL(session.gps_precisions.size(), 2);
+    BOOST_CHECK_EQUAL(session.candidates.size(), 2);
+
+    session.Reset(1);
+    BOOST_CHECK(session.coordinates.empty());
+    BOOST_CHECK_EQUAL(session.state.NumberOfPoints(), 0);
+    BOOST_CHECK_EQUAL(session.dataset_timestamp, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+#include "engine/snapping_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+
+BOOST_AUTO_TEST_SUITE(snapping_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+
+SnappingCache::Key makeKey(const double lon,
+                           const double lat,
+                           const boost::optional<double> radius = boost::none,
+                           const boost::optional<Bearing> bearing = boost::none)
+{
+    return SnappingCache::Key(
+        util::Coordinate{util::FloatLongitude{lon}, util::FloatLatitude{lat}}, radius, bearing);
+}
+
+PhantomNodePair makePhantomNodes(const NodeID forward_segment_id)
+{
+    PhantomNodePair phantom_nodes;
+    phantom_nodes.first.forward_segment_id = {forward_segment_id, true};
+    return phantom_nodes;
+}
+}
+
+BOOST_AUTO_TEST_CASE(find_inserted_entries)
+{
+    SnappingCache cache(100);
+    PhantomNodePair phantom_nodes;
+
+    const auto key = makeKey(7.41, 43.73);
+    BOOST_CHECK(!cache.Find(0, key, phantom_nodes));
+    cache.Insert(0, key, makePhantomNodes(1));
+    BOOST_CHECK(cache.Find(0, key, phantom_nodes));
+    BOOST_CHECK_EQUAL(phantom_nodes.first.forward_segment_id.id, 1);
+
+    // radius and bearing are part of the key
+    BOOST_CHECK(!cache.Find(0, makeKey(7.41, 43.73, 10.), phantom_nodes));
+    BOOST_CHECK(!cache.Find(0, makeKey(7.41, 43.73, boost::none, Bearing{90, 10}), phantom_nodes));
+    cache.Insert(0, makeKey(7.41, 43.73, 10.), makePhantomNodes(2));
+    BOOST_CHECK(cache.Find(0, makeKey(7.41, 43.73, 10.), phantom_nodes));
+    BOOST_CHECK_EQUAL(phantom_nodes.first.forward_segment_id.id, 2);
+
+    const auto statistics = cache.GetStatistics();
+    BOOST_CHECK_EQUAL(statistics.hits, 2);
+    BOOST_CHECK_EQUAL(statistics.misses, 3);
+    BOOST_CHECK_EQUAL(statistics.size, 2);
+    BOOST_CHECK_CLOSE(statistics.HitRate(), 0.4, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(evict_least_recently_used)
+{
+    // one entry per shard
+    SnappingCache cache(1);
+    PhantomNodePair phantom_nodes;
+
+    const std::uint64_t number_of_keys = 1000;
+    for (std::uint64_t index = 0; index < number_of_keys; ++index)
+    {
+        cache.Insert(0, makeKey(0.001 * index, 0.), makePhantomNodes(index));
+    }
+
+    const auto statistics = cache.GetStatistics();
+    BOOST_CHECK_LE(statistics.size, 16);
+    BOOST_CHECK_EQUAL(statistics.evictions + statistics.size, number_of_keys);
+    // the last key is the most recently used one of its shard
+    BOOST_CHECK(cache.Find(0, makeKey(0.001 * (number_of_keys - 1), 0.), phantom_nodes));
+    BOOST_CHECK(!cache.Find(0, makeKey(0., 0.), phantom_nodes));
+}
+
+BOOST_AUTO_TEST_CASE(clear_on_new_dataset)
+{
+    SnappingCache cache(100);
+    PhantomNodePair phantom_nodes;
+
+    const auto key = makeKey(7.41, 43.73);
+    cache.Insert(1, key, makePhantomNodes(1));
+    BOOST_CHECK(cache.Find(1, key, phantom_nodes));
+
+    // a newer dataset drops the old entries
+    BOOST_CHECK(!cache.Find(2, key, phantom_nodes));
+    cache.Insert(2, key, makePhantomNodes(2));
+
+    // requests still running on the old dataset neither see nor replace entries of the new one
+    BOOST_CHECK(!cache.Find(1, key, phantom_nodes));
+    cache.Insert(1, key, makePhantomNodes(1));
+    BOOST_CHECK(cache.Find(2, key, phantom_nodes));
+    BOOST_CHECK_EQUAL(phantom_nodes.first.forward_segment_id.id, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+#include "engine/tile_archive.hpp"
+#include "util/exception.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(tile_archive)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+struct TemporaryFile
+{
+    TemporaryFile() : path(boost::filesystem::unique_path()) {}
+    ~TemporaryFile() { boost::filesystem::remove(path); }
+
+    boost::filesystem::path path;
+};
+}
+
+BOOST_AUTO_TEST_CASE(write_and_find_tiles)
+{
+    TemporaryFile file;
+    {
+        TileArchiveWriter writer(file.path, 42);
+        // in any order, with sizes not aligned
+        writer.Write(16, 34117, 23901, "tile c");
+        writer.Write(14, 8529, 5975, "tile a");
+        writer.Write(15, 17058, 11950, "tile b!");
+        writer.Write(14, 8530, 5975, "");
+        writer.Finish();
+    }
+
+    const TileArchive archive(file.path);
+    BOOST_CHECK_EQUAL(archive.GetCheckSum(), 42);
+    BOOST_CHECK_EQUAL(archive.GetNumberOfTiles(), 4);
+
+    std::string tile;
+    BOOST_CHECK(archive.Find(14, 8529, 5975, tile));
+    BOOST_CHECK_EQUAL(tile, "tile a");
+    BOOST_CHECK(archive.Find(15, 17058, 11950, tile));
+    BOOST_CHECK_EQUAL(tile, "tile b!");
+    BOOST_CHECK(archive.Find(16, 34117, 23901, tile));
+    BOOST_CHECK_EQUAL(tile, "tile c");
+    BOOST_CHECK(archive.Find(14, 8530, 5975, tile));
+    BOOST_CHECK_EQUAL(tile, "");
+
+    BOOST_CHECK(!archive.Find(14, 5975, 8529, tile));
+    BOOST_CHECK(!archive.Find(16, 8529, 5975, tile));
+}
+
+BOOST_AUTO_TEST_CASE(reject_other_files)
+{
+    TemporaryFile file;
+    {
+        boost::filesystem::ofstream output(file.path);
+        output << "this is not a tile archive, but long enough for a header";
+    }
+    BOOST_CHECK_THROW(TileArchive{file.path}, util::exception);
+    BOOST_CHECK_THROW(TileArchive{file.path.string() + ".missing"}, util::exception);
+}
+
+BOOST_AUTO_TEST_CASE(reject_corrupt_index)
+{
+    TemporaryFile file;
+    {
+        TileArchiveWriter writer(file.path, 42);
+        writer.Write(14, 8529, 5975, "tile a");
+        writer.Finish();
+    }
+
+    engine::tile_archive::Header header;
+    {
+        boost::filesystem::ifstream input(file.path, std::ios::binary);
+        input.read(reinterpret_cast<char *>(&header), sizeof(header));
+    }
+
+    // a tile reaching into the index
+    const engine::tile_archive::IndexEntry entry{
+        engine::tile_archive::MakeKey(14, 8529, 5975), sizeof(header), 1024};
+    {
+        boost::filesystem::fstream output(file.path,
+                                          std::ios::binary | std::ios::in | std::ios::out);
+        output.seekp(header.index_offset);
+        output.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+    }
+    BOOST_CHECK_THROW(TileArchive{file.path}, util::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,80 @@
+#include "engine/tile_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(tile_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+BOOST_AUTO_TEST_CASE(find_inserted_tiles)
+{
+    TileCache cache(1024 * 1024);
+    std::string tile;
+
+    BOOST_CHECK(!cache.Find(0, 14, 8529, 5975, tile));
+    cache.Insert(0, 14, 8529, 5975, "tile a");
+    BOOST_CHECK(cache.Find(0, 14, 8529, 5975, tile));
+    BOOST_CHECK_EQUAL(tile, "tile a");
+
+    // x, y and z are part of the key
+    BOOST_CHECK(!cache.Find(0, 14, 5975, 8529, tile));
+    BOOST_CHECK(!cache.Find(0, 15, 8529, 5975, tile));
+    cache.Insert(0, 15, 8529, 5975, "tile b");
+    BOOST_CHECK(cache.Find(0, 15, 8529, 5975, tile));
+    BOOST_CHECK_EQUAL(tile, "tile b");
+
+    const auto statistics = cache.GetStatistics();
+    BOOST_CHECK_EQUAL(statistics.hits, 2);
+    BOOST_CHECK_EQUAL(statistics.misses, 3);
+    BOOST_CHECK_EQUAL(statistics.entries, 2);
+    BOOST_CHECK_EQUAL(statistics.size, 12);
+}
+
+BOOST_AUTO_TEST_CASE(evict_least_recently_used)
+{
+    // 64 bytes per shard
+    TileCache cache(16 * 64);
+    std::string tile;
+
+    const unsigned number_of_tiles = 1000;
+    for (unsigned x = 0; x < number_of_tiles; ++x)
+    {
+        cache.Insert(0, 12, x, 0, std::string(10, 'x'));
+    }
+
+    const auto statistics = cache.GetStatistics();
+    BOOST_CHECK_LE(statistics.size, 16 * 64);
+    BOOST_CHECK_EQUAL(statistics.size, 10 * statistics.entries);
+    BOOST_CHECK_EQUAL(statistics.evictions + statistics.entries, number_of_tiles);
+    // the last tile is the most recently used one of its shard
+    BOOST_CHECK(cache.Find(0, 12, number_of_tiles - 1, 0, tile));
+    BOOST_CHECK(!cache.Find(0, 12, 0, 0, tile));
+
+    // tiles larger than a shard are not cached
+    cache.Insert(0, 13, 0, 0, std::string(65, 'x'));
+    BOOST_CHECK(!cache.Find(0, 13, 0, 0, tile));
+}
+
+BOOST_AUTO_TEST_CASE(clear_on_new_dataset)
+{
+    TileCache cache(1024 * 1024);
+    std::string tile;
+
+    cache.Insert(1, 14, 1, 1, "old");
+    BOOST_CHECK(cache.Find(1, 14, 1, 1, tile));
+
+    // a newer dataset drops the old tiles
+    BOOST_CHECK(!cache.Find(2, 14, 1, 1, tile));
+    cache.Insert(2, 14, 1, 1, "new");
+
+    // requests still running on the old dataset neither see nor replace tiles of the new one
+    BOOST_CHECK(!cache.Find(1, 14, 1, 1, tile));
+    cache.Insert(1, 14, 1, 1, "old");
+    BOOST_CHECK(cache.Find(2, 14, 1, 1, tile));
+    BOOST_CHECK_EQUAL(tile, "new");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,150 @@
+#include "engine/trip/trip_held_karp.hpp"
+#include "engine/trip/trip_local_search.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(trip_solvers)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+
+// Asymmetric durations between random locations on a plane
+util::DistTableWrapper<EdgeWeight> makeTable(const std::size_t number_of_locations,
+                                             const unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> position(0, 1000);
+    std::uniform_int_distribution<int> detour(0, 200);
+
+    std::vector<std::pair<int, int>> locations;
+    for (std::size_t location = 0; location < number_of_locations; ++location)
+    {
+        locations.emplace_back(position(generator), position(generator));
+    }
+
+    std::vector<EdgeWeight> table;
+    for (const auto &from : locations)
+    {
+        for (const auto &to : locations)
+        {
+            table.push_back(std::abs(from.first - to.first) + std::abs(from.second - to.second) +
+                            (from == to ? 0 : detour(generator)));
+        }
+    }
+    return util::DistTableWrapper<EdgeWeight>(std::move(table), number_of_locations);
+}
+
+std::int64_t tripDuration(const std::vector<NodeID> &route,
+                          const util::DistTableWrapper<EdgeWeight> &table)
+{
+    std::int64_t duration = 0;
+    for (std::size_t position = 0; position < route.size(); ++position)
+    {
+        duration += table(route[position], route[(position + 1) % route.size()]);
+    }
+    return duration;
+}
+
+std::int64_t shortestTripDuration(std::vector<NodeID> locations,
+                                  const util::DistTableWrapper<EdgeWeight> &table)
+{
+    auto shortest = tripDuration(locations, table);
+    while (std::next_permutation(locations.begin() + 1, locations.end()))
+    {
+        shortest = std::min(shortest, tripDuration(locations, table));
+    }
+    return shortest;
+}
+
+void checkVisitsAll(std::vector<NodeID> route, std::vector<NodeID> locations)
+{
+    std::sort(route.begin(), route.end());
+    std::sort(locations.begin(), locations.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(route.begin(), route.end(), locations.begin(), locations.end());
+}
+}
+
+BOOST_AUTO_TEST_CASE(held_karp_finds_shortest_trip)
+{
+    for (std::size_t number_of_locations = 1; number_of_locations <= 9; ++number_of_locations)
+    {
+        const auto table = makeTable(number_of_locations, number_of_locations);
+        std::vector<NodeID> locations(number_of_locations);
+        std::iota(locations.begin(), locations.end(), 0);
+
+        const auto route = trip::HeldKarpTrip(
+            locations.begin(), locations.end(), number_of_locations, table);
+        BOOST_CHECK_EQUAL(route.front(), locations.front());
+        checkVisitsAll(route, locations);
+        BOOST_CHECK_EQUAL(tripDuration(route, table), shortestTripDuration(locations, table));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(held_karp_solves_component)
+{
+    // only the locations of the component are visited
+    const auto table = makeTable(8, 42);
+    const std::vector<NodeID> component = {6, 1, 3, 7, 4};
+
+    const auto route = trip::HeldKarpTrip(component.begin(), component.end(), 8, table);
+    BOOST_CHECK_EQUAL(route.front(), component.front());
+    checkVisitsAll(route, component);
+    BOOST_CHECK_EQUAL(tripDuration(route, table), shortestTripDuration(component, table));
+}
+
+BOOST_AUTO_TEST_CASE(held_karp_largest_component)
+{
+    const auto table = makeTable(trip::HELD_KARP_MAX_FEASABLE, 7);
+    std::vector<NodeID> locations(trip::HELD_KARP_MAX_FEASABLE);
+    std::iota(locations.begin(), locations.end(), 0);
+
+    const auto route = trip::HeldKarpTrip(
+        locations.begin(), locations.end(), trip::HELD_KARP_MAX_FEASABLE, table);
+    checkVisitsAll(route, locations);
+
+    // no local search move improves the optimal trip
+    auto improved_route = route;
+    trip::ImproveTrip(improved_route, table, std::chrono::seconds(10));
+    BOOST_CHECK_EQUAL(tripDuration(improved_route, table), tripDuration(route, table));
+}
+
+BOOST_AUTO_TEST_CASE(local_search_improves_trip)
+{
+    const std::size_t number_of_locations = 60;
+    const auto table = makeTable(number_of_locations, 3);
+
+    // visiting the locations in random order is far from the shortest trip
+    std::vector<NodeID> route(number_of_locations);
+    std::iota(route.begin(), route.end(), 0);
+    const auto locations = route;
+    const auto initial_duration = tripDuration(route, table);
+
+    trip::ImproveTrip(route, table, std::chrono::seconds(10));
+    BOOST_CHECK_EQUAL(route.front(), locations.front());
+    checkVisitsAll(route, locations);
+    BOOST_CHECK_LT(2 * tripDuration(route, table), initial_duration);
+}
+
+BOOST_AUTO_TEST_CASE(local_search_without_time_budget)
+{
+    const auto table = makeTable(30, 5);
+    std::vector<NodeID> route(30);
+    std::iota(route.begin(), route.end(), 0);
+    const auto initial_route = route;
+
+    trip::ImproveTrip(route, table, std::chrono::seconds(0));
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        route.begin(), route.end(), initial_route.begin(), initial_route.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
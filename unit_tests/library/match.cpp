@@ -14,6 +14,15 @@
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include "engine/datafacade/process_memory_datafacade.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/integer_range.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(match)
 
 BOOST_AUTO_TEST_CASE(test_match)
@@ -68,4 +77,199 @@ BOOST_AUTO_TEST_CASE(test_match)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_match_batch)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    MatchParameters valid_params;
+    valid_params.coordinates.push_back(get_dummy_location());
+    valid_params.coordinates.push_back(get_dummy_location());
+    valid_params.coordinates.push_back(get_dummy_location());
+
+    MatchParameters invalid_params = valid_params;
+    invalid_params.coordinates.front() =
+        util::Coordinate(util::FloatLongitude{200}, util::FloatLatitude{100});
+
+    std::vector<MatchParameters> batch = {valid_params, invalid_params, valid_params};
+
+    json::Object result;
+
+    const auto rc = osrm.Match(batch, result);
+
+    BOOST_CHECK(rc == Status::Ok);
+    const auto code = result.values.at("code").get<json::String>().value;
+    BOOST_CHECK_EQUAL(code, "Ok");
+
+    // every trace is answered in input order, failing ones do not fail the batch
+    const auto &results = result.values.at("results").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(results.size(), batch.size());
+
+    json::Object single_result;
+    osrm.Match(valid_params, single_result);
+    const auto single_code = single_result.values.at("code").get<json::String>().value;
+
+    const auto result_code = [&](const std::size_t index) {
+        return results[index].get<json::Object>().values.at("code").get<json::String>().value;
+    };
+    BOOST_CHECK_EQUAL(result_code(0), single_code);
+    BOOST_CHECK_EQUAL(result_code(1), "InvalidValue");
+    BOOST_CHECK_EQUAL(result_code(2), single_code);
+}
+
+BOOST_AUTO_TEST_CASE(test_match_session)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {args[0]};
+    config.use_shared_memory = false;
+    config.max_matching_sessions = 10;
+
+    OSRM osrm{config};
+
+    MatchParameters params;
+    params.session = "new";
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+
+    json::Object first_result;
+    const auto first_rc = osrm.Match(params, first_result);
+    BOOST_CHECK(first_rc == Status::Ok);
+    BOOST_CHECK_EQUAL(first_result.values.at("code").get<json::String>().value, "Ok");
+    BOOST_CHECK_EQUAL(first_result.values.at("tracepoints").get<json::Array>().values.size(), 2);
+    const auto session = first_result.values.at("session").get<json::String>().value;
+    BOOST_CHECK_EQUAL(session.size(), 32);
+
+    // an update only sends the new point, the response covers the points kept in the session too
+    params.session = session;
+    params.coordinates.pop_back();
+    json::Object second_result;
+    const auto second_rc = osrm.Match(params, second_result);
+    BOOST_CHECK(second_rc == Status::Ok);
+    BOOST_CHECK_EQUAL(second_result.values.at("code").get<json::String>().value, "Ok");
+    BOOST_CHECK_EQUAL(second_result.values.at("tracepoints").get<json::Array>().values.size(),
+                      3);
+    BOOST_CHECK_EQUAL(second_result.values.at("session").get<json::String>().value, session);
+
+    // the server chooses the ids, unknown ones are rejected
+    params.session = "vehicle";
+    json::Object unknown_result;
+    const auto unknown_rc = osrm.Match(params, unknown_result);
+    BOOST_CHECK(unknown_rc == Status::Error);
+    BOOST_CHECK_EQUAL(unknown_result.values.at("code").get<json::String>().value, "NoSession");
+
+    // sessions are disabled by default
+    auto osrm_without_sessions = getOSRM(args[0]);
+    json::Object disabled_result;
+    const auto disabled_rc = osrm_without_sessions.Match(params, disabled_result);
+    BOOST_CHECK(disabled_rc == Status::Error);
+    BOOST_CHECK_EQUAL(disabled_result.values.at("code").get<json::String>().value,
+                      "InvalidOptions");
+}
+
+// Map matching computes the transitions between the candidates of two trace points with one
+// many-to-many search instead of a query per pair, bounded by the maximal plausible duration.
+BOOST_AUTO_TEST_CASE(test_match_transition_distances)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+    using namespace osrm::engine;
+
+    const datafacade::ProcessMemoryDataFacade facade{storage::StorageConfig{args[0]}};
+    // the test data is fully contracted, so the bound prunes plain CH searches
+    BOOST_CHECK_EQUAL(facade.GetCoreSize(), 0);
+
+    const auto locations = get_locations_in_big_component();
+
+    // candidates of two consecutive trace points as sources and targets
+    std::vector<PhantomNode> phantom_nodes;
+    std::vector<std::size_t> source_indices, target_indices;
+    for (const auto &candidate : facade.NearestPhantomNodesInRange(locations.at(0), 100))
+    {
+        source_indices.push_back(phantom_nodes.size());
+        phantom_nodes.push_back(candidate.phantom_node);
+    }
+    for (const auto &candidate : facade.NearestPhantomNodesInRange(locations.at(1), 100))
+    {
+        target_indices.push_back(phantom_nodes.size());
+        phantom_nodes.push_back(candidate.phantom_node);
+    }
+    BOOST_REQUIRE_GT(source_indices.size(), 1);
+    BOOST_REQUIRE_GT(target_indices.size(), 1);
+
+    SearchEngineData heaps;
+    routing_algorithms::ManyToManyRouting<datafacade::BaseDataFacade> many_to_many(heaps);
+    const auto unbounded_table =
+        many_to_many(facade, phantom_nodes, source_indices, target_indices, true);
+    const auto &durations = unbounded_table.first;
+    const auto &distances = unbounded_table.second;
+
+    // the many-to-many distances are the ones of the per pair queries they replace
+    std::vector<EdgeWeight> reachable_durations;
+    for (const auto row_idx : util::irange<std::size_t>(0UL, source_indices.size()))
+    {
+        for (const auto column_idx : util::irange<std::size_t>(0UL, target_indices.size()))
+        {
+            heaps.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes());
+            const auto pair_distance =
+                many_to_many.GetNetworkDistance(facade,
+                                                *heaps.forward_heap_1,
+                                                *heaps.reverse_heap_1,
+                                                phantom_nodes[source_indices[row_idx]],
+                                                phantom_nodes[target_indices[column_idx]]);
+
+            const auto entry_idx = row_idx * target_indices.size() + column_idx;
+            if (pair_distance == std::numeric_limits<double>::max())
+            {
+                BOOST_CHECK_EQUAL(durations[entry_idx], INVALID_EDGE_WEIGHT);
+                BOOST_CHECK_EQUAL(distances[entry_idx], std::numeric_limits<double>::max());
+            }
+            else
+            {
+                BOOST_CHECK_CLOSE(distances[entry_idx], pair_distance, 0.1);
+                reachable_durations.push_back(durations[entry_idx]);
+            }
+        }
+    }
+    BOOST_REQUIRE(!reachable_durations.empty());
+
+    // with a bound between the shortest and the longest transition some entries are pruned,
+    // all others stay the same
+    std::sort(reachable_durations.begin(), reachable_durations.end());
+    const auto duration_upper_bound = reachable_durations[reachable_durations.size() / 2] + 1;
+    const auto bounded_table = many_to_many(
+        facade, phantom_nodes, source_indices, target_indices, true, duration_upper_bound);
+
+    std::size_t number_of_pruned = 0;
+    for (const auto entry_idx : util::irange<std::size_t>(0UL, durations.size()))
+    {
+        if (durations[entry_idx] < duration_upper_bound)
+        {
+            BOOST_CHECK_EQUAL(bounded_table.first[entry_idx], durations[entry_idx]);
+            BOOST_CHECK_EQUAL(bounded_table.second[entry_idx], distances[entry_idx]);
+        }
+        else
+        {
+            BOOST_CHECK_EQUAL(bounded_table.first[entry_idx], INVALID_EDGE_WEIGHT);
+            BOOST_CHECK_EQUAL(bounded_table.second[entry_idx],
+                              std::numeric_limits<double>::max());
+            ++number_of_pruned;
+        }
+    }
+    if (reachable_durations.back() >= duration_upper_bound)
+    {
+        BOOST_CHECK_GT(number_of_pruned, 0);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
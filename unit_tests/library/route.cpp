@@ -14,6 +14,15 @@
 #include "osrm/route_parameters.hpp"
 #include "osrm/status.hpp"
 
+#include "engine/api/protobuf_factory.hpp"
+#include "util/integer_range.hpp"
+
+#include <protozero/pbf_reader.hpp>
+
+#include <map>
+#include <utility>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(route)
 
 BOOST_AUTO_TEST_CASE(test_route_same_coordinates_fixture)
@@ -323,6 +332,82 @@ BOOST_AUTO_TEST_CASE(test_route_response_for_locations_in_big_component)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_route_protobuf_response_for_locations_in_big_component)
+{
+    const auto args = get_args();
+    auto osrm = getOSRM(args.at(0));
+
+    using namespace osrm;
+    namespace protobuf = engine::api::protobuf;
+
+    const auto locations = get_locations_in_big_component();
+
+    RouteParameters params;
+    params.coordinates.push_back(locations.at(0));
+    params.coordinates.push_back(locations.at(1));
+    params.coordinates.push_back(locations.at(2));
+    params.overview = RouteParameters::OverviewType::Full;
+
+    std::string result;
+    const auto rc = osrm.Route(params, result);
+    BOOST_CHECK(rc == Status::Ok);
+
+    std::size_t waypoints = 0, routes = 0;
+    protozero::pbf_reader response(result);
+    while (response.next())
+    {
+        switch (response.tag())
+        {
+        case protobuf::CODE_TAG:
+            BOOST_CHECK_EQUAL(response.get_string(), "Ok");
+            break;
+        case protobuf::route::WAYPOINTS_TAG:
+            response.skip();
+            ++waypoints;
+            break;
+        case protobuf::route::ROUTES_TAG:
+        {
+            std::size_t legs = 0;
+            protozero::pbf_reader route = response.get_message();
+            while (route.next())
+            {
+                switch (route.tag())
+                {
+                case protobuf::route::DISTANCE_TAG:
+                case protobuf::route::DURATION_TAG:
+                    BOOST_CHECK_GT(route.get_double(), 0);
+                    break;
+                case protobuf::route::GEOMETRY_TAG:
+                {
+                    const auto geometry = route.get_packed_sfixed32();
+                    const auto size = std::distance(geometry.first, geometry.second);
+                    BOOST_CHECK_GT(size, 2);
+                    BOOST_CHECK_EQUAL(size % 2, 0);
+                    break;
+                }
+                case protobuf::route::LEGS_TAG:
+                    route.skip();
+                    ++legs;
+                    break;
+                default:
+                    BOOST_ERROR("unexpected field " << route.tag());
+                    route.skip();
+                }
+            }
+            BOOST_CHECK_EQUAL(legs, params.coordinates.size() - 1);
+            ++routes;
+            break;
+        }
+        default:
+            BOOST_ERROR("unexpected field " << response.tag());
+            response.skip();
+        }
+    }
+
+    BOOST_CHECK_EQUAL(waypoints, params.coordinates.size());
+    BOOST_CHECK_EQUAL(routes, 1);
+}
+
 BOOST_AUTO_TEST_CASE(test_route_response_for_locations_across_components)
 {
     const auto args = get_args();
@@ -361,4 +446,206 @@ BOOST_AUTO_TEST_CASE(test_route_response_for_locations_across_components)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_route_memory_mapped_matches_loaded_data)
+{
+    const auto args = get_args();
+    auto osrm = getOSRM(args.at(0));
+
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {args.at(0)};
+    config.use_shared_memory = false;
+    config.use_mmap = true;
+    // the first instance writes the memory image if needed, the second one maps it
+    {
+        OSRM image_osrm{config};
+    }
+    OSRM mapped_osrm{config};
+
+    const auto locations = get_locations_in_big_component();
+
+    RouteParameters params;
+    params.coordinates.push_back(locations.at(0));
+    params.coordinates.push_back(locations.at(1));
+    params.coordinates.push_back(locations.at(2));
+
+    json::Object reference;
+    BOOST_CHECK(osrm.Route(params, reference) == Status::Ok);
+
+    json::Object result;
+    BOOST_CHECK(mapped_osrm.Route(params, result) == Status::Ok);
+
+    CHECK_EQUAL_JSON(reference, result);
+}
+
+// Locations on opposite ends of Monaco, with several reasonable routes between them
+inline Locations get_locations_with_alternatives()
+{
+    return {{Longitude{7.413370}, Latitude{43.729560}}, {Longitude{7.435060}, Latitude{43.746510}}};
+}
+
+BOOST_AUTO_TEST_CASE(test_route_alternatives)
+{
+    const auto args = get_args();
+    auto osrm = getOSRM(args.at(0));
+
+    using namespace osrm;
+
+    const auto locations = get_locations_with_alternatives();
+
+    RouteParameters params;
+    params.alternatives = true;
+    params.number_of_alternatives = 3;
+    params.annotations = true;
+    params.coordinates.push_back(locations.at(0));
+    params.coordinates.push_back(locations.at(1));
+
+    json::Object result;
+    const auto rc = osrm.Route(params, result);
+    BOOST_REQUIRE(rc == Status::Ok);
+
+    const auto &routes = result.values.at("routes").get<json::Array>().values;
+    // the shortest route plus more than one, but at most the requested number of alternatives
+    BOOST_CHECK_GT(routes.size(), 2);
+    BOOST_CHECK_LE(routes.size(), 1 + params.number_of_alternatives);
+
+    // annotated segments of every route, keyed by their OSM nodes
+    std::vector<std::map<std::pair<double, double>, double>> route_segments;
+    std::vector<double> route_durations;
+    for (const auto &route : routes)
+    {
+        const auto &route_object = route.get<json::Object>();
+        route_durations.push_back(route_object.values.at("duration").get<json::Number>().value);
+
+        const auto &legs = route_object.values.at("legs").get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(legs.size(), 1);
+        const auto &annotation =
+            legs.front().get<json::Object>().values.at("annotation").get<json::Object>();
+        const auto &nodes = annotation.values.at("nodes").get<json::Array>().values;
+        const auto &durations = annotation.values.at("duration").get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(nodes.size(), durations.size() + 1);
+
+        route_segments.emplace_back();
+        for (const auto index : util::irange<std::size_t>(0UL, durations.size()))
+        {
+            route_segments.back().emplace(
+                std::make_pair(nodes[index].get<json::Number>().value,
+                               nodes[index + 1].get<json::Number>().value),
+                durations[index].get<json::Number>().value);
+        }
+    }
+
+    // the shortest route comes first, alternatives are at most 15% longer
+    const auto shortest_duration = route_durations.front();
+    for (const auto duration : route_durations)
+    {
+        BOOST_CHECK_GE(duration + 1., shortest_duration);
+        BOOST_CHECK_LE(duration, 1.15 * shortest_duration + 1.);
+    }
+
+    // no two routes share more than 75% of the length of the shortest route, a second of
+    // tolerance covers the partial segments at the phantom nodes
+    for (const auto first : util::irange<std::size_t>(0UL, route_segments.size()))
+    {
+        for (const auto second : util::irange<std::size_t>(first + 1, route_segments.size()))
+        {
+            double shared_duration = 0.;
+            for (const auto &segment : route_segments[second])
+            {
+                if (route_segments[first].count(segment.first) > 0)
+                {
+                    shared_duration += segment.second;
+                }
+            }
+            BOOST_CHECK_LE(shared_duration, 0.75 * shortest_duration + 1.);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_route_alternatives_limit)
+{
+    const auto args = get_args();
+
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {args.at(0)};
+    config.use_shared_memory = false;
+    config.max_alternatives = 2;
+
+    OSRM osrm{config};
+
+    const auto locations = get_locations_with_alternatives();
+
+    RouteParameters params;
+    params.alternatives = true;
+    params.number_of_alternatives = 3;
+    params.coordinates.push_back(locations.at(0));
+    params.coordinates.push_back(locations.at(1));
+
+    json::Object result;
+    const auto rc = osrm.Route(params, result);
+    BOOST_CHECK(rc == Status::Error);
+
+    const auto code = result.values.at("code").get<json::String>().value;
+    BOOST_CHECK_EQUAL(code, "TooBig");
+
+    // the limit itself is allowed
+    params.number_of_alternatives = 2;
+    json::Object allowed_result;
+    BOOST_CHECK(osrm.Route(params, allowed_result) == Status::Ok);
+}
+
+BOOST_AUTO_TEST_CASE(test_route_snapping_cache_statistics)
+{
+    const auto args = get_args();
+
+    using namespace osrm;
+
+    const auto locations = get_locations_in_big_component();
+
+    RouteParameters params;
+    params.coordinates.push_back(locations.at(0));
+    params.coordinates.push_back(locations.at(1));
+
+    // disabled by default
+    {
+        auto osrm = getOSRM(args.at(0));
+        json::Object result;
+        BOOST_CHECK(osrm.Route(params, result) == Status::Ok);
+
+        const auto statistics = osrm.GetSnappingCacheStatistics();
+        BOOST_CHECK_EQUAL(statistics.hits, 0);
+        BOOST_CHECK_EQUAL(statistics.misses, 0);
+        BOOST_CHECK_EQUAL(statistics.entries, 0);
+    }
+
+    EngineConfig config;
+    config.storage_config = {args.at(0)};
+    config.use_shared_memory = false;
+    config.snapping_cache_size = 100;
+    OSRM osrm{config};
+
+    json::Object first_result;
+    BOOST_CHECK(osrm.Route(params, first_result) == Status::Ok);
+
+    auto statistics = osrm.GetSnappingCacheStatistics();
+    BOOST_CHECK_EQUAL(statistics.hits, 0);
+    BOOST_CHECK_EQUAL(statistics.misses, 2);
+    BOOST_CHECK_EQUAL(statistics.entries, 2);
+    BOOST_CHECK_EQUAL(statistics.evictions, 0);
+
+    json::Object second_result;
+    BOOST_CHECK(osrm.Route(params, second_result) == Status::Ok);
+
+    statistics = osrm.GetSnappingCacheStatistics();
+    BOOST_CHECK_EQUAL(statistics.hits, 2);
+    BOOST_CHECK_EQUAL(statistics.misses, 2);
+    BOOST_CHECK_EQUAL(statistics.entries, 2);
+    BOOST_CHECK_EQUAL(statistics.HitRate(), 0.5);
+
+    CHECK_EQUAL_JSON(first_result, second_result);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
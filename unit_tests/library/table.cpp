@@ -14,6 +14,13 @@
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include "engine/api/protobuf_factory.hpp"
+
+#include <protozero/pbf_reader.hpp>
+
+#include <cmath>
+#include <iterator>
+
 BOOST_AUTO_TEST_SUITE(table)
 
 BOOST_AUTO_TEST_CASE(test_table_three_coords_one_source_one_dest_matrix)
@@ -161,4 +168,221 @@ BOOST_AUTO_TEST_CASE(test_table_three_coordinates_matrix)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_table_three_coordinates_distance_matrix)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    TableParameters params;
+    params.coordinates = get_locations_in_big_component();
+    params.annotations = TableParameters::AnnotationsType::Distance;
+
+    json::Object result;
+
+    const auto rc = osrm.Table(params, result);
+
+    BOOST_CHECK(rc == Status::Ok || rc == Status::Error);
+    const auto code = result.values.at("code").get<json::String>().value;
+    BOOST_CHECK_EQUAL(code, "Ok");
+
+    // only the distances were requested
+    BOOST_CHECK(result.values.find("durations") == result.values.end());
+
+    // check that returned distances are of the expected size and proportions
+    // this test expects a 3x3 matrix
+    const auto &distances_array = result.values.at("distances").get<json::Array>().values;
+    BOOST_CHECK_EQUAL(distances_array.size(), params.coordinates.size());
+    for (unsigned int i = 0; i < distances_array.size(); i++)
+    {
+        const auto distances_matrix = distances_array[i].get<json::Array>().values;
+        BOOST_CHECK_EQUAL(distances_matrix.size(), params.coordinates.size());
+        for (unsigned int j = 0; j < distances_matrix.size(); j++)
+        {
+            const auto distance = distances_matrix[j].get<json::Number>().value;
+            if (i == j)
+            {
+                BOOST_CHECK_EQUAL(distance, 0);
+            }
+            else
+            {
+                BOOST_CHECK_GT(distance, 0);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_table_three_coordinates_duration_and_distance_matrix)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    TableParameters params;
+    params.coordinates = get_locations_in_big_component();
+    params.sources.push_back(0);
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    json::Object result;
+
+    const auto rc = osrm.Table(params, result);
+
+    BOOST_CHECK(rc == Status::Ok || rc == Status::Error);
+    const auto code = result.values.at("code").get<json::String>().value;
+    BOOST_CHECK_EQUAL(code, "Ok");
+
+    // this test expects a 1x3 matrix for both annotations
+    const auto &durations_array = result.values.at("durations").get<json::Array>().values;
+    const auto &distances_array = result.values.at("distances").get<json::Array>().values;
+    BOOST_CHECK_EQUAL(durations_array.size(), params.sources.size());
+    BOOST_CHECK_EQUAL(distances_array.size(), params.sources.size());
+    const auto durations_matrix = durations_array[0].get<json::Array>().values;
+    const auto distances_matrix = distances_array[0].get<json::Array>().values;
+    BOOST_CHECK_EQUAL(durations_matrix.size(), params.coordinates.size());
+    BOOST_CHECK_EQUAL(distances_matrix.size(), params.coordinates.size());
+    for (unsigned int j = 1; j < distances_matrix.size(); j++)
+    {
+        BOOST_CHECK_GT(durations_matrix[j].get<json::Number>().value, 0);
+        BOOST_CHECK_GT(distances_matrix[j].get<json::Number>().value, 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_table_three_coordinates_rendered_matrix)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    TableParameters params;
+    params.coordinates = get_locations_in_big_component();
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    std::vector<char> result;
+
+    const auto rc = osrm.Table(params, result);
+
+    BOOST_CHECK(rc == Status::Ok);
+    const std::string rendered(result.begin(), result.end());
+    BOOST_CHECK_EQUAL(rendered.front(), '{');
+    BOOST_CHECK_EQUAL(rendered.back(), '}');
+    BOOST_CHECK(rendered.find("\"code\":\"Ok\"") != std::string::npos);
+    BOOST_CHECK(rendered.find("\"durations\":[[0,") != std::string::npos);
+    BOOST_CHECK(rendered.find("\"distances\":[[0,") != std::string::npos);
+    BOOST_CHECK(rendered.find("\"sources\":[{") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_rendered_error)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    auto osrm = getOSRM(args[0]);
+
+    TableParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.emplace_back(util::FloatLongitude{200}, util::FloatLatitude{100});
+
+    std::vector<char> result;
+
+    const auto rc = osrm.Table(params, result);
+
+    BOOST_CHECK(rc == Status::Error);
+    const std::string rendered(result.begin(), result.end());
+    BOOST_CHECK(rendered.find("\"code\":\"InvalidOptions\"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_three_coordinates_protobuf_matrix)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+    namespace protobuf = engine::api::protobuf;
+
+    auto osrm = getOSRM(args[0]);
+
+    TableParameters params;
+    params.coordinates = get_locations_in_big_component();
+    params.sources.push_back(0);
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    std::string result;
+
+    const auto rc = osrm.Table(params, result);
+
+    BOOST_CHECK(rc == Status::Ok);
+
+    std::size_t sources = 0, destinations = 0, rows = 0, columns = 0;
+    std::vector<float> durations, distances;
+    protozero::pbf_reader response(result);
+    while (response.next())
+    {
+        switch (response.tag())
+        {
+        case protobuf::CODE_TAG:
+            BOOST_CHECK_EQUAL(response.get_string(), "Ok");
+            break;
+        case protobuf::table::SOURCES_TAG:
+        {
+            protozero::pbf_reader waypoint = response.get_message();
+            BOOST_CHECK(waypoint.next(protobuf::waypoint::LONGITUDE_TAG));
+            const auto longitude = waypoint.get_double();
+            BOOST_CHECK(longitude >= -180. && longitude <= 180.);
+            ++sources;
+            break;
+        }
+        case protobuf::table::DESTINATIONS_TAG:
+            response.skip();
+            ++destinations;
+            break;
+        case protobuf::table::ROWS_TAG:
+            rows = response.get_uint32();
+            break;
+        case protobuf::table::COLUMNS_TAG:
+            columns = response.get_uint32();
+            break;
+        case protobuf::table::DURATIONS_TAG:
+        {
+            const auto packed = response.get_packed_float();
+            durations.assign(packed.first, packed.second);
+            break;
+        }
+        case protobuf::table::DISTANCES_TAG:
+        {
+            const auto packed = response.get_packed_float();
+            distances.assign(packed.first, packed.second);
+            break;
+        }
+        default:
+            BOOST_ERROR("unexpected field " << response.tag());
+            response.skip();
+        }
+    }
+
+    BOOST_CHECK_EQUAL(sources, params.sources.size());
+    BOOST_CHECK_EQUAL(destinations, params.coordinates.size());
+    BOOST_CHECK_EQUAL(rows, params.sources.size());
+    BOOST_CHECK_EQUAL(columns, params.coordinates.size());
+    BOOST_REQUIRE_EQUAL(durations.size(), rows * columns);
+    BOOST_REQUIRE_EQUAL(distances.size(), rows * columns);
+    BOOST_CHECK_EQUAL(durations[0], 0);
+    for (std::size_t column = 1; column < columns; ++column)
+    {
+        BOOST_CHECK(!std::isnan(durations[column]));
+        BOOST_CHECK_GT(durations[column], 0);
+        BOOST_CHECK_GT(distances[column], 0);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,247 @@
+#ifndef GRID_DATAFACADE_HPP
+#define GRID_DATAFACADE_HPP
+
+// implements the graph and geometry of a contracted grid, to run the routing algorithms without
+// a data set
+
+#include "mocks/mock_datafacade.hpp"
+
+#include "contractor/graph_contractor.hpp"
+#include "contractor/query_edge.hpp"
+#include "engine/phantom_node.hpp"
+#include "extractor/edge_based_edge.hpp"
+#include "extractor/travel_mode.hpp"
+#include "util/coordinate.hpp"
+#include "util/deallocating_vector.hpp"
+#include "util/integer_range.hpp"
+#include "util/static_graph.hpp"
+#include "util/typedefs.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace osrm
+{
+namespace test
+{
+
+/**
+ * Edge-based graph of width * width segments on a grid with random weights, contracted the way
+ * osrm-contract does. Every segment has both of its ends at its grid position, so the length of
+ * a path is the length of the line through the grid positions of its segments. Turns go to the
+ * right and lower neighbours and cost the weight of the segment they leave. Like in edge-based
+ * graphs of road networks no two segments have turns to each other, which the contractor relies
+ * on when it merges the edges of both directions.
+ */
+class GridDataFacade final : public MockDataFacade
+{
+  public:
+    GridDataFacade(const NodeID width, const unsigned seed)
+        : width(width), segment_weights(MakeSegmentWeights(width, seed)),
+          graph(width * width, MakeContractedEdges())
+    {
+        for (const auto edge : util::irange<EdgeID>(0, graph.GetNumberOfEdges()))
+        {
+            search_edges.push_back(SearchEdgeData(graph.GetEdgeData(edge)));
+        }
+    }
+
+    // Phantom node at the start of the segment, only traversable in forward direction
+    engine::PhantomNode GetPhantomNode(const NodeID node) const
+    {
+        const auto location = GetCoordinateOfNode(node);
+        return engine::PhantomNode{SegmentID{node, true},
+                                   SegmentID{SPECIAL_SEGMENTID, false},
+                                   0,
+                                   0,
+                                   INVALID_EDGE_WEIGHT,
+                                   0,
+                                   0,
+                                   node,
+                                   false,
+                                   0,
+                                   location,
+                                   location,
+                                   0,
+                                   TRAVEL_MODE_DRIVING,
+                                   TRAVEL_MODE_INACCESSIBLE};
+    }
+
+    // Weight of the shortest path between the starts of two segments by Dijkstra on the grid
+    EdgeWeight GetReferenceWeight(const NodeID source, const NodeID target) const
+    {
+        std::vector<EdgeWeight> weights(segment_weights.size(), INVALID_EDGE_WEIGHT);
+        std::vector<std::pair<EdgeWeight, NodeID>> queue = {{0, source}};
+        const auto greater = std::greater<std::pair<EdgeWeight, NodeID>>();
+        weights[source] = 0;
+        while (!queue.empty())
+        {
+            std::pop_heap(queue.begin(), queue.end(), greater);
+            const auto entry = queue.back();
+            queue.pop_back();
+            if (entry.second == target)
+            {
+                return entry.first;
+            }
+            if (entry.first > weights[entry.second])
+            {
+                continue;
+            }
+            const NodeID x = entry.second % width;
+            const NodeID y = entry.second / width;
+            const auto relax = [&](const NodeID to) {
+                const auto weight = entry.first + segment_weights[entry.second];
+                if (weight < weights[to])
+                {
+                    weights[to] = weight;
+                    queue.emplace_back(weight, to);
+                    std::push_heap(queue.begin(), queue.end(), greater);
+                }
+            };
+            if (x + 1 < width)
+                relax(entry.second + 1);
+            if (y + 1 < width)
+                relax(entry.second + width);
+        }
+        return INVALID_EDGE_WEIGHT;
+    }
+
+    unsigned GetNumberOfNodes() const override { return graph.GetNumberOfNodes(); }
+    unsigned GetNumberOfEdges() const override { return graph.GetNumberOfEdges(); }
+    unsigned GetOutDegree(const NodeID n) const override { return graph.GetOutDegree(n); }
+    NodeID GetTarget(const EdgeID e) const override { return graph.GetTarget(e); }
+    EdgeData GetEdgeData(const EdgeID e) const override { return graph.GetEdgeData(e); }
+    const SearchEdgeData &GetSearchEdgeData(const EdgeID e) const override
+    {
+        return search_edges[e];
+    }
+    EdgeID BeginEdges(const NodeID n) const override { return graph.BeginEdges(n); }
+    EdgeID EndEdges(const NodeID n) const override { return graph.EndEdges(n); }
+    engine::datafacade::EdgeRange GetAdjacentEdgeRange(const NodeID node) const override
+    {
+        return graph.GetAdjacentEdgeRange(node);
+    }
+    EdgeID FindEdge(const NodeID from, const NodeID to) const override
+    {
+        return graph.FindEdge(from, to);
+    }
+    EdgeID FindEdgeInEitherDirection(const NodeID from, const NodeID to) const override
+    {
+        return graph.FindEdgeInEitherDirection(from, to);
+    }
+    EdgeID
+    FindEdgeIndicateIfReverse(const NodeID from, const NodeID to, bool &result) const override
+    {
+        return graph.FindEdgeIndicateIfReverse(from, to, result);
+    }
+    EdgeID FindSmallestEdge(const NodeID from,
+                            const NodeID to,
+                            std::function<bool(EdgeData)> filter) const override
+    {
+        return graph.FindSmallestEdge(from, to, filter);
+    }
+
+    util::Coordinate GetCoordinateOfNode(const unsigned id) const override
+    {
+        return {util::FloatLongitude{0.001 * (id % width)},
+                util::FloatLatitude{0.001 * (id / width)}};
+    }
+    GeometryID GetGeometryIndexForEdgeID(const unsigned id) const override
+    {
+        return GeometryID{turn_sources[id], true};
+    }
+    std::vector<NodeID> GetUncompressedForwardGeometry(const EdgeID id) const override
+    {
+        return {id, id};
+    }
+    std::vector<NodeID> GetUncompressedReverseGeometry(const EdgeID id) const override
+    {
+        return {id, id};
+    }
+    std::vector<EdgeWeight> GetUncompressedForwardWeights(const EdgeID id) const override
+    {
+        return {segment_weights[id]};
+    }
+    std::vector<EdgeWeight> GetUncompressedReverseWeights(const EdgeID id) const override
+    {
+        return {segment_weights[id]};
+    }
+    std::vector<uint8_t> GetUncompressedForwardDatasources(const EdgeID /*id*/) const override
+    {
+        return {0};
+    }
+    std::vector<uint8_t> GetUncompressedReverseDatasources(const EdgeID /*id*/) const override
+    {
+        return {0};
+    }
+
+  private:
+    using Graph = util::StaticGraph<EdgeData>;
+
+    static std::vector<EdgeWeight> MakeSegmentWeights(const NodeID width, const unsigned seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<EdgeWeight> weight_distribution(50, 100);
+        std::vector<EdgeWeight> weights;
+        for (NodeID node = 0; node < width * width; ++node)
+        {
+            weights.push_back(weight_distribution(generator));
+        }
+        return weights;
+    }
+
+    // adds the turns between neighbouring segments and contracts them
+    std::vector<Graph::InputEdge> MakeContractedEdges()
+    {
+        util::DeallocatingVector<extractor::EdgeBasedEdge> turns;
+        const auto add_turn = [&](const NodeID from, const NodeID to) {
+            turns.push_back(extractor::EdgeBasedEdge(
+                from, to, turn_sources.size(), segment_weights[from], true, false));
+            turn_sources.push_back(from);
+        };
+        for (NodeID y = 0; y < width; ++y)
+        {
+            for (NodeID x = 0; x < width; ++x)
+            {
+                const NodeID node = y * width + x;
+                if (x + 1 < width)
+                {
+                    add_turn(node, node + 1);
+                }
+                if (y + 1 < width)
+                {
+                    add_turn(node, node + width);
+                }
+            }
+        }
+
+        contractor::GraphContractor graph_contractor(width * width,
+                                                     turns,
+                                                     std::vector<float>{},
+                                                     std::vector<EdgeWeight>(segment_weights));
+        graph_contractor.Run();
+        util::DeallocatingVector<contractor::QueryEdge> contracted_edges;
+        graph_contractor.GetEdges(contracted_edges);
+
+        std::vector<Graph::InputEdge> input_edges;
+        for (const auto &edge : contracted_edges)
+        {
+            input_edges.emplace_back(edge.source, edge.target, edge.data);
+        }
+        std::sort(input_edges.begin(), input_edges.end());
+        return input_edges;
+    }
+
+    const NodeID width;
+    std::vector<EdgeWeight> segment_weights;
+    // segment a turn leaves, indexed by the id of the turn
+    std::vector<NodeID> turn_sources;
+    Graph graph;
+    std::vector<SearchEdgeData> search_edges;
+};
+}
+}
+
+#endif // GRID_DATAFACADE_HPP
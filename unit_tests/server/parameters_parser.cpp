@@ -55,6 +55,8 @@ BOOST_AUTO_TEST_CASE(invalid_route_urls)
                       32L);
     BOOST_CHECK_EQUAL(
         testInvalidOptions<RouteParameters>("1,2;3,4?overview=false&alternatives=foo"), 36UL);
+    BOOST_CHECK_EQUAL(
+        testInvalidOptions<RouteParameters>("1,2;3,4?overview=false&alternatives=-1"), 36UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>(""), 0);
     BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3.4.unsupported"), 7);
     BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4.json?nooptions"), 13);
@@ -63,6 +65,7 @@ BOOST_AUTO_TEST_CASE(invalid_route_urls)
     BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>(std::string{"1,2;3,4"} + '\0' + ".json"),
                       7);
     BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>(std::string{"1,2;3,"} + '\0'), 6);
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4.pbf?nooptions"), 12);
 
     // BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>(), );
 }
@@ -75,6 +78,8 @@ BOOST_AUTO_TEST_CASE(invalid_table_urls)
         testInvalidOptions<TableParameters>("1,2;3,4?sources=1&destinations=1&bla=foo"), 32UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?sources=foo"), 16UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?destinations=foo"), 21UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?annotations=speed"), 20UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4.csv"), 8UL);
 }
 
 BOOST_AUTO_TEST_CASE(valid_route_hint)
@@ -126,6 +131,15 @@ BOOST_AUTO_TEST_CASE(valid_route_urls)
     CHECK_EQUAL_RANGE(reference_2.coordinates, result_2->coordinates);
     CHECK_EQUAL_RANGE(reference_2.hints, result_2->hints);
 
+    auto result_k = parseParameters<RouteParameters>("1,2;3,4?alternatives=3");
+    BOOST_CHECK(result_k);
+    BOOST_CHECK_EQUAL(result_k->alternatives, true);
+    BOOST_CHECK_EQUAL(result_k->number_of_alternatives, 3);
+    auto result_no_alternatives = parseParameters<RouteParameters>("1,2;3,4?alternatives=0");
+    BOOST_CHECK(result_no_alternatives);
+    BOOST_CHECK_EQUAL(result_no_alternatives->alternatives, false);
+    BOOST_CHECK_EQUAL(result_2->number_of_alternatives, 1);
+
     RouteParameters reference_3{false,
                                 false,
                                 false,
@@ -332,6 +346,31 @@ BOOST_AUTO_TEST_CASE(valid_table_urls)
     CHECK_EQUAL_RANGE(reference_1.bearings, result_3->bearings);
     CHECK_EQUAL_RANGE(reference_1.radiuses, result_3->radiuses);
     CHECK_EQUAL_RANGE(reference_1.coordinates, result_3->coordinates);
+
+    auto result_4 = parseParameters<TableParameters>("1,2;3,4?annotations=distance");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(result_4->annotations == TableParameters::AnnotationsType::Distance);
+    CHECK_EQUAL_RANGE(reference_1.sources, result_4->sources);
+    CHECK_EQUAL_RANGE(reference_1.destinations, result_4->destinations);
+    CHECK_EQUAL_RANGE(reference_1.coordinates, result_4->coordinates);
+
+    auto result_5 =
+        parseParameters<TableParameters>("1,2;3,4?sources=1&annotations=duration,distance");
+    BOOST_CHECK(result_5);
+    BOOST_CHECK(result_5->annotations == TableParameters::AnnotationsType::All);
+    CHECK_EQUAL_RANGE(reference_2.coordinates, result_5->coordinates);
+
+    auto result_6 = parseParameters<TableParameters>("1,2;3,4.pbf?sources=1");
+    BOOST_CHECK(result_6);
+    BOOST_CHECK(result_6->format == TableParameters::FormatType::Protobuf);
+    BOOST_CHECK_EQUAL(result_6->sources.size(), 1);
+    BOOST_CHECK_EQUAL(result_6->sources.front(), 1);
+    CHECK_EQUAL_RANGE(reference_2.coordinates, result_6->coordinates);
+
+    auto result_7 = parseParameters<TableParameters>("1,2;3,4.json");
+    BOOST_CHECK(result_7);
+    BOOST_CHECK(result_7->format == TableParameters::FormatType::JSON);
+    CHECK_EQUAL_RANGE(reference_2.coordinates, result_7->coordinates);
 }
 
 BOOST_AUTO_TEST_CASE(valid_match_urls)
@@ -357,6 +396,27 @@ BOOST_AUTO_TEST_CASE(valid_match_urls)
     CHECK_EQUAL_RANGE(reference_2.bearings, result_2->bearings);
     CHECK_EQUAL_RANGE(reference_2.radiuses, result_2->radiuses);
     CHECK_EQUAL_RANGE(reference_2.coordinates, result_2->coordinates);
+
+    std::vector<util::Coordinate> coords_3 = {{util::FloatLongitude{1}, util::FloatLatitude{2}}};
+
+    MatchParameters reference_3{};
+    reference_3.coordinates = coords_3;
+    reference_3.timestamps = {5};
+    reference_3.session = "vehicle_42-a";
+    auto result_3 = parseParameters<MatchParameters>("1,2?timestamps=5&session=vehicle_42-a");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK_EQUAL(reference_3.session, result_3->session);
+    CHECK_EQUAL_RANGE(reference_3.timestamps, result_3->timestamps);
+    CHECK_EQUAL_RANGE(reference_3.coordinates, result_3->coordinates);
+    // a single coordinate is only valid for a session
+    BOOST_CHECK(result_3->IsValid());
+    result_3->session.clear();
+    BOOST_CHECK(!result_3->IsValid());
+
+    auto result_4 = parseParameters<MatchParameters>("1,2?session=new");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(result_4->OpensSession());
+    BOOST_CHECK(!result_3->OpensSession());
 }
 
 BOOST_AUTO_TEST_CASE(valid_nearest_urls)
@@ -0,0 +1,120 @@
+#include "server/request_parser.hpp"
+#include "server/http/request.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <tuple>
+
+BOOST_AUTO_TEST_SUITE(request_parser)
+
+using namespace osrm;
+using namespace osrm::server;
+
+namespace
+{
+std::tuple<RequestParser::RequestStatus, http::request, std::size_t> parse(std::string input)
+{
+    RequestParser parser;
+    http::request request;
+    RequestParser::RequestStatus status;
+    http::compression_type compression;
+    char *next;
+    std::tie(status, compression, next) =
+        parser.parse(request, &input[0], &input[0] + input.size());
+    return std::make_tuple(status, request, static_cast<std::size_t>(next - &input[0]));
+}
+}
+
+BOOST_AUTO_TEST_CASE(keep_alive_test)
+{
+    const auto http_11 = parse("GET /route/v1/driving/1,2;3,4 HTTP/1.1\r\nHost: osrm\r\n\r\n");
+    BOOST_CHECK(std::get<0>(http_11) == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(std::get<1>(http_11).uri, "/route/v1/driving/1,2;3,4");
+    BOOST_CHECK(std::get<1>(http_11).keep_alive);
+
+    const auto http_11_close = parse("GET /nearest HTTP/1.1\r\nConnection: close\r\n\r\n");
+    BOOST_CHECK(std::get<0>(http_11_close) == RequestParser::RequestStatus::valid);
+    BOOST_CHECK(!std::get<1>(http_11_close).keep_alive);
+
+    const auto http_10 = parse("GET /nearest HTTP/1.0\r\n\r\n");
+    BOOST_CHECK(std::get<0>(http_10) == RequestParser::RequestStatus::valid);
+    BOOST_CHECK(!std::get<1>(http_10).keep_alive);
+
+    const auto http_10_keep_alive =
+        parse("GET /nearest HTTP/1.0\r\nconnection: Keep-Alive\r\nUser-Agent: test\r\n\r\n");
+    BOOST_CHECK(std::get<0>(http_10_keep_alive) == RequestParser::RequestStatus::valid);
+    BOOST_CHECK(std::get<1>(http_10_keep_alive).keep_alive);
+    BOOST_CHECK_EQUAL(std::get<1>(http_10_keep_alive).agent, "test");
+}
+
+BOOST_AUTO_TEST_CASE(pipelined_requests_test)
+{
+    const std::string first = "GET /first HTTP/1.1\r\n\r\n";
+    const std::string second = "GET /second HTTP/1.1\r\n\r\n";
+    std::string input = first + second;
+
+    RequestParser parser;
+    http::request request;
+    RequestParser::RequestStatus status;
+    http::compression_type compression;
+    char *next;
+    std::tie(status, compression, next) =
+        parser.parse(request, &input[0], &input[0] + input.size());
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(request.uri, "/first");
+    BOOST_CHECK_EQUAL(next - &input[0], first.size());
+
+    parser = RequestParser();
+    request = http::request();
+    std::tie(status, compression, next) = parser.parse(request, next, &input[0] + input.size());
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(request.uri, "/second");
+    BOOST_CHECK(next == &input[0] + input.size());
+}
+
+BOOST_AUTO_TEST_CASE(incomplete_request_test)
+{
+    const auto partial = parse("GET /nearest HTTP/1.1\r\nHost: os");
+    BOOST_CHECK(std::get<0>(partial) == RequestParser::RequestStatus::indeterminate);
+
+    const auto invalid = parse("GET /nearest FTP/1.1\r\n\r\n");
+    BOOST_CHECK(std::get<0>(invalid) == RequestParser::RequestStatus::invalid);
+}
+
+BOOST_AUTO_TEST_CASE(request_body_test)
+{
+    const std::string body = "1,2;3,4\n5,6;7,8?radiuses=5;5\n";
+    const std::string request = "POST /match/v1/driving/batch HTTP/1.1\r\nContent-Length: " +
+                                std::to_string(body.size()) + "\r\n\r\n";
+    const std::string next_request = "GET /nearest HTTP/1.1\r\n\r\n";
+
+    const auto with_body = parse(request + body + next_request);
+    BOOST_CHECK(std::get<0>(with_body) == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(std::get<1>(with_body).method, "POST");
+    BOOST_CHECK_EQUAL(std::get<1>(with_body).uri, "/match/v1/driving/batch");
+    BOOST_CHECK_EQUAL(std::get<1>(with_body).body, body);
+    // the body is consumed, the pipelined request follows it
+    BOOST_CHECK_EQUAL(std::get<2>(with_body), request.size() + body.size());
+
+    const auto partial_body = parse(request + body.substr(0, 4));
+    BOOST_CHECK(std::get<0>(partial_body) == RequestParser::RequestStatus::indeterminate);
+
+    // nothing is allocated for a body that did not arrive yet
+    const auto no_body = parse("POST /match HTTP/1.1\r\nContent-Length: 60000000\r\n\r\n");
+    BOOST_CHECK(std::get<0>(no_body) == RequestParser::RequestStatus::indeterminate);
+    BOOST_CHECK_LT(std::get<1>(no_body).body.capacity(), 1024);
+
+    const auto get_with_body = parse("GET /match HTTP/1.1\r\nContent-Length: 4\r\n\r\n1,2;");
+    BOOST_CHECK(std::get<0>(get_with_body) == RequestParser::RequestStatus::invalid);
+    BOOST_CHECK_EQUAL(std::get<1>(get_with_body).method, "GET");
+
+    const auto invalid_length = parse("POST /match HTTP/1.1\r\nContent-Length: -1\r\n\r\n");
+    BOOST_CHECK(std::get<0>(invalid_length) == RequestParser::RequestStatus::invalid);
+
+    const auto too_large = parse("POST /match HTTP/1.1\r\nContent-Length: 999999999\r\n\r\n");
+    BOOST_CHECK(std::get<0>(too_large) == RequestParser::RequestStatus::invalid);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -24,9 +24,13 @@ typedef NodeID TestNodeID;
 typedef int TestKey;
 typedef int TestWeight;
 typedef boost::mpl::list<ArrayStorage<TestNodeID, TestKey>,
+                         TimestampedArrayStorage<TestNodeID, TestKey>,
                          MapStorage<TestNodeID, TestKey>,
                          UnorderedMapStorage<TestNodeID, TestKey>>
     storage_types;
+typedef boost::mpl::list<TimestampedArrayStorage<TestNodeID, TestKey>,
+                         UnorderedMapStorage<TestNodeID, TestKey>>
+    clearable_storage_types;
 
 template <unsigned NUM_ELEM> struct RandomDataFixture
 {
@@ -157,4 +161,85 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(decrease_key_test, T, storage_types, RandomData
     }
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(clear_test, T, clearable_storage_types, RandomDataFixture<10>)
+{
+    BinaryHeap<TestNodeID, TestKey, TestWeight, TestData, T> heap(10);
+
+    for (unsigned round = 0; round < 3; ++round)
+    {
+        for (unsigned idx : order)
+        {
+            if (idx % 2 == round % 2)
+            {
+                BOOST_CHECK(!heap.WasInserted(ids[idx]));
+                heap.Insert(ids[idx], weights[idx], data[idx]);
+                BOOST_CHECK(heap.WasInserted(ids[idx]));
+            }
+        }
+
+        for (auto id : ids)
+        {
+            BOOST_CHECK_EQUAL(heap.WasInserted(id), id % 2 == round % 2);
+        }
+
+        heap.Clear();
+        BOOST_CHECK(heap.Empty());
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(four_ary_delete_min_test,
+                                 T,
+                                 storage_types,
+                                 RandomDataFixture<NUM_NODES>)
+{
+    DAryHeap<TestNodeID, TestKey, TestWeight, TestData, T, 4> heap(NUM_NODES);
+
+    for (unsigned idx : order)
+    {
+        heap.Insert(ids[idx], weights[idx], data[idx]);
+    }
+
+    for (auto id : ids)
+    {
+        BOOST_CHECK(!heap.WasRemoved(id));
+
+        BOOST_CHECK_EQUAL(heap.Min(), id);
+        BOOST_CHECK_EQUAL(heap.GetData(id).value, data[id].value);
+        BOOST_CHECK_EQUAL(id, heap.DeleteMin());
+        if (id + 1 < NUM_NODES)
+            BOOST_CHECK_EQUAL(heap.Min(), id + 1);
+
+        BOOST_CHECK(heap.WasRemoved(id));
+    }
+    BOOST_CHECK(heap.Empty());
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(four_ary_decrease_key_test,
+                                 T,
+                                 storage_types,
+                                 RandomDataFixture<NUM_NODES>)
+{
+    DAryHeap<TestNodeID, TestKey, TestWeight, TestData, T, 4> heap(NUM_NODES);
+
+    for (unsigned idx : order)
+    {
+        heap.Insert(ids[idx], weights[idx], data[idx]);
+    }
+
+    // move every node in front of all others, in reverse order of their ids
+    TestWeight min_weight = heap.MinKey();
+    for (auto id = NUM_NODES; id-- > 0;)
+    {
+        min_weight -= 1;
+        heap.DecreaseKey(id, min_weight);
+        BOOST_CHECK_EQUAL(heap.Min(), id);
+        BOOST_CHECK_EQUAL(heap.MinKey(), min_weight);
+    }
+
+    for (auto id : ids)
+    {
+        BOOST_CHECK_EQUAL(heap.DeleteMin(), id);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
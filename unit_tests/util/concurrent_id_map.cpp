@@ -0,0 +1,67 @@
+#include "util/concurrent_id_map.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(concurrent_id_map)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(consecutive_ids)
+{
+    ConcurrentIdMap<std::string, std::uint32_t> map;
+
+    BOOST_CHECK_EQUAL(map.ConcurrentFindOrAdd("a"), 0);
+    BOOST_CHECK_EQUAL(map.ConcurrentFindOrAdd("b"), 1);
+    BOOST_CHECK_EQUAL(map.ConcurrentFindOrAdd("a"), 0);
+    BOOST_CHECK_EQUAL(map.ConcurrentFindOrAdd("c"), 2);
+    BOOST_CHECK_EQUAL(map.data.size(), 3);
+
+    auto moved = std::move(map);
+    BOOST_CHECK_EQUAL(moved.ConcurrentFindOrAdd("b"), 1);
+    BOOST_CHECK_EQUAL(moved.data.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_inserts)
+{
+    ConcurrentIdMap<std::uint32_t, std::uint32_t> map;
+
+    const std::uint32_t num_keys = 1000;
+    std::vector<std::vector<std::uint32_t>> ids(4, std::vector<std::uint32_t>(num_keys));
+    std::vector<std::thread> threads;
+    for (auto &thread_ids : ids)
+    {
+        threads.emplace_back([&map, &thread_ids, num_keys] {
+            for (std::uint32_t key = 0; key < num_keys; ++key)
+            {
+                thread_ids[key] = map.ConcurrentFindOrAdd(key);
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    // every key got exactly one id, all threads saw the same one
+    BOOST_REQUIRE_EQUAL(map.data.size(), num_keys);
+    std::vector<bool> used(num_keys, false);
+    for (std::uint32_t key = 0; key < num_keys; ++key)
+    {
+        const auto id = map.data[key];
+        BOOST_REQUIRE_LT(id, num_keys);
+        BOOST_CHECK(!used[id]);
+        used[id] = true;
+        for (const auto &thread_ids : ids)
+        {
+            BOOST_CHECK_EQUAL(thread_ids[key], id);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
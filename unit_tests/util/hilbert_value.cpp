@@ -0,0 +1,60 @@
+#include "util/hilbert_value.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(hilbert_value)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(hilbert_order_is_permutation)
+{
+    const std::vector<Coordinate> coordinates = {
+        {FloatLongitude{13.40}, FloatLatitude{52.52}},
+        {FloatLongitude{-74.00}, FloatLatitude{40.71}},
+        {FloatLongitude{13.41}, FloatLatitude{52.51}},
+        {FloatLongitude{151.21}, FloatLatitude{-33.87}},
+        {FloatLongitude{-74.01}, FloatLatitude{40.72}},
+    };
+
+    auto order = hilbertOrder(coordinates);
+    BOOST_REQUIRE_EQUAL(order.size(), coordinates.size());
+
+    std::sort(order.begin(), order.end());
+    for (std::size_t index = 0; index < order.size(); ++index)
+    {
+        BOOST_CHECK_EQUAL(order[index], index);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hilbert_order_groups_nearby_coordinates)
+{
+    const std::vector<Coordinate> coordinates = {
+        {FloatLongitude{13.40}, FloatLatitude{52.52}},
+        {FloatLongitude{-74.00}, FloatLatitude{40.71}},
+        {FloatLongitude{13.41}, FloatLatitude{52.51}},
+        {FloatLongitude{151.21}, FloatLatitude{-33.87}},
+        {FloatLongitude{-74.01}, FloatLatitude{40.72}},
+    };
+
+    const auto order = hilbertOrder(coordinates);
+    const auto position = [&order](const std::size_t index) {
+        return std::distance(order.begin(), std::find(order.begin(), order.end(), index));
+    };
+
+    // coordinates in the same city are next to each other
+    BOOST_CHECK_EQUAL(std::abs(position(0) - position(2)), 1);
+    BOOST_CHECK_EQUAL(std::abs(position(1) - position(4)), 1);
+}
+
+BOOST_AUTO_TEST_CASE(hilbert_order_empty)
+{
+    BOOST_CHECK(hilbertOrder({}).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
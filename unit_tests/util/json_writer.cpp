@@ -0,0 +1,96 @@
+#include "util/cast.hpp"
+#include "util/json_renderer.hpp"
+#include "util/json_writer.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(json_writer)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(number_formatting)
+{
+    const auto format = [](const double value) {
+        std::vector<char> out;
+        json::appendNumber(out, value);
+        return std::string(out.begin(), out.end());
+    };
+
+    BOOST_CHECK_EQUAL(format(0), "0");
+    BOOST_CHECK_EQUAL(format(10), "10");
+    BOOST_CHECK_EQUAL(format(-10), "-10");
+    BOOST_CHECK_EQUAL(format(0.5), "0.5");
+    BOOST_CHECK_EQUAL(format(-0.25), "-0.25");
+    BOOST_CHECK_EQUAL(format(13.388799), "13.388799");
+    BOOST_CHECK_EQUAL(format(52.5170365), "52.517037");
+    BOOST_CHECK_EQUAL(format(1e-7), "0");
+    // negative values keep their sign even if they round to zero, as in the tree renderers
+    BOOST_CHECK_EQUAL(format(-0.), "-0");
+    BOOST_CHECK_EQUAL(format(-1e-7), "-0");
+    BOOST_CHECK_EQUAL(format(-0.), cast::to_string_with_precision(-0.));
+    BOOST_CHECK_EQUAL(format(-1e-7), cast::to_string_with_precision(-1e-7));
+
+    json::Object object;
+    object.values["zero"] = json::Number{-0.};
+    std::ostringstream rendered;
+    json::render(rendered, object);
+    std::vector<char> streamed;
+    json::Writer writer(streamed);
+    writer.StartObject();
+    writer.Key("zero");
+    writer.Number(-0.);
+    writer.EndObject();
+    BOOST_CHECK_EQUAL(std::string(streamed.begin(), streamed.end()), rendered.str());
+    BOOST_CHECK_EQUAL(format(1e12), cast::to_string_with_precision(1e12));
+
+    // Choosen by a fair W20 dice roll (this value is completely arbitrary)
+    std::mt19937 generator(13);
+    std::uniform_real_distribution<double> distribution(-100000., 100000.);
+    for (int i = 0; i < 10000; ++i)
+    {
+        // rounded to a tenth as durations and distances are
+        const double value = std::round(distribution(generator) * 10) / 10.;
+        BOOST_CHECK_EQUAL(format(value), cast::to_string_with_precision(value));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(writer_structure)
+{
+    std::vector<char> out;
+    json::Writer writer(out);
+
+    json::Object waypoint;
+    waypoint.values["name"] = "Unter den Linden";
+
+    writer.StartObject();
+    writer.Key("code");
+    writer.String("Ok");
+    writer.Key("table");
+    writer.StartArray();
+    writer.StartArray();
+    writer.Number(1.5);
+    writer.Null();
+    writer.EndArray();
+    writer.StartArray();
+    writer.EndArray();
+    writer.EndArray();
+    writer.Key("waypoint");
+    writer.Value(waypoint);
+    writer.Key("escaped");
+    writer.String("\"");
+    writer.EndObject();
+
+    BOOST_CHECK_EQUAL(std::string(out.begin(), out.end()),
+                      "{\"code\":\"Ok\",\"table\":[[1.5,null],[]],\"waypoint\":{\"name\":\"Unter "
+                      "den Linden\"},\"escaped\":\"\\\"\"}");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
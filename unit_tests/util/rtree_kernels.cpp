@@ -0,0 +1,141 @@
+#include "util/rtree_kernels.hpp"
+#include "util/coordinate_calculation.hpp"
+#include "util/rectangle.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(rtree_kernels)
+
+using namespace osrm;
+using namespace osrm::util;
+using namespace osrm::util::rtree_kernels;
+
+namespace
+{
+
+// Choosen by a fair W20 dice roll (this value is completely arbitrary)
+constexpr unsigned RANDOM_SEED = 13;
+// not a multiple of any vector width to test the remainder loops
+constexpr std::size_t COUNT = 127;
+
+const std::vector<SIMDLevel> ALL_LEVELS = {SIMDLevel::Scalar, SIMDLevel::SSE, SIMDLevel::AVX2};
+
+// restores the detected level when going out of scope
+struct ScopedSIMDLevel
+{
+    ScopedSIMDLevel(const SIMDLevel level) : used_level(setSIMDLevel(level)) {}
+    ~ScopedSIMDLevel() { setSIMDLevel(detectSIMDLevel()); }
+    SIMDLevel used_level;
+};
+}
+
+BOOST_AUTO_TEST_CASE(min_squared_distances_match_rectangle)
+{
+    std::mt19937 generator(RANDOM_SEED);
+    std::uniform_int_distribution<std::int32_t> lon_distribution(-180 * COORDINATE_PRECISION,
+                                                                 180 * COORDINATE_PRECISION);
+    std::uniform_int_distribution<std::int32_t> lat_distribution(-170 * COORDINATE_PRECISION,
+                                                                 170 * COORDINATE_PRECISION);
+    std::uniform_int_distribution<std::int32_t> size_distribution(0, 10 * COORDINATE_PRECISION);
+
+    std::vector<RectangleInt2D> rectangles;
+    std::vector<std::int32_t> min_lon, max_lon, min_lat, max_lat;
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        const auto lon = lon_distribution(generator);
+        const auto lat = lat_distribution(generator);
+        rectangles.emplace_back(FixedLongitude{lon},
+                                FixedLongitude{lon + size_distribution(generator)},
+                                FixedLatitude{lat},
+                                FixedLatitude{lat + size_distribution(generator)});
+        min_lon.push_back(static_cast<std::int32_t>(rectangles.back().min_lon));
+        max_lon.push_back(static_cast<std::int32_t>(rectangles.back().max_lon));
+        min_lat.push_back(static_cast<std::int32_t>(rectangles.back().min_lat));
+        max_lat.push_back(static_cast<std::int32_t>(rectangles.back().max_lat));
+    }
+    // a query inside a rectangle
+    const Coordinate inside = rectangles.front().Centroid();
+
+    for (const auto level : ALL_LEVELS)
+    {
+        ScopedSIMDLevel scoped_level(level);
+        BOOST_TEST_MESSAGE("level " << toString(scoped_level.used_level));
+
+        for (const auto query : {inside,
+                                 Coordinate{FixedLongitude{lon_distribution(generator)},
+                                            FixedLatitude{lat_distribution(generator)}}})
+        {
+            std::vector<std::uint64_t> squared_distances(COUNT);
+            minSquaredDistances(min_lon.data(),
+                                max_lon.data(),
+                                min_lat.data(),
+                                max_lat.data(),
+                                COUNT,
+                                static_cast<std::int32_t>(query.lon),
+                                static_cast<std::int32_t>(query.lat),
+                                squared_distances.data());
+            for (std::size_t i = 0; i < COUNT; ++i)
+            {
+                BOOST_CHECK_EQUAL(squared_distances[i], rectangles[i].GetMinSquaredDist(query));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(project_on_segments_match_scalar_projection)
+{
+    std::mt19937 generator(RANDOM_SEED);
+    std::uniform_real_distribution<double> lon_distribution(-180., 180.);
+    std::uniform_real_distribution<double> lat_distribution(-170., 170.);
+    std::uniform_real_distribution<double> offset_distribution(-0.01, 0.01);
+
+    std::vector<double> source_lon, source_lat, target_lon, target_lat;
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        source_lon.push_back(lon_distribution(generator));
+        source_lat.push_back(lat_distribution(generator));
+        target_lon.push_back(source_lon.back() + offset_distribution(generator));
+        target_lat.push_back(source_lat.back() + offset_distribution(generator));
+    }
+    // a degenerated segment
+    target_lon[5] = source_lon[5];
+    target_lat[5] = source_lat[5];
+
+    const double lon = lon_distribution(generator);
+    const double lat = lat_distribution(generator);
+
+    for (const auto level : ALL_LEVELS)
+    {
+        ScopedSIMDLevel scoped_level(level);
+        BOOST_TEST_MESSAGE("level " << toString(scoped_level.used_level));
+
+        std::vector<double> nearest_lon(COUNT), nearest_lat(COUNT);
+        projectOnSegments(source_lon.data(),
+                          source_lat.data(),
+                          target_lon.data(),
+                          target_lat.data(),
+                          COUNT,
+                          lon,
+                          lat,
+                          nearest_lon.data(),
+                          nearest_lat.data());
+
+        for (std::size_t i = 0; i < COUNT; ++i)
+        {
+            FloatCoordinate expected;
+            std::tie(std::ignore, expected) = coordinate_calculation::projectPointOnSegment(
+                {FloatLongitude{source_lon[i]}, FloatLatitude{source_lat[i]}},
+                {FloatLongitude{target_lon[i]}, FloatLatitude{target_lat[i]}},
+                {FloatLongitude{lon}, FloatLatitude{lat}});
+            BOOST_CHECK_EQUAL(nearest_lon[i], static_cast<double>(expected.lon));
+            BOOST_CHECK_EQUAL(nearest_lat[i], static_cast<double>(expected.lat));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
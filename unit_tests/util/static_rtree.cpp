@@ -9,6 +9,7 @@
 
 #include "mocks/mock_datafacade.hpp"
 
+#include <boost/align/aligned_allocator.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/test/auto_unit_test.hpp>
 #include <boost/test/test_case_template.hpp>
@@ -302,6 +303,41 @@ BOOST_FIXTURE_TEST_CASE(construct_multiple_levels_test, TestRandomGraphFixture_M
     construction_test("test_5", this);
 }
 
+// Leaves loaded into memory, as osrm-datastore --load-rtree-leaves does, instead of mapped
+BOOST_FIXTURE_TEST_CASE(leaves_in_memory_test, TestRandomGraphFixture_MultipleLevels)
+{
+    using SharedTestStaticRTree = StaticRTree<TestData,
+                                              std::vector<Coordinate>,
+                                              true,
+                                              TEST_BRANCHING_FACTOR,
+                                              TEST_LEAF_NODE_SIZE>;
+    using TreeNode = SharedTestStaticRTree::TreeNode;
+    using LeafNode = SharedTestStaticRTree::LeafNode;
+
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree(std::string("test_leaves_in_memory"), this, leaves_path, nodes_path);
+
+    storage::io::FileReader tree_node_file(nodes_path, storage::io::FileReader::HasNoFingerprint);
+    std::vector<TreeNode> tree_nodes(tree_node_file.ReadElementCount64());
+    tree_node_file.ReadInto(tree_nodes.data(), tree_nodes.size());
+
+    storage::io::FileReader leaf_node_file(leaves_path, storage::io::FileReader::HasNoFingerprint);
+    std::vector<LeafNode, boost::alignment::aligned_allocator<LeafNode, alignof(LeafNode)>>
+        leaf_nodes(leaf_node_file.Size() / sizeof(LeafNode));
+    leaf_node_file.ReadInto(leaf_nodes.data(), leaf_nodes.size());
+    BOOST_REQUIRE_GT(leaf_nodes.size(), 1);
+
+    SharedTestStaticRTree rtree(
+        tree_nodes.data(), tree_nodes.size(), leaf_nodes.data(), leaf_nodes.size(), coords);
+    // nothing is mapped, so there is nothing to prefetch
+    rtree.PrefetchLeaves();
+    LinearSearchNN<TestData> lsnn(coords, edges);
+
+    simple_verify_rtree(rtree, coords, edges);
+    sampling_verify_rtree(rtree, lsnn, coords, 100);
+}
+
 // Bug: If you querry a point that lies between two BBs that have a gap,
 // one BB will be pruned, even if it could contain a nearer match.
 BOOST_AUTO_TEST_CASE(regression_test)